@@ -0,0 +1,82 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <dynd/json_parser.hpp>
+
+using namespace std;
+using namespace dynd;
+
+static std::string make_records(intptr_t count)
+{
+  std::string json = "[";
+  for (intptr_t i = 0; i < count; ++i) {
+    json += (i == 0) ? "\n" : ",\n";
+    json += "  {\"id\": " + to_string(i) + ", \"name\": \"record number " + to_string(i) +
+            "\", \"score\": " + to_string(i * 0.25) + ", \"tags\": [\"a\", \"b\\\"c\"], \"extra\": {\"x\": [1, 2]}}";
+  }
+
+  return json + "\n]";
+}
+
+static void BM_Array_JSON_StructuralIndex(benchmark::State &state)
+{
+  std::string json = make_records(state.range_x());
+  vector<uint32_t> index;
+  while (state.KeepRunning()) {
+    index.clear();
+    json::structural_index(json.data(), json.data() + json.size(), index);
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+
+BENCHMARK(BM_Array_JSON_StructuralIndex)->Range(1 << 10, 1 << 16);
+
+static void BM_Array_JSON_Parse(benchmark::State &state)
+{
+  std::string json = make_records(state.range_x());
+  ndt::type tp("var * {id: int64, name: string, score: float64, tags: var * string}");
+  while (state.KeepRunning()) {
+    parse_json(tp, json, &eval::default_eval_context);
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+
+BENCHMARK(BM_Array_JSON_Parse)->Range(1 << 10, 1 << 16);
+
+static void BM_Array_NDJSON_Parse(benchmark::State &state)
+{
+  std::string json;
+  for (intptr_t i = 0; i < state.range_x(); ++i) {
+    json += "{\"id\": " + to_string(i) + ", \"name\": \"record number " + to_string(i) + "\", \"score\": " +
+            to_string(i * 0.25) + "}\n";
+  }
+  ndt::type tp("{id: int64, name: string, score: float64}");
+  while (state.KeepRunning()) {
+    nd::json::parse_ndjson(tp, json);
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+
+BENCHMARK(BM_Array_NDJSON_Parse)->Range(1 << 10, 1 << 16);
+
+static void BM_Array_JSON_Discover(benchmark::State &state)
+{
+  std::string json = make_records(1 << 14);
+  // Looks at every record when the stride is one, and one in range_x otherwise
+  ndt::json::discover_options opts;
+  opts.stride = state.range_x();
+  while (state.KeepRunning()) {
+    ndt::type tp;
+    ndt::json::discover(tp, json, opts);
+    benchmark::DoNotOptimize(tp);
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+
+BENCHMARK(BM_Array_JSON_Discover)->Arg(1)->Arg(16)->Arg(256);
@@ -13,6 +13,9 @@
 
 #include <dispatcher.hpp>
 
+#include <dynd/arithmetic.hpp>
+#include <dynd/callables/add_callable.hpp>
+#include <dynd/callables/plus_callable.hpp>
 #include <dynd/dispatcher.hpp>
 #include <dynd/type.hpp>
 #include <dynd/type_registry.hpp>
@@ -99,44 +102,88 @@ BENCHMARK_DEFINE_F(BinaryDispatchFixture, BM_Supercedes)(benchmark::State &state
 
 // BENCHMARK_REGISTER_F(BinaryDispatchFixture, BM_Supercedes)->Arg(10)->Arg(100)->Arg(1000);
 
-BENCHMARK_DEFINE_F(UnaryDispatchFixture, BM_UnaryDispatch)(benchmark::State &state) {
-  dispatcher<1, int> dispatcher{{{any_kind_id}, 0}, {{scalar_kind_id}, 1}, {{bool_id}, 2},    {{int8_id}, 3},
-                                {{int16_id}, 4},    {{int32_id}, 5},       {{int64_id}, 6},   {{int128_id}, 7},
-                                {{uint8_id}, 8},    {{uint16_id}, 9},      {{uint32_id}, 10}, {{uint64_id}, 11},
-                                {{uint128_id}, 12}, {{float32_id}, 13},    {{float64_id}, 14}};
+namespace {
+
+typedef type_sequence<int8_t, int16_t, int32_t, int64_t, uint8_t, uint16_t, uint32_t, uint64_t, float, double>
+    dispatch_types;
+
+std::vector<ndt::type> dispatch_arg0(const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc),
+                                     const ndt::type *src_tp) {
+  return {src_tp[0]};
+}
+
+std::vector<ndt::type> dispatch_args(const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc),
+                                     const ndt::type *src_tp) {
+  return {src_tp[0], src_tp[1]};
+}
+
+template <typename Arg0Type>
+using identity_callable = nd::functional::apply_function_callable<decltype(&dynd::detail::inline_plus<Arg0Type>::f),
+                                                                  &dynd::detail::inline_plus<Arg0Type>::f>;
+
+/**
+ * Random builtin scalar types to dispatch on.
+ */
+vector<ndt::type> random_types(size_t size) {
+  const ndt::type tps[] = {ndt::make_type<int8_t>(),   ndt::make_type<int16_t>(),  ndt::make_type<int32_t>(),
+                           ndt::make_type<int64_t>(),  ndt::make_type<uint8_t>(),  ndt::make_type<uint16_t>(),
+                           ndt::make_type<uint32_t>(), ndt::make_type<uint64_t>(), ndt::make_type<float>(),
+                           ndt::make_type<double>()};
+
+  default_random_engine generator;
+  uniform_int_distribution<size_t> d(0, sizeof(tps) / sizeof(tps[0]) - 1);
+
+  vector<ndt::type> res(size);
+  for (auto &tp : res) {
+    tp = tps[d(generator)];
+  }
+
+  return res;
+}
+
+} // unnamed namespace
+
+static void BM_UnaryDispatch(benchmark::State &state) {
+  dispatcher<1, nd::callable> dispatcher = nd::callable::make_all<identity_callable, dispatch_types>(dispatch_arg0);
+  ndt::type dst_tp("Any");
+  vector<ndt::type> tps = random_types(state.range_x());
   while (state.KeepRunning()) {
-    for (const auto &pair : pairs) {
-      benchmark::DoNotOptimize(dispatcher(pair.first));
+    for (const auto &tp : tps) {
+      benchmark::DoNotOptimize(dispatcher(dst_tp, 1, &tp));
     }
   }
   state.SetItemsProcessed(state.iterations() * state.range_x());
 }
 
-BENCHMARK_REGISTER_F(UnaryDispatchFixture, BM_UnaryDispatch)->Arg(100)->Arg(1000)->Arg(10000);
+BENCHMARK(BM_UnaryDispatch)->Arg(100)->Arg(1000)->Arg(10000);
 
-/*
-static void BM_VirtualDispatch(benchmark::State &state)
-{
+static void BM_BinaryDispatch(benchmark::State &state) {
+  dispatcher<2, nd::callable> dispatcher =
+      nd::callable::make_all<nd::add_callable, dispatch_types, dispatch_types>(dispatch_args);
+  ndt::type dst_tp("Any");
+  vector<ndt::type> tps0 = random_types(state.range_x());
+  vector<ndt::type> tps1 = random_types(state.range_x() + 1);
   while (state.KeepRunning()) {
-    benchmark::DoNotOptimize((*item)());
+    for (int i = 0; i < state.range_x(); ++i) {
+      ndt::type src_tp[2] = {tps0[i], tps1[i + 1]};
+      benchmark::DoNotOptimize(dispatcher(dst_tp, 2, src_tp));
+    }
   }
+  state.SetItemsProcessed(state.iterations() * state.range_x());
 }
 
-BENCHMARK(BM_VirtualDispatch);
-*/
+BENCHMARK(BM_BinaryDispatch)->Arg(100)->Arg(1000)->Arg(10000);
 
-BENCHMARK_DEFINE_F(UnaryDispatchFixture, BM_BinaryDispatch)(benchmark::State &state) {
-  dispatcher<2, int> dispatcher{{{any_kind_id, int64_id}, 0},
-                                {{scalar_kind_id, int64_id}, 1},
-                                {{int32_id, int64_id}, 2},
-                                {{float32_id, int64_id}, 3},
-                                {{any_kind_id, any_kind_id}, 4}};
+/**
+ * Scalar nd::add, where the time goes to dispatching rather than the
+ * arithmetic.
+ */
+static void BM_ScalarAdd(benchmark::State &state) {
+  nd::array a = 5;
+  nd::array b = 6.5;
   while (state.KeepRunning()) {
-    for (const auto &pair : pairs) {
-      benchmark::DoNotOptimize(dispatcher(pair.first, pair.second));
-    }
+    benchmark::DoNotOptimize(nd::add(a, b));
   }
-  state.SetItemsProcessed(state.iterations() * state.range_x());
 }
 
-BENCHMARK_REGISTER_F(UnaryDispatchFixture, BM_BinaryDispatch)->Arg(100)->Arg(1000)->Arg(10000);
+BENCHMARK(BM_ScalarAdd);
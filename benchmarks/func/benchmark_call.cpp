@@ -0,0 +1,77 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <atomic>
+#include <cstdlib>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <dynd/arithmetic.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+atomic<size_t> malloc_count(0);
+
+} // anonymous namespace
+
+#ifdef __GLIBC__
+
+// Count every allocation the process makes, including those of operator new
+// and of libdynd itself, by interposing malloc
+extern "C" void *__libc_malloc(size_t size);
+
+extern "C" void *malloc(size_t size) {
+  ++malloc_count;
+  return __libc_malloc(size);
+}
+
+#endif
+
+/**
+ * Labels the benchmark with the number of mallocs per iteration since
+ * ``start``.
+ */
+static void set_malloc_label(benchmark::State &state, size_t start) {
+  size_t count = malloc_count.load() - start;
+  state.SetLabel(to_string(static_cast<double>(count) / state.iterations()) + " mallocs/call");
+}
+
+// The only allocation is the result array
+static void BM_Call_ScalarAdd(benchmark::State &state) {
+  nd::array a = 5;
+  nd::array b = 6.5;
+
+  // Resolve once, so that only the steady state is measured
+  nd::add(a, b);
+
+  size_t start = malloc_count.load();
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(nd::add(a, b));
+  }
+  set_malloc_label(state, start);
+}
+
+BENCHMARK(BM_Call_ScalarAdd);
+
+// Writing into an existing array does not allocate at all
+static void BM_Call_ScalarAddWithDst(benchmark::State &state) {
+  nd::array a = 5;
+  nd::array b = 6.5;
+  nd::array c = nd::empty(ndt::make_type<double>());
+
+  nd::add({a, b}, {{"dst", c}});
+
+  size_t start = malloc_count.load();
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(nd::add({a, b}, {{"dst", c}}));
+  }
+  set_malloc_label(state, start);
+}
+
+BENCHMARK(BM_Call_ScalarAddWithDst);
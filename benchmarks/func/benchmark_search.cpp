@@ -0,0 +1,63 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include <dynd/search.hpp>
+
+using namespace std;
+using namespace dynd;
+
+static nd::array make_sorted(intptr_t size)
+{
+  nd::array a = nd::empty(size, ndt::make_type<int64_t>());
+  int64_t *data = reinterpret_cast<int64_t *>(a.data());
+  for (intptr_t i = 0; i < size; ++i) {
+    data[i] = 3 * i;
+  }
+
+  return a;
+}
+
+static nd::array make_needles(intptr_t size, intptr_t count)
+{
+  nd::array needles = nd::empty(count, ndt::make_type<int64_t>());
+  int64_t *data = reinterpret_cast<int64_t *>(needles.data());
+  mt19937_64 gen(0);
+  uniform_int_distribution<int64_t> dist(0, 3 * size);
+  for (intptr_t i = 0; i < count; ++i) {
+    data[i] = dist(gen);
+  }
+
+  return needles;
+}
+
+static void BM_Func_SearchSorted(benchmark::State &state)
+{
+  intptr_t size = state.range_x();
+  nd::array a = make_sorted(size);
+  nd::array needles = make_needles(size, 100000);
+  while (state.KeepRunning()) {
+    nd::searchsorted(a, needles);
+  }
+  state.SetItemsProcessed(state.iterations() * 100000);
+}
+
+BENCHMARK(BM_Func_SearchSorted)->Range(1 << 10, 1 << 24);
+
+static void BM_Func_SearchSorted_Eytzinger(benchmark::State &state)
+{
+  intptr_t size = state.range_x();
+  nd::array e = nd::eytzinger(make_sorted(size));
+  nd::array needles = make_needles(size, 100000);
+  while (state.KeepRunning()) {
+    nd::searchsorted({e, needles}, {{"layout", "eytzinger"}});
+  }
+  state.SetItemsProcessed(state.iterations() * 100000);
+}
+
+BENCHMARK(BM_Func_SearchSorted_Eytzinger)->Range(1 << 10, 1 << 24);
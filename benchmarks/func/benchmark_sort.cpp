@@ -0,0 +1,39 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <dynd/sort.hpp>
+
+using namespace std;
+using namespace dynd;
+
+template <typename T>
+static void BM_Func_Sort(benchmark::State &state)
+{
+  intptr_t size = state.range_x();
+  vector<T> values(size);
+  mt19937_64 gen(0);
+  for (T &value : values) {
+    value = static_cast<T>(gen());
+  }
+
+  nd::array a = nd::empty(ndt::make_fixed_dim(size, ndt::make_type<T>()));
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    memcpy(a.data(), values.data(), size * sizeof(T));
+    state.ResumeTiming();
+    nd::sort(a);
+  }
+  state.SetItemsProcessed(state.iterations() * size);
+}
+
+BENCHMARK_TEMPLATE(BM_Func_Sort, int32_t)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Func_Sort, int64_t)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Func_Sort, double)->Range(1 << 8, 1 << 20);
@@ -0,0 +1,38 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include <dynd/index.hpp>
+
+using namespace std;
+using namespace dynd;
+
+static void BM_Func_Take_Random(benchmark::State &state)
+{
+  intptr_t size = state.range_x();
+  nd::array a = nd::empty(size, ndt::make_type<double>());
+  double *data = reinterpret_cast<double *>(a.data());
+  for (intptr_t i = 0; i < size; ++i) {
+    data[i] = static_cast<double>(i);
+  }
+
+  nd::array index = nd::empty(size, ndt::make_type<intptr_t>());
+  intptr_t *index_data = reinterpret_cast<intptr_t *>(index.data());
+  mt19937_64 gen(0);
+  uniform_int_distribution<intptr_t> dist(0, size - 1);
+  for (intptr_t i = 0; i < size; ++i) {
+    index_data[i] = dist(gen);
+  }
+
+  while (state.KeepRunning()) {
+    nd::take(a, index);
+  }
+  state.SetItemsProcessed(state.iterations() * size);
+}
+
+BENCHMARK(BM_Func_Take_Random)->Range(1 << 10, 1 << 24);
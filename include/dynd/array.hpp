@@ -13,6 +13,7 @@
 #include <dynd/config.hpp>
 #include <dynd/init.hpp>
 #include <dynd/irange.hpp>
+#include <dynd/memblock/memmap_flags.hpp>
 #include <dynd/types/bytes_type.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
 #include <dynd/types/pointer_type.hpp>
@@ -851,17 +852,51 @@ namespace nd {
   }
 
   /**
-   * Memory-maps a file with dynd type 'bytes'.
+   * Memory-maps a range of a file as a ``N * uint8`` array of its bytes.
    *
    * \param filename  The name of the file to memory map.
    * \param begin  If provided, the start of where to memory map. Uses
    *               Python semantics for out of bounds and negative values.
    * \param end  If provided, the end of where to memory map. Uses
    *             Python semantics for out of bounds and negative values.
-   * \param access  The access permissions with which to open the file.
+   * \param access  The access permissions with which to open the file,
+   *                read-only by default.
    */
   DYND_API array memmap(const std::string &filename, intptr_t begin = 0,
-                        intptr_t end = std::numeric_limits<intptr_t>::max(), uint32_t access = default_access_flags);
+                        intptr_t end = std::numeric_limits<intptr_t>::max(), uint32_t access = read_access_flag);
+
+  /**
+   * Memory-maps a file as an array of the type ``tp``, whose data is the
+   * bytes of the file from ``offset`` on, in place. The type has to hold all
+   * of its data in place, so it can not have a var dimension, a string or a
+   * pointer, and ``offset`` has to be a multiple of its alignment. A leading
+   * ``Fixed`` dimension takes its size from what is left of the file.
+   *
+   * With ``write_access_flag``, the mapping is shared, so assigning to the
+   * array writes to the file, and other processes mapping the file see the
+   * writes. ``memmap_flush`` waits for them to reach the disk.
+   *
+   * \param filename  The name of the file to memory map.
+   * \param tp  The type of the array.
+   * \param offset  Where the data of the array starts in the file.
+   * \param access  The access permissions with which to open the file.
+   * \param flags  A combination of the ``memmap_flags``.
+   */
+  DYND_API array memmap(const std::string &filename, const ndt::type &tp, intptr_t offset = 0,
+                        uint32_t access = read_access_flag, uint32_t flags = 0);
+
+  /**
+   * Writes the changes made to an array returned by ``nd::memmap``, or to a
+   * view of one, back to its file. When ``wait`` is false, the writes are
+   * only scheduled.
+   */
+  DYND_API void memmap_flush(const array &a, bool wait = true);
+
+  /**
+   * Tells the system how the data of an array returned by ``nd::memmap``, or
+   * of a view of one, is going to be used.
+   */
+  DYND_API void memmap_advise(const array &a, memmap_advice advice);
 
   /**
    * Creates a ctuple nd::array with the given field names and
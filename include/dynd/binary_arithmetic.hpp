@@ -36,7 +36,9 @@ nd::callable make_binary_arithmetic() {
                      nd::get_elwise(ndt::type("(Scalar, Dim) -> Any")), nd::get_elwise(ndt::type("(Dim, Dim) -> Any")),
                      nd::get_elwise(ndt::type("(Scalar, Scalar) -> Any"))});
 
-  return nd::make_callable<nd::multidispatch_callable<2>>(tp, dispatcher);
+  nd::callable f = nd::make_callable<nd::multidispatch_callable<2>>(tp, dispatcher);
+  f->set_thread_safe(true);
+  return f;
 }
 
 } // anonymous namespace
@@ -47,6 +47,8 @@ namespace nd {
 
   } // namespace dynd::nd::detail
 
+  class prepared_callable;
+
   /**
    * Holds a single instance of a callable in an nd::array,
    * providing some more direct convenient interface.
@@ -114,6 +116,19 @@ namespace nd {
 
     array call(size_t narg, const array *args, size_t nkwd, const std::pair<const char *, array> *unordered_kwds) const;
 
+    /**
+     * Resolves and instantiates this callable for the given arguments once,
+     * returning an object which reruns the resulting kernel directly.
+     */
+    prepared_callable prepare(size_t narg, const array *args, size_t nkwd,
+                              const std::pair<const char *, array> *unordered_kwds) const;
+
+    template <typename... ArgTypes>
+    prepared_callable prepare(ArgTypes &&... args) const;
+
+    prepared_callable prepare(const std::initializer_list<array> &args,
+                              const std::initializer_list<std::pair<const char *, array>> &kwds) const;
+
     template <typename... ArgTypes>
     array operator()(ArgTypes &&... args) const {
       array tmp[sizeof...(ArgTypes)] = {std::forward<ArgTypes>(args)...};
@@ -173,6 +188,53 @@ namespace nd {
     }
   };
 
+  /**
+   * A callable bound to a particular set of arguments, with its call graph
+   * resolved and its kernel instantiated against their arrmeta. Invoking it
+   * is a single call through the kernel's function pointer, so it is meant
+   * for evaluating the same operation repeatedly as the argument data changes.
+   */
+  class DYND_API prepared_callable {
+    callable m_callable;
+    std::shared_ptr<detail::resolved_call> m_resolved;
+    array m_dst;
+    std::vector<array> m_args;
+    std::unique_ptr<kernel_builder> m_kb;
+    kernel_call_t m_fn;
+
+  public:
+    prepared_callable(const callable &f, const std::shared_ptr<detail::resolved_call> &resolved, const array &dst,
+                      size_t narg, const array *args);
+
+    const callable &get_callable() const { return m_callable; }
+
+    const array &get_dst() const { return m_dst; }
+
+    size_t get_narg() const { return m_args.size(); }
+
+    const array &get_arg(size_t i) const { return m_args[i]; }
+
+    /**
+     * Evaluates the kernel on the arguments it was prepared with, writing
+     * into and returning the destination it was prepared with.
+     */
+    const array &operator()() {
+      m_fn(m_kb->get(), &m_dst, m_args.data());
+      return m_dst;
+    }
+
+    /**
+     * Evaluates the kernel on different arrays. These must have the same
+     * types and arrmeta as the ones the callable was prepared with.
+     */
+    void operator()(array &dst, const array *args) { m_fn(m_kb->get(), &dst, args); }
+  };
+
+  template <typename... ArgTypes>
+  prepared_callable callable::prepare(ArgTypes &&... args) const {
+    return prepare({array(std::forward<ArgTypes>(args))...}, {});
+  }
+
   template <typename CallableType, typename... ArgTypes>
   std::enable_if_t<std::is_base_of<base_callable, CallableType>::value, callable> make_callable(ArgTypes &&... args) {
     return callable(new CallableType(std::forward<ArgTypes>(args)...), true);
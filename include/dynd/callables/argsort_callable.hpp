@@ -0,0 +1,114 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/callables/base_callable.hpp>
+#include <dynd/comparison.hpp>
+#include <dynd/kernels/argsort_kernel.hpp>
+#include <dynd/types/fixed_string_type.hpp>
+
+namespace dynd {
+namespace nd {
+
+  class argsort_callable : public base_callable {
+  public:
+    argsort_callable() : base_callable(ndt::type("(Fixed * Scalar) -> Fixed * intptr")) {}
+
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+                      size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
+                      const std::map<std::string, ndt::type> &tp_vars) {
+      ndt::type dst_tp = ndt::make_fixed_dim(src_tp[0].get_dim_size(NULL, NULL), ndt::make_type<intptr_t>());
+
+      const ndt::type &src0_element_tp = src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type();
+      switch (src0_element_tp.get_id()) {
+      case int8_id:
+        return resolve_typed<int8_t>(cg, dst_tp);
+      case int16_id:
+        return resolve_typed<int16_t>(cg, dst_tp);
+      case int32_id:
+        return resolve_typed<int32_t>(cg, dst_tp);
+      case int64_id:
+        return resolve_typed<int64_t>(cg, dst_tp);
+      case uint8_id:
+        return resolve_typed<uint8_t>(cg, dst_tp);
+      case uint16_id:
+        return resolve_typed<uint16_t>(cg, dst_tp);
+      case uint32_id:
+        return resolve_typed<uint32_t>(cg, dst_tp);
+      case uint64_id:
+        return resolve_typed<uint64_t>(cg, dst_tp);
+      case float32_id:
+        return resolve_typed<float>(cg, dst_tp);
+      case float64_id:
+        return resolve_typed<double>(cg, dst_tp);
+      case string_id:
+        return resolve_typed<string>(cg, dst_tp);
+      case fixed_bytes_id:
+        return resolve_bytes(cg, dst_tp, src0_element_tp.get_data_size());
+      case fixed_string_id:
+        switch (src0_element_tp.extended<ndt::fixed_string_type>()->get_encoding()) {
+        case string_encoding_ascii:
+        case string_encoding_utf_8:
+          return resolve_bytes(cg, dst_tp, src0_element_tp.get_data_size());
+        default:
+          break;
+        }
+        break;
+      default:
+        break;
+      }
+
+      // Any other element type is ordered with its less kernel, which is only
+      // called from several threads at once when it is thread-safe
+      bool thread_safe = less->is_thread_safe();
+      cg.emplace_back([thread_safe](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                                    const char *dst_arrmeta, size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
+        kb.emplace_back<argsort_kernel>(
+            kernreq, reinterpret_cast<const fixed_dim_type_arrmeta *>(dst_arrmeta)->stride,
+            reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
+            reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride, thread_safe);
+
+        const char *src0_element_arrmeta = src_arrmeta[0] + sizeof(fixed_dim_type_arrmeta);
+        const char *child_src_arrmeta[2] = {src0_element_arrmeta, src0_element_arrmeta};
+        kb(kernel_request_single, nullptr, nullptr, 2, child_src_arrmeta);
+      });
+
+      const ndt::type child_src_tp[2] = {src0_element_tp, src0_element_tp};
+      less->resolve(this, nullptr, cg, ndt::make_type<bool1>(), 2, child_src_tp, 0, nullptr, tp_vars);
+
+      return dst_tp;
+    }
+
+  private:
+    template <typename T>
+    static ndt::type resolve_typed(call_graph &cg, const ndt::type &dst_tp) {
+      cg.emplace_back([](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data), const char *dst_arrmeta,
+                         size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
+        kb.emplace_back<typed_argsort_kernel<T>>(
+            kernreq, reinterpret_cast<const fixed_dim_type_arrmeta *>(dst_arrmeta)->stride,
+            reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
+            reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride);
+      });
+
+      return dst_tp;
+    }
+
+    static ndt::type resolve_bytes(call_graph &cg, const ndt::type &dst_tp, size_t data_size) {
+      cg.emplace_back([data_size](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                                  const char *dst_arrmeta, size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
+        kb.emplace_back<bytes_argsort_kernel>(
+            kernreq, reinterpret_cast<const fixed_dim_type_arrmeta *>(dst_arrmeta)->stride,
+            reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
+            reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride, data_size);
+      });
+
+      return dst_tp;
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
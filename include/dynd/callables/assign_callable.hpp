@@ -8,10 +8,14 @@
 #include <dynd/callables/base_callable.hpp>
 #include <dynd/functional.hpp>
 #include <dynd/kernels/assignment_kernels.hpp>
+#include <dynd/types/bool_kind_type.hpp>
+#include <dynd/types/categorical_kind_type.hpp>
 #include <dynd/types/fixed_bytes_kind_type.hpp>
 #include <dynd/types/fixed_string_kind_type.hpp>
 #include <dynd/types/float_kind_type.hpp>
 #include <dynd/types/int_kind_type.hpp>
+#include <dynd/types/string_kind_type.hpp>
+#include <dynd/types/uint_kind_type.hpp>
 
 namespace dynd {
 namespace nd {
@@ -284,10 +288,10 @@ namespace nd {
                       const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
       assign_error_mode error_mode = kwds[0].is_na() ? assign_error_default : kwds[0].as<assign_error_mode>();
 
-      cg.emplace_back([=](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
-                          const char *DYND_UNUSED(dst_arrmeta), size_t DYND_UNUSED(nsrc),
-                          const char *const *DYND_UNUSED(src_arrmeta)) {
-        const ndt::fixed_string_type *src_fs = src_tp[0].extended<ndt::fixed_string_type>();
+      cg.emplace_back([ dst_tp, src0_tp = src_tp[0], error_mode ](
+          kernel_builder & kb, kernel_request_t kernreq, char *DYND_UNUSED(data), const char *DYND_UNUSED(dst_arrmeta),
+          size_t DYND_UNUSED(nsrc), const char *const *DYND_UNUSED(src_arrmeta)) {
+        const ndt::fixed_string_type *src_fs = src0_tp.extended<ndt::fixed_string_type>();
         kb.emplace_back<
             detail::assignment_kernel<ndt::fixed_string_type, ndt::fixed_string_type, assign_error_nocheck>>(
             kernreq, get_next_unicode_codepoint_function(src_fs->get_encoding(), error_mode),
@@ -405,6 +409,27 @@ namespace nd {
     }
   };
 
+  template <typename Arg0Type>
+  class assign_callable<string_view, Arg0Type> : public base_callable {
+  public:
+    assign_callable()
+        : base_callable(ndt::make_type<ndt::callable_type>(
+              ndt::make_type<string_view>(), {ndt::make_type<Arg0Type>()},
+              {{ndt::make_type<ndt::option_type>(ndt::make_type<assign_error_mode>()), "error_mode"}})) {}
+
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
+                      size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
+                      const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
+      cg.emplace_back([](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data), const char *dst_arrmeta,
+                         size_t DYND_UNUSED(nsrc), const char *const *DYND_UNUSED(src_arrmeta)) {
+        kb.emplace_back<detail::assignment_kernel<string_view, Arg0Type, assign_error_nocheck>>(kernreq, dst_arrmeta);
+      });
+
+      return dst_tp;
+    }
+  };
+
   template <>
   class assign_callable<float, string> : public base_callable {
   public:
@@ -482,6 +507,70 @@ namespace nd {
     }
   };
 
+  /**
+   * Encodes values of a kind as the categories of a categorical type. Values
+   * of any other type than the categories are assigned to it first.
+   */
+  template <typename SrcKindType>
+  class categorical_assign_callable : public base_callable {
+  public:
+    categorical_assign_callable()
+        : base_callable(ndt::make_type<ndt::callable_type>(
+              ndt::make_type<ndt::categorical_kind_type>(), {ndt::make_type<SrcKindType>()},
+              {{ndt::make_type<ndt::option_type>(ndt::make_type<assign_error_mode>()), "error_mode"}})) {}
+
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *src_tp, size_t nkwd,
+                      const array *kwds, const std::map<std::string, ndt::type> &tp_vars) {
+      // Values of another type are assigned to the category type first
+      const ndt::type &category_tp = dst_tp.extended<ndt::categorical_type>()->get_category_type();
+      if (src_tp[0] != category_tp) {
+        return functional::compose(assign, assign, category_tp)
+            ->resolve(this, nullptr, cg, dst_tp, 1, src_tp, nkwd, kwds, tp_vars);
+      }
+
+      cg.emplace_back([dst_tp](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                               const char *DYND_UNUSED(dst_arrmeta), size_t DYND_UNUSED(nsrc),
+                               const char *const *src_arrmeta) {
+        kb.emplace_back<assignment_kernel<ndt::categorical_type, ndt::scalar_kind_type>>(kernreq, dst_tp,
+                                                                                         src_arrmeta[0]);
+      });
+
+      return dst_tp;
+    }
+  };
+
+  /**
+   * Decodes the values of a categorical type as its categories, which are
+   * then assigned to a destination of kind ``KindType``.
+   */
+  template <typename KindType>
+  class categorical_to_value_assign_callable : public base_callable {
+  public:
+    categorical_to_value_assign_callable()
+        : base_callable(ndt::make_type<ndt::callable_type>(
+              ndt::make_type<KindType>(), {ndt::make_type<ndt::categorical_kind_type>()},
+              {{ndt::make_type<ndt::option_type>(ndt::make_type<assign_error_mode>()), "error_mode"}})) {}
+
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *src_tp, size_t nkwd,
+                      const array *kwds, const std::map<std::string, ndt::type> &tp_vars) {
+      cg.emplace_back([src0_tp = src_tp[0]](kernel_builder & kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                                             const char *dst_arrmeta, size_t DYND_UNUSED(nsrc),
+                                             const char *const *DYND_UNUSED(src_arrmeta)) {
+        kb.emplace_back<assignment_kernel<ndt::scalar_kind_type, ndt::categorical_type>>(kernreq, src0_tp);
+
+        const char *category_arrmeta = src0_tp.extended<ndt::categorical_type>()->get_category_arrmeta();
+        kb(kernel_request_single, nullptr, dst_arrmeta, 1, &category_arrmeta);
+      });
+
+      const ndt::type &category_tp = src_tp[0].extended<ndt::categorical_type>()->get_category_type();
+      assign->resolve(this, nullptr, cg, dst_tp, 1, &category_tp, nkwd, kwds, tp_vars);
+
+      return dst_tp;
+    }
+  };
+
   template <>
   class assign_callable<ndt::pointer_type, ndt::pointer_type> : public base_callable {
   public:
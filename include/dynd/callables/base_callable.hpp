@@ -7,7 +7,10 @@
 
 #include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <typeinfo>
+#include <vector>
 
 #include <dynd/array.hpp>
 #include <dynd/callables/call_graph.hpp>
@@ -20,6 +23,67 @@ namespace nd {
 
   class call_graph;
 
+  namespace detail {
+
+    /**
+     * A call graph together with the types, keyword arguments and type
+     * variables it was resolved from. The closures in a call graph may hold
+     * pointers into any of these, so they are owned alongside it.
+     */
+    struct resolved_call {
+      ndt::type dst_tp;
+      std::vector<ndt::type> src_tp;
+      std::vector<array> kwds;
+      std::map<std::string, ndt::type> tp_vars;
+      size_t generation;
+
+      ndt::type resolved_dst_tp;
+      call_graph cg;
+    };
+
+    /**
+     * A small cache of the call graphs most recently resolved by a callable,
+     * keyed on the destination type, the source types and the keyword
+     * arguments. Only calls whose keyword arguments are all missing are
+     * cached, since resolving those depends on nothing but the types.
+     */
+    class DYND_API resolve_cache {
+      std::mutex m_mutex;
+      std::vector<std::shared_ptr<resolved_call>> m_entries;
+      size_t m_next;
+
+    public:
+      static const size_t capacity = 8;
+
+      resolve_cache() : m_next(0) {}
+
+      std::shared_ptr<resolved_call> find(const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp, size_t nkwd,
+                                          const array *kwds);
+
+      void insert(const std::shared_ptr<resolved_call> &entry);
+
+      void clear();
+
+      /**
+       * Whether a call with these keyword arguments may be cached.
+       */
+      static bool is_cacheable(size_t nkwd, const array *kwds);
+
+      /**
+       * The current generation of all resolve caches. Entries resolved in an
+       * earlier generation are never returned.
+       */
+      static size_t generation();
+
+      /**
+       * Invalidates every resolve cache, e.g. after a callable has been
+       * overloaded and cached call graphs may now dispatch differently.
+       */
+      static void invalidate_all();
+    };
+
+  } // namespace dynd::nd::detail
+
   enum callable_property {
     none = 0x00000000,
     left_associative = 0x00000001,
@@ -36,6 +100,9 @@ namespace nd {
     callable_flag_none = 0x00000000,
     // This callable cannot be instantiated
     callable_flag_abstract = 0x00000001,
+    // The kernels of this callable keep no state shared between calls, so
+    // several threads may run them at once
+    callable_flag_thread_safe = 0x00000002,
   };
 
   /**
@@ -53,9 +120,11 @@ namespace nd {
   protected:
     std::atomic_long m_use_count;
     ndt::type m_tp;
+    uint32_t m_flags;
+    detail::resolve_cache m_resolve_cache;
 
   public:
-    base_callable(const ndt::type &tp) : m_use_count(0), m_tp(tp) {}
+    base_callable(const ndt::type &tp) : m_use_count(0), m_tp(tp), m_flags(callable_flag_none) {}
 
     // non-copyable
     base_callable(const base_callable &) = delete;
@@ -90,6 +159,23 @@ namespace nd {
 
     bool is_kwd_variadic() const { return m_tp.extended<ndt::callable_type>()->is_kwd_variadic(); }
 
+    uint32_t get_flags() const { return m_flags; }
+
+    /**
+     * Whether the kernels of this callable may be run on several threads at
+     * once, e.g. over different chunks of an elwise loop. A callable is not
+     * until it opts in with ``set_thread_safe``.
+     */
+    bool is_thread_safe() const { return (m_flags & callable_flag_thread_safe) != 0; }
+
+    void set_thread_safe(bool thread_safe) {
+      if (thread_safe) {
+        m_flags |= callable_flag_thread_safe;
+      } else {
+        m_flags &= ~static_cast<uint32_t>(callable_flag_thread_safe);
+      }
+    }
+
     /**
      * Function prototype for instantiating a kernel from an
      * callable. To use this function, the
@@ -115,6 +201,14 @@ namespace nd {
 
     //    virtual void resolve() {}
 
+    /**
+     * Resolves this callable as the top of a call graph, reusing a call graph
+     * from a previous resolution with the same types when one is cached.
+     */
+    std::shared_ptr<detail::resolved_call> resolve_cached(const ndt::type &dst_tp, size_t nsrc,
+                                                          const ndt::type *src_tp, size_t nkwd, const array *kwds,
+                                                          const std::map<std::string, ndt::type> &tp_vars);
+
     virtual array alloc(const ndt::type *dst_tp) const { return empty(*dst_tp); }
 
     virtual void overload(const callable &DYND_UNUSED(value)) {
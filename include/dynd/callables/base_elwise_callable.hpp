@@ -6,6 +6,7 @@
 #pragma once
 
 #include <array>
+#include <memory>
 
 #include <dynd/callables/base_callable.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
@@ -32,6 +33,9 @@ namespace nd {
         intptr_t res_alignment;
         size_t ndim;
         bool res_ignore;
+        // Set once the element types are resolved, which happens after the
+        // kernel closure for this dimension has been added to the call graph
+        std::shared_ptr<bool> parallel;
       };
 
     public:
@@ -103,6 +107,7 @@ namespace nd {
           }
         }
 
+        data.parallel = std::make_shared<bool>(false);
         subresolve(cg, reinterpret_cast<char *>(&data));
 
         if (--reinterpret_cast<codata_type *>(codata)->ndim > 0) {
@@ -113,6 +118,16 @@ namespace nd {
                                           arg_element_tp.data(), nkwd, kwds, tp_vars);
         }
 
+        // The outer loop can only be split across threads when the child has
+        // declared its kernels thread-safe, every thread writes to its own
+        // elements, and no element owns memory that the child kernel would
+        // need to allocate
+        bool parallel = !res_ignore && child->is_thread_safe() && res_element_tp.is_pod();
+        for (size_t i = 0; i < N; ++i) {
+          parallel &= arg_element_tp[i].is_pod();
+        }
+        *data.parallel = parallel;
+
         if (res_ignore) {
           return res_element_tp;
         }
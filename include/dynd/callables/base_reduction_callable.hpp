@@ -6,6 +6,7 @@
 #pragma once
 
 #include <array>
+#include <memory>
 
 #include <dynd/callables/base_callable.hpp>
 #include <dynd/kernels/reduction_kernel.hpp>
@@ -21,6 +22,7 @@ namespace nd {
       struct data_type {
         callable identity;
         callable child;
+        bool associative;
         bool keepdims;
         size_t naxis;
         const int *axes;
@@ -32,6 +34,10 @@ namespace nd {
         bool inner;
         bool broadcast;
         bool keepdim;
+        // The type of the private accumulators used to split this dimension
+        // across threads, or null when it is always reduced serially. It is
+        // only known once the children have been resolved.
+        std::shared_ptr<ndt::type> accum_tp;
       };
 
       base_reduction_callable() : base_callable(ndt::type()) {}
@@ -54,6 +60,7 @@ namespace nd {
         }
         node.broadcast = !reduce;
         node.keepdim = reinterpret_cast<data_type *>(data)->keepdims;
+        node.accum_tp = std::make_shared<ndt::type>();
 
         std::vector<ndt::type> arg_element_tp(2);
         for (size_t i = 0; i < nsrc; ++i) {
@@ -65,6 +72,17 @@ namespace nd {
         }
         ++reinterpret_cast<data_type *>(data)->axis;
 
+        // A dimension can be split across threads when its destination is a
+        // single element, i.e. it and all the dimensions after it are reduced
+        bool reduce_inner = reduce;
+        for (intptr_t i = reinterpret_cast<data_type *>(data)->axis;
+             i < reinterpret_cast<data_type *>(data)->ndim && reduce_inner; ++i) {
+          reduce_inner = reinterpret_cast<data_type *>(data)->axes == NULL;
+          for (size_t j = 0; j < reinterpret_cast<data_type *>(data)->naxis && !reduce_inner; ++j) {
+            reduce_inner = reinterpret_cast<data_type *>(data)->axes[j] == i;
+          }
+        }
+
         ndt::type ret_element_tp;
         if (reinterpret_cast<data_type *>(data)->axis == reinterpret_cast<data_type *>(data)->ndim) {
           node.inner = true;
@@ -82,6 +100,17 @@ namespace nd {
           ret_element_tp = caller->resolve(this, data, cg, res_tp, nsrc, arg_element_tp.data(), nkwd, kwds, tp_vars);
         }
 
+        // Partial results are merged with the child itself, which is only
+        // correct when it was declared associative with a neutral identity, and
+        // needs it to accept its own return type. The chunks run on several
+        // threads at once, so the child must also be thread-safe
+        ndt::type accum_tp = ret_element_tp.get_dtype();
+        if (reinterpret_cast<data_type *>(data)->associative && child->is_thread_safe() && reduce_inner && nsrc == 1 &&
+            src_tp[0].get_id() == fixed_dim_id && accum_tp.is_pod() && accum_tp == src_tp[0].get_dtype()) {
+          *node.accum_tp = accum_tp;
+          child->resolve(this, nullptr, cg, child_ret_tp, nsrc, &accum_tp, nkwd - 2, kwds + 2, tp_vars);
+        }
+
         if (reduce) {
           if (reinterpret_cast<data_type *>(data)->keepdims) {
             return ndt::make_type<ndt::fixed_dim_type>(1, ret_element_tp);
@@ -103,10 +132,11 @@ namespace nd {
         bool inner = reinterpret_cast<node_type *>(data)->inner;
         bool broadcast = reinterpret_cast<node_type *>(data)->broadcast;
         bool keepdim = reinterpret_cast<node_type *>(data)->keepdim;
+        std::shared_ptr<ndt::type> accum_tp = reinterpret_cast<node_type *>(data)->accum_tp;
 
-        cg.emplace_back([inner, broadcast, keepdim](kernel_builder &kb, kernel_request_t kernreq,
-                                                    char *DYND_UNUSED(data), const char *dst_arrmeta, size_t nsrc,
-                                                    const char *const *src_arrmeta) {
+        cg.emplace_back([inner, broadcast, keepdim, accum_tp](kernel_builder &kb, kernel_request_t kernreq,
+                                                              char *DYND_UNUSED(data), const char *dst_arrmeta,
+                                                              size_t nsrc, const char *const *src_arrmeta) {
           if (inner) {
             if (!broadcast) {
               intptr_t src_size = reinterpret_cast<const size_stride_t *>(src_arrmeta[0])->dim_size;
@@ -137,6 +167,16 @@ namespace nd {
 
               e = kb.get_at<self_type>(root_ckb_offset);
               e->init_offset = init_offset - root_ckb_offset;
+
+              if (!accum_tp->is_null()) {
+                intptr_t combine_offset = kb.size();
+                const char *accum_arrmeta = dst_arrmeta + sizeof(size_stride_t);
+                kb(kernel_request_single, nullptr, accum_arrmeta, 1, &accum_arrmeta);
+
+                e = kb.get_at<self_type>(root_ckb_offset);
+                e->combine_offset = combine_offset - root_ckb_offset;
+                e->accum_size = accum_tp->get_data_size();
+              }
             } else {
               const char *src_element_arrmeta[NArg];
               for (size_t j = 0; j < NArg; ++j) {
@@ -179,6 +219,7 @@ namespace nd {
 
             intptr_t src_size = reinterpret_cast<const size_stride_t *>(src_arrmeta[0])->dim_size;
 
+            intptr_t root_ckb_offset = kb.size();
             if (broadcast) {
               kb.emplace_back<reduction_kernel<ndt::fixed_dim_type, true, false, NArg>>(kernreq, src_size, dst_arrmeta,
                                                                                         src_arrmeta);
@@ -189,8 +230,18 @@ namespace nd {
               kernreq = kernel_request_single;
             }
 
-            kb(kernreq, nullptr, keepdim ? (dst_arrmeta + sizeof(size_stride_t)) : dst_arrmeta, nsrc,
-               src_element_arrmeta);
+            const char *dst_element_arrmeta = keepdim ? (dst_arrmeta + sizeof(size_stride_t)) : dst_arrmeta;
+            kb(kernreq, nullptr, dst_element_arrmeta, nsrc, src_element_arrmeta);
+
+            if (!accum_tp->is_null()) {
+              typedef reduction_kernel<ndt::fixed_dim_type, false, false, NArg> self_type;
+              intptr_t combine_offset = kb.size();
+              kb(kernel_request_single, nullptr, dst_element_arrmeta, 1, &dst_element_arrmeta);
+
+              self_type *e = kb.get_at<self_type>(root_ckb_offset);
+              e->combine_offset = combine_offset - root_ckb_offset;
+              e->accum_size = accum_tp->get_data_size();
+            }
           }
         });
       }
@@ -5,12 +5,56 @@
 
 #pragma once
 
+#include <dynd/assignment.hpp>
 #include <dynd/callables/base_callable.hpp>
 #include <dynd/comparison.hpp>
 #include <dynd/kernels/binary_search_kernel.hpp>
 
 namespace dynd {
 namespace nd {
+  namespace detail {
+
+    /**
+     * Emplaces a ``search_convert_kernel``, which assigns the needles of a
+     * search to a buffer of ``buffer_tp`` before the search that follows it in
+     * the call graph, and the assignment after that.
+     */
+    inline void emplace_search_convert(call_graph &cg, const ndt::type &buffer_tp) {
+      cg.emplace_back([buffer_tp](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                                  const char *dst_arrmeta, size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
+        intptr_t root_kb_offset = kb.size();
+        kb.emplace_back<search_convert_kernel>(kernreq, empty(buffer_tp));
+
+        search_convert_kernel *self = kb.get_at<search_convert_kernel>(root_kb_offset);
+        const char *buffer_arrmeta = self->buffer.get()->metadata();
+        const char *search_src_arrmeta[2] = {src_arrmeta[0], buffer_arrmeta};
+        kb(kernel_request_single, nullptr, dst_arrmeta, 2, search_src_arrmeta);
+
+        self = kb.get_at<search_convert_kernel>(root_kb_offset);
+        self->convert_offset = kb.size() - root_kb_offset;
+        kb(kernel_request_single, nullptr, buffer_arrmeta, 1, src_arrmeta + 1);
+      });
+    }
+
+    /**
+     * Resolves a search of an array of ``src_tp[0]`` for needles of
+     * ``src_tp[1]`` through ``self`` after assigning them to ``buffer_tp``.
+     */
+    inline ndt::type resolve_search_convert(base_callable *self, call_graph &cg, const ndt::type &dst_tp,
+                                            const ndt::type *src_tp, const ndt::type &buffer_tp, size_t nkwd,
+                                            const array *kwds, const std::map<std::string, ndt::type> &tp_vars) {
+      emplace_search_convert(cg, buffer_tp);
+
+      ndt::type search_src_tp[2] = {src_tp[0], buffer_tp};
+      ndt::type res = self->resolve(nullptr, nullptr, cg, dst_tp, 2, search_src_tp, nkwd, kwds, tp_vars);
+
+      array error_mode = assign_error_default;
+      assign->resolve(self, nullptr, cg, buffer_tp, 1, src_tp + 1, 1, &error_mode, tp_vars);
+
+      return res;
+    }
+
+  } // namespace dynd::nd::detail
 
   class binary_search_callable : public base_callable {
   public:
@@ -19,24 +63,93 @@ namespace nd {
                                                            {ndt::type("Fixed * Scalar"), ndt::type("Scalar")})) {}
 
     ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
-                      const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
-                      size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
-                      const std::map<std::string, ndt::type> &tp_vars) {
+                      const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *src_tp, size_t nkwd,
+                      const array *kwds, const std::map<std::string, ndt::type> &tp_vars) {
+      // A value of another type is searched for as the element type
+      ndt::type element_tp = src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type();
+      if (src_tp[1] != element_tp) {
+        return detail::resolve_search_convert(this, cg, dst_tp, src_tp, element_tp, nkwd, kwds, tp_vars);
+      }
+
+      switch (element_tp.get_id()) {
+      case int8_id:
+        return resolve_typed<int8_t>(cg, dst_tp);
+      case int16_id:
+        return resolve_typed<int16_t>(cg, dst_tp);
+      case int32_id:
+        return resolve_typed<int32_t>(cg, dst_tp);
+      case int64_id:
+        return resolve_typed<int64_t>(cg, dst_tp);
+      case uint8_id:
+        return resolve_typed<uint8_t>(cg, dst_tp);
+      case uint16_id:
+        return resolve_typed<uint16_t>(cg, dst_tp);
+      case uint32_id:
+        return resolve_typed<uint32_t>(cg, dst_tp);
+      case uint64_id:
+        return resolve_typed<uint64_t>(cg, dst_tp);
+      case float32_id:
+        return resolve_typed<float>(cg, dst_tp);
+      case float64_id:
+        return resolve_typed<double>(cg, dst_tp);
+      case option_id:
+        switch (element_tp.extended<ndt::option_type>()->get_value_type().get_id()) {
+        case int8_id:
+          return resolve_typed<int8_t, detail::typed_option_search_less<int8_t>>(cg, dst_tp);
+        case int16_id:
+          return resolve_typed<int16_t, detail::typed_option_search_less<int16_t>>(cg, dst_tp);
+        case int32_id:
+          return resolve_typed<int32_t, detail::typed_option_search_less<int32_t>>(cg, dst_tp);
+        case int64_id:
+          return resolve_typed<int64_t, detail::typed_option_search_less<int64_t>>(cg, dst_tp);
+        case uint8_id:
+          return resolve_typed<uint8_t, detail::typed_option_search_less<uint8_t>>(cg, dst_tp);
+        case uint16_id:
+          return resolve_typed<uint16_t, detail::typed_option_search_less<uint16_t>>(cg, dst_tp);
+        case uint32_id:
+          return resolve_typed<uint32_t, detail::typed_option_search_less<uint32_t>>(cg, dst_tp);
+        case uint64_id:
+          return resolve_typed<uint64_t, detail::typed_option_search_less<uint64_t>>(cg, dst_tp);
+        case float32_id:
+          return resolve_typed<float, detail::typed_option_search_less<float>>(cg, dst_tp);
+        case float64_id:
+          return resolve_typed<double, detail::typed_option_search_less<double>>(cg, dst_tp);
+        default:
+          throw type_error("binary_search does not support the option type " + element_tp.str());
+        }
+      default:
+        break;
+      }
+
+      // Any other element type is compared with its less kernel
       cg.emplace_back([](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
                          const char *DYND_UNUSED(dst_arrmeta), size_t DYND_UNUSED(nsrc),
                          const char *const *src_arrmeta) {
-        kb.emplace_back<binary_search_kernel>(
+        kb.emplace_back<binary_search_kernel<detail::child_search_less>>(
             kernreq, reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
             reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride);
 
-        const char *child_src_arrmeta[2] = {src_arrmeta[0], src_arrmeta[0]};
-        kb(kernreq | kernel_request_data_only, nullptr, nullptr, 2, child_src_arrmeta);
+        const char *child_src_arrmeta[2] = {src_arrmeta[0] + sizeof(fixed_dim_type_arrmeta),
+                                            src_arrmeta[0] + sizeof(fixed_dim_type_arrmeta)};
+        kb(kernel_request_single, nullptr, nullptr, 2, child_src_arrmeta);
       });
 
-      ndt::type element_tp = src_tp[0].at_single(0, nullptr);
       ndt::type child_src_tp[2] = {element_tp, element_tp};
+      less->resolve(this, nullptr, cg, ndt::make_type<bool1>(), 2, child_src_tp, 0, NULL, tp_vars);
+
+      return dst_tp;
+    }
 
-      total_order->resolve(this, nullptr, cg, ndt::make_type<int>(), 2, child_src_tp, 0, NULL, tp_vars);
+  private:
+    template <typename T, typename LessType = detail::typed_search_less<T>>
+    static ndt::type resolve_typed(call_graph &cg, const ndt::type &dst_tp) {
+      cg.emplace_back([](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                         const char *DYND_UNUSED(dst_arrmeta), size_t DYND_UNUSED(nsrc),
+                         const char *const *src_arrmeta) {
+        kb.emplace_back<binary_search_kernel<LessType>>(
+            kernreq, reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
+            reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride);
+      });
 
       return dst_tp;
     }
@@ -49,10 +49,12 @@ namespace nd {
       void subresolve(call_graph &cg, const char *data) {
         bool res_broadcast = reinterpret_cast<const data_type *>(data)->res_ignore;
         const std::array<bool, N> &arg_broadcast = reinterpret_cast<const data_type *>(data)->arg_broadcast;
+        std::shared_ptr<bool> parallel = reinterpret_cast<const data_type *>(data)->parallel;
 
-        cg.emplace_back([res_broadcast, arg_broadcast](kernel_builder &kb, kernel_request_t kernreq, char *data,
-                                                       const char *dst_arrmeta, size_t DYND_UNUSED(nsrc),
-                                                       const char *const *src_arrmeta) {
+        cg.emplace_back([res_broadcast, arg_broadcast, parallel](kernel_builder &kb, kernel_request_t kernreq,
+                                                                 char *data, const char *dst_arrmeta,
+                                                                 size_t DYND_UNUSED(nsrc),
+                                                                 const char *const *src_arrmeta) {
           size_t size;
           if (res_broadcast) {
             size = reinterpret_cast<const size_stride_t *>(src_arrmeta[0])->dim_size;
@@ -82,8 +84,9 @@ namespace nd {
             }
           }
 
-          kb.emplace_back<elwise_kernel<fixed_dim_id, fixed_dim_id, TraitsType, N>>(kernreq, data, size, dst_stride,
-                                                                                    src_stride.data());
+          kb.emplace_back<elwise_kernel<fixed_dim_id, fixed_dim_id, TraitsType, N>>(
+              kernreq, data, size, dst_stride, src_stride.data(),
+              *parallel && std::is_same<TraitsType, no_traits>::value);
 
           kb(kernel_request_strided, TraitsType::child_data(data), child_dst_arrmeta, N, child_src_arrmeta.data());
         });
@@ -0,0 +1,41 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/callables/base_callable.hpp>
+#include <dynd/kernels/eytzinger_kernel.hpp>
+
+namespace dynd {
+namespace nd {
+
+  class eytzinger_callable : public base_callable {
+  public:
+    eytzinger_callable() : base_callable(ndt::type("(Fixed * Scalar) -> Fixed * Scalar")) {}
+
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+                      size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
+                      const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
+      ndt::type element_tp = src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type();
+      if (!element_tp.is_pod()) {
+        throw std::invalid_argument("eytzinger only supports plain old data, not " + element_tp.str());
+      }
+
+      size_t data_size = element_tp.get_data_size();
+      cg.emplace_back([data_size](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                                  const char *dst_arrmeta, size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
+        kb.emplace_back<eytzinger_kernel>(
+            kernreq, reinterpret_cast<const fixed_dim_type_arrmeta *>(dst_arrmeta)->stride,
+            reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
+            reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride, data_size);
+      });
+
+      return ndt::make_fixed_dim(src_tp[0].get_dim_size(NULL, NULL), element_tp);
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
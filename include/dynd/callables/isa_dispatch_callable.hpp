@@ -0,0 +1,67 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <algorithm>
+
+#include <dynd/callables/base_dispatch_callable.hpp>
+#include <dynd/cpu_features.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * Dispatches to one of several variants of the same callable, each compiled
+   * for a set of CPU features. The variant is picked when the callable is
+   * resolved, as the one with the most features that are all supported.
+   */
+  class isa_dispatch_callable : public base_dispatch_callable {
+    std::vector<std::pair<uint32_t, callable>> m_variants;
+
+  public:
+    isa_dispatch_callable(const ndt::type &tp, const std::vector<std::pair<uint32_t, callable>> &variants)
+        : base_dispatch_callable(tp) {
+      for (const auto &variant : variants) {
+        overload(variant.first, variant.second);
+      }
+    }
+
+    /**
+     * Adds the variant ``value``, to be used when every one of ``features`` is
+     * supported.
+     */
+    void overload(uint32_t features, const callable &value) {
+      auto it = std::find_if(m_variants.begin(), m_variants.end(), [features](const std::pair<uint32_t, callable> &v) {
+        return popcount(v.first) < popcount(features);
+      });
+      m_variants.insert(it, std::make_pair(features, value));
+      detail::resolve_cache::invalidate_all();
+    }
+
+    const callable &specialize(const ndt::type &DYND_UNUSED(dst_tp), intptr_t DYND_UNUSED(nsrc),
+                               const ndt::type *DYND_UNUSED(src_tp)) {
+      for (const auto &variant : m_variants) {
+        if (cpu_supports(variant.first)) {
+          return variant.second;
+        }
+      }
+
+      throw std::runtime_error("no variant of the callable is supported by this CPU");
+    }
+
+  private:
+    static int popcount(uint32_t features) {
+      int res = 0;
+      for (; features != 0; features &= features - 1) {
+        ++res;
+      }
+
+      return res;
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -23,6 +23,10 @@ namespace nd {
 
     void overload(const callable &value) {
       m_dispatcher.insert(value);
+      if (!value->is_thread_safe()) {
+        set_thread_safe(false);
+      }
+      detail::resolve_cache::invalidate_all();
     }
 
     const callable &specialize(const ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp) {
@@ -40,6 +44,31 @@ namespace nd {
 
     void overload(const callable &value) {
       m_dispatcher.insert(value);
+      if (!value->is_thread_safe()) {
+        set_thread_safe(false);
+      }
+      detail::resolve_cache::invalidate_all();
+    }
+
+    const callable &specialize(const ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp) {
+      return m_dispatcher(dst_tp, nsrc, src_tp);
+    }
+  };
+
+  template <>
+  class multidispatch_callable<3> : public base_dispatch_callable {
+    dispatcher<3, callable> m_dispatcher;
+
+  public:
+    multidispatch_callable(const ndt::type &tp, const dispatcher<3, callable> &dispatcher)
+        : base_dispatch_callable(tp), m_dispatcher(dispatcher) {}
+
+    void overload(const callable &value) {
+      m_dispatcher.insert(value);
+      if (!value->is_thread_safe()) {
+        set_thread_safe(false);
+      }
+      detail::resolve_cache::invalidate_all();
     }
 
     const callable &specialize(const ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp) {
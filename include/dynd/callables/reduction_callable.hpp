@@ -16,10 +16,12 @@ namespace nd {
     class reduction_dispatch_callable : public base_callable {
       callable m_identity;
       callable m_child;
+      bool m_associative;
 
     public:
-      reduction_dispatch_callable(const ndt::type &tp, const callable &identity, const callable &child)
-          : base_callable(tp), m_identity(identity), m_child(child) {}
+      reduction_dispatch_callable(const ndt::type &tp, const callable &identity, const callable &child,
+                                  bool associative)
+          : base_callable(tp), m_identity(identity), m_child(child), m_associative(associative) {}
 
       typedef typename base_reduction_callable::data_type new_data_type;
 
@@ -30,6 +32,7 @@ namespace nd {
         if (data == nullptr) {
           new_data.identity = m_identity;
           new_data.child = m_child;
+          new_data.associative = m_associative;
           if (kwds[0].is_na()) {
             new_data.naxis = src_tp[0].get_ndim() - m_child->get_ret_type().get_ndim();
             new_data.axes = NULL;
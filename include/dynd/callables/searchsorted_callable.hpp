@@ -0,0 +1,161 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/callables/base_callable.hpp>
+#include <dynd/callables/binary_search_callable.hpp>
+#include <dynd/comparison.hpp>
+#include <dynd/kernels/binary_search_kernel.hpp>
+
+namespace dynd {
+namespace nd {
+
+  class searchsorted_callable : public base_callable {
+  public:
+    searchsorted_callable()
+        : base_callable(
+              ndt::type("(Fixed * Scalar, Fixed * Scalar, side: ?string, layout: ?string) -> Fixed * intptr")) {}
+
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *src_tp, size_t nkwd,
+                      const array *kwds, const std::map<std::string, ndt::type> &tp_vars) {
+      // Values of another type are searched for as the element type
+      ndt::type element_tp = src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type();
+      ndt::type needle_tp = src_tp[1].extended<ndt::fixed_dim_type>()->get_element_type();
+      if (needle_tp != element_tp) {
+        return detail::resolve_search_convert(this, cg, dst_tp, src_tp,
+                                              ndt::make_fixed_dim(src_tp[1].get_dim_size(NULL, NULL), element_tp),
+                                              nkwd, kwds, tp_vars);
+      }
+
+      // A missing keyword is an option NA, which a string can not tell apart
+      // from an empty one, while a keyword that was passed keeps its own type
+      search_side side = search_left;
+      if (kwds[0].get_type().get_id() != option_id) {
+        std::string name = kwds[0].as<std::string>();
+        if (name == "right") {
+          side = search_right;
+        } else if (name == "exact") {
+          side = search_exact;
+        } else if (name != "left") {
+          throw std::invalid_argument("searchsorted side must be \"left\", \"right\" or \"exact\", not \"" + name +
+                                      "\"");
+        }
+      }
+
+      bool eytzinger = false;
+      if (kwds[1].get_type().get_id() != option_id) {
+        std::string name = kwds[1].as<std::string>();
+        if (name == "eytzinger") {
+          eytzinger = true;
+        } else if (name != "sorted") {
+          throw std::invalid_argument("searchsorted layout must be \"sorted\" or \"eytzinger\", not \"" + name + "\"");
+        }
+      }
+
+      switch (element_tp.get_id()) {
+      case int8_id:
+        emplace_kernel<detail::typed_search_less<int8_t>>(cg, side, eytzinger);
+        break;
+      case int16_id:
+        emplace_kernel<detail::typed_search_less<int16_t>>(cg, side, eytzinger);
+        break;
+      case int32_id:
+        emplace_kernel<detail::typed_search_less<int32_t>>(cg, side, eytzinger);
+        break;
+      case int64_id:
+        emplace_kernel<detail::typed_search_less<int64_t>>(cg, side, eytzinger);
+        break;
+      case uint8_id:
+        emplace_kernel<detail::typed_search_less<uint8_t>>(cg, side, eytzinger);
+        break;
+      case uint16_id:
+        emplace_kernel<detail::typed_search_less<uint16_t>>(cg, side, eytzinger);
+        break;
+      case uint32_id:
+        emplace_kernel<detail::typed_search_less<uint32_t>>(cg, side, eytzinger);
+        break;
+      case uint64_id:
+        emplace_kernel<detail::typed_search_less<uint64_t>>(cg, side, eytzinger);
+        break;
+      case float32_id:
+        emplace_kernel<detail::typed_search_less<float>>(cg, side, eytzinger);
+        break;
+      case float64_id:
+        emplace_kernel<detail::typed_search_less<double>>(cg, side, eytzinger);
+        break;
+      case option_id:
+        switch (element_tp.extended<ndt::option_type>()->get_value_type().get_id()) {
+        case int8_id:
+          emplace_kernel<detail::typed_option_search_less<int8_t>>(cg, side, eytzinger);
+          break;
+        case int16_id:
+          emplace_kernel<detail::typed_option_search_less<int16_t>>(cg, side, eytzinger);
+          break;
+        case int32_id:
+          emplace_kernel<detail::typed_option_search_less<int32_t>>(cg, side, eytzinger);
+          break;
+        case int64_id:
+          emplace_kernel<detail::typed_option_search_less<int64_t>>(cg, side, eytzinger);
+          break;
+        case uint8_id:
+          emplace_kernel<detail::typed_option_search_less<uint8_t>>(cg, side, eytzinger);
+          break;
+        case uint16_id:
+          emplace_kernel<detail::typed_option_search_less<uint16_t>>(cg, side, eytzinger);
+          break;
+        case uint32_id:
+          emplace_kernel<detail::typed_option_search_less<uint32_t>>(cg, side, eytzinger);
+          break;
+        case uint64_id:
+          emplace_kernel<detail::typed_option_search_less<uint64_t>>(cg, side, eytzinger);
+          break;
+        case float32_id:
+          emplace_kernel<detail::typed_option_search_less<float>>(cg, side, eytzinger);
+          break;
+        case float64_id:
+          emplace_kernel<detail::typed_option_search_less<double>>(cg, side, eytzinger);
+          break;
+        default:
+          throw type_error("searchsorted does not support the option type " + element_tp.str());
+        }
+        break;
+      default: {
+        // Any other element type is compared with its less kernel
+        emplace_kernel<detail::child_search_less>(cg, side, eytzinger);
+        ndt::type child_src_tp[2] = {element_tp, element_tp};
+        less->resolve(this, nullptr, cg, ndt::make_type<bool1>(), 2, child_src_tp, 0, NULL, tp_vars);
+        break;
+      }
+      }
+
+      return ndt::make_fixed_dim(src_tp[1].get_dim_size(NULL, NULL), ndt::make_type<intptr_t>());
+    }
+
+  private:
+    template <typename LessType>
+    static void emplace_kernel(call_graph &cg, search_side side, bool eytzinger) {
+      cg.emplace_back([side, eytzinger](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                                        const char *dst_arrmeta, size_t DYND_UNUSED(nsrc),
+                                        const char *const *src_arrmeta) {
+        kb.emplace_back<searchsorted_kernel<LessType>>(
+            kernreq, side, eytzinger, reinterpret_cast<const fixed_dim_type_arrmeta *>(dst_arrmeta)->stride,
+            reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
+            reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride,
+            reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[1])->dim_size,
+            reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[1])->stride);
+
+        if (LessType::has_child) {
+          const char *child_src_arrmeta[2] = {src_arrmeta[0] + sizeof(fixed_dim_type_arrmeta),
+                                              src_arrmeta[0] + sizeof(fixed_dim_type_arrmeta)};
+          kb(kernel_request_single, nullptr, nullptr, 2, child_src_arrmeta);
+        }
+      });
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -22,6 +22,34 @@ namespace nd {
                       size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
                       const std::map<std::string, ndt::type> &tp_vars) {
       const ndt::type &src0_element_tp = src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type();
+      switch (src0_element_tp.get_id()) {
+      case int8_id:
+        return resolve_typed<int8_t>(cg, dst_tp);
+      case int16_id:
+        return resolve_typed<int16_t>(cg, dst_tp);
+      case int32_id:
+        return resolve_typed<int32_t>(cg, dst_tp);
+      case int64_id:
+        return resolve_typed<int64_t>(cg, dst_tp);
+      case uint8_id:
+        return resolve_typed<uint8_t>(cg, dst_tp);
+      case uint16_id:
+        return resolve_typed<uint16_t>(cg, dst_tp);
+      case uint32_id:
+        return resolve_typed<uint32_t>(cg, dst_tp);
+      case uint64_id:
+        return resolve_typed<uint64_t>(cg, dst_tp);
+      case float32_id:
+        return resolve_typed<float>(cg, dst_tp);
+      case float64_id:
+        return resolve_typed<double>(cg, dst_tp);
+      case string_id:
+        return resolve_typed<string>(cg, dst_tp);
+      default:
+        break;
+      }
+
+      // Any other element type is sorted with its less kernel
       size_t src0_element_data_size = src0_element_tp.get_data_size();
       cg.emplace_back([src0_element_data_size](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
                                                const char *DYND_UNUSED(dst_arrmeta), size_t DYND_UNUSED(nsrc),
@@ -36,6 +64,20 @@ namespace nd {
       const ndt::type child_src_tp[2] = {src0_element_tp, src0_element_tp};
       less->resolve(this, nullptr, cg, ndt::make_type<bool1>(), 2, child_src_tp, 0, nullptr, tp_vars);
 
+      return dst_tp;
+    }
+
+  private:
+    template <typename T>
+    static ndt::type resolve_typed(call_graph &cg, const ndt::type &dst_tp) {
+      cg.emplace_back([](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                         const char *DYND_UNUSED(dst_arrmeta), size_t DYND_UNUSED(nsrc),
+                         const char *const *src_arrmeta) {
+        kb.emplace_back<typed_sort_kernel<T>>(
+            kernreq, reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
+            reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride);
+      });
+
       return dst_tp;
     }
   };
@@ -11,10 +11,32 @@
 namespace dynd {
 namespace nd {
 
-  class string_concat_callable : public default_instantiable_callable<string_concatenation_kernel> {
+  template <typename Arg0Type, typename Arg1Type>
+  class string_concat_callable : public base_callable {
   public:
     string_concat_callable()
-        : default_instantiable_callable<string_concatenation_kernel>(ndt::make_type<ndt::callable_type>(
+        : base_callable(ndt::make_type<ndt::callable_type>(ndt::make_type<string_view>(),
+                                                           {ndt::make_type<Arg0Type>(), ndt::make_type<Arg1Type>()})) {}
+
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
+                      size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
+                      const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
+      cg.emplace_back([](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data), const char *dst_arrmeta,
+                         size_t DYND_UNUSED(nsrc), const char *const *DYND_UNUSED(src_arrmeta)) {
+        kb.emplace_back<string_concatenation_kernel<Arg0Type, Arg1Type>>(kernreq, dst_arrmeta);
+      });
+
+      return dst_tp;
+    }
+  };
+
+  template <>
+  class string_concat_callable<string, string>
+      : public default_instantiable_callable<string_concatenation_kernel<string, string>> {
+  public:
+    string_concat_callable()
+        : default_instantiable_callable<string_concatenation_kernel<string, string>>(ndt::make_type<ndt::callable_type>(
               ndt::make_type<string>(), {ndt::make_type<string>(), ndt::make_type<string>()})) {}
   };
 
@@ -0,0 +1,40 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/callables/base_callable.hpp>
+#include <dynd/kernels/string_pack_kernel.hpp>
+
+namespace dynd {
+namespace nd {
+
+  template <typename Arg0Type>
+  class string_pack_callable : public base_callable {
+  public:
+    string_pack_callable()
+        : base_callable(ndt::make_type<ndt::callable_type>(
+              ndt::type("Fixed * string_view"),
+              {ndt::make_type<ndt::fixed_dim_kind_type>(ndt::make_type<Arg0Type>())})) {}
+
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+                      size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
+                      const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
+      cg.emplace_back([](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                         const char *DYND_UNUSED(dst_arrmeta), size_t DYND_UNUSED(nsrc),
+                         const char *const *src_arrmeta) {
+        kb.emplace_back<string_pack_kernel<Arg0Type>>(
+            kernreq, reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
+            reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride);
+      });
+
+      return ndt::make_type<ndt::fixed_dim_type>(src_tp[0].extended<ndt::fixed_dim_type>()->get_fixed_dim_size(),
+                                                 ndt::make_type<string_view>());
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
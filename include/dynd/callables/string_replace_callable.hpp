@@ -11,12 +11,15 @@
 namespace dynd {
 namespace nd {
 
-  class string_replace_callable : public default_instantiable_callable<string_replace_kernel> {
+  template <typename Arg0Type, typename Arg1Type, typename Arg2Type>
+  class string_replace_callable
+      : public default_instantiable_callable<string_replace_kernel<Arg0Type, Arg1Type, Arg2Type>> {
   public:
     string_replace_callable()
-        : default_instantiable_callable<string_replace_kernel>(ndt::make_type<ndt::callable_type>(
-              ndt::make_type<string>(),
-              {ndt::make_type<string>(), ndt::make_type<string>(), ndt::make_type<string>()})) {}
+        : default_instantiable_callable<string_replace_kernel<Arg0Type, Arg1Type, Arg2Type>>(
+              ndt::make_type<ndt::callable_type>(
+                  ndt::make_type<string>(),
+                  {ndt::make_type<Arg0Type>(), ndt::make_type<Arg1Type>(), ndt::make_type<Arg2Type>()})) {}
   };
 
 } // namespace dynd::nd
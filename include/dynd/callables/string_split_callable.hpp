@@ -11,11 +11,12 @@
 namespace dynd {
 namespace nd {
 
+  template <typename Arg0Type, typename Arg1Type>
   class string_split_callable : public base_callable {
   public:
     string_split_callable()
         : base_callable(ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::var_dim_type>(ndt::make_type<string>()),
-                                                           {ndt::make_type<string>(), ndt::make_type<string>()})) {}
+                                                           {ndt::make_type<Arg0Type>(), ndt::make_type<Arg1Type>()})) {}
 
     ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
                       const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
@@ -23,7 +24,7 @@ namespace nd {
                       const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
       cg.emplace_back([](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data), const char *dst_arrmeta,
                          size_t DYND_UNUSED(nsrc), const char *const *DYND_UNUSED(src_arrmeta)) {
-        kb.emplace_back<string_split_kernel>(
+        kb.emplace_back<string_split_kernel<Arg0Type, Arg1Type>>(
             kernreq, reinterpret_cast<const ndt::var_dim_type::metadata_type *>(dst_arrmeta)->blockref);
       });
 
@@ -5,33 +5,74 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include <dynd/callables/base_callable.hpp>
 #include <dynd/kernels/take_kernel.hpp>
 
 namespace dynd {
 namespace nd {
 
-  template <type_id_t Arg0ID>
-  class take_callable;
+  /**
+   * A take with a mask of the source's first dimension, which is either one
+   * ``bool1`` per element or packed bits, eight elements to the byte with the
+   * first in the lowest bit.
+   */
+  class masked_take_callable : public base_callable {
+    bool m_packed;
 
-  template <>
-  class take_callable<bool_id> : public base_callable {
   public:
-    take_callable() : base_callable(ndt::type("(Any, Fixed * bool) -> Any")) {}
+    masked_take_callable(const ndt::type &tp, bool packed) : base_callable(tp), m_packed(packed) {}
 
     ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
                       const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
                       size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
                       const std::map<std::string, ndt::type> &tp_vars) {
-      cg.emplace_back([](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data), const char *dst_arrmeta,
-                         size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
-        typedef nd::masked_take_ck self_type;
+      ndt::type src0_element_tp = src_tp[0].extended<ndt::base_dim_type>()->get_element_type();
+
+      // Scalars of plain old data are copied directly, rather than with an
+      // assignment kernel for each run
+      if (src0_element_tp.get_ndim() == 0 && src0_element_tp.is_pod()) {
+        switch (src0_element_tp.get_data_size()) {
+        case 1:
+          emplace_kernel<typed_masked_take_ck<uint8_t>>(cg, m_packed);
+          return ndt::make_type<ndt::var_dim_type>(src0_element_tp);
+        case 2:
+          emplace_kernel<typed_masked_take_ck<uint16_t>>(cg, m_packed);
+          return ndt::make_type<ndt::var_dim_type>(src0_element_tp);
+        case 4:
+          emplace_kernel<typed_masked_take_ck<uint32_t>>(cg, m_packed);
+          return ndt::make_type<ndt::var_dim_type>(src0_element_tp);
+        case 8:
+          emplace_kernel<typed_masked_take_ck<uint64_t>>(cg, m_packed);
+          return ndt::make_type<ndt::var_dim_type>(src0_element_tp);
+        case 16:
+          emplace_kernel<typed_masked_take_ck<detail::take_bytes16>>(cg, m_packed);
+          return ndt::make_type<ndt::var_dim_type>(src0_element_tp);
+        default:
+          break;
+        }
+      }
+
+      emplace_kernel<masked_take_ck>(cg, m_packed);
+
+      nd::array error_mode = assign_error_default;
+      assign->resolve(this, nullptr, cg, src0_element_tp, 1, &src0_element_tp, 1, &error_mode, tp_vars);
+
+      return ndt::make_type<ndt::var_dim_type>(src0_element_tp);
+    }
 
+  private:
+    template <typename KernelType>
+    static void emplace_kernel(call_graph &cg, bool packed) {
+      cg.emplace_back([packed](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                               const char *dst_arrmeta, size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
         intptr_t ckb_offset = kb.size();
-        kb.emplace_back<masked_take_ck>(kernreq);
+        kb.emplace_back<KernelType>(kernreq);
 
-        self_type *self = kb.get_at<self_type>(ckb_offset);
+        KernelType *self = kb.get_at<KernelType>(ckb_offset);
         self->m_dst_meta = dst_arrmeta;
+        self->m_packed = packed;
 
         const char *src0_el_meta = src_arrmeta[0] + sizeof(size_stride_t);
         intptr_t src0_dim_size = reinterpret_cast<const size_stride_t *>(src_arrmeta[0])->dim_size;
@@ -40,7 +81,12 @@ namespace nd {
         intptr_t mask_dim_size = reinterpret_cast<const size_stride_t *>(src_arrmeta[1])->dim_size;
         self->m_mask_stride = reinterpret_cast<const size_stride_t *>(src_arrmeta[1])->stride;
 
-        if (src0_dim_size != mask_dim_size) {
+        if (packed && (mask_dim_size != (src0_dim_size + 7) / 8 || (mask_dim_size > 1 && self->m_mask_stride != 1))) {
+          std::stringstream ss;
+          ss << "masked take arrfunc: a packed mask for " << src0_dim_size << " elements needs ";
+          ss << (src0_dim_size + 7) / 8 << " contiguous bytes, not " << mask_dim_size;
+          throw std::invalid_argument(ss.str());
+        } else if (!packed && src0_dim_size != mask_dim_size) {
           std::stringstream ss;
           ss << "masked take arrfunc: source data and mask have different sizes, ";
           ss << src0_dim_size << " and " << mask_dim_size;
@@ -49,16 +95,30 @@ namespace nd {
         self->m_dim_size = src0_dim_size;
 
         // Create the child element assignment ckernel
-        kb(kernel_request_strided, nullptr, dst_arrmeta + sizeof(ndt::var_dim_type::metadata_type), 1, &src0_el_meta);
+        if (std::is_same<KernelType, masked_take_ck>::value) {
+          kb(kernel_request_strided, nullptr, dst_arrmeta + sizeof(ndt::var_dim_type::metadata_type), 1,
+             &src0_el_meta);
+        }
       });
+    }
+  };
 
-      ndt::type src0_element_tp = src_tp[0].extended<ndt::base_dim_type>()->get_element_type();
+  template <type_id_t Arg0ID>
+  class take_callable;
 
-      nd::array error_mode = assign_error_default;
-      assign->resolve(this, nullptr, cg, src0_element_tp, 1, &src0_element_tp, 1, &error_mode, tp_vars);
+  template <>
+  class take_callable<bool_id> : public masked_take_callable {
+  public:
+    take_callable() : masked_take_callable(ndt::type("(Any, Fixed * bool) -> Any"), false) {}
+  };
 
-      return ndt::make_type<ndt::var_dim_type>(src0_element_tp);
-    }
+  /**
+   * A take with a mask of packed bits, which is only ever asked for by name,
+   * so that a uint8 array is never read as bits by accident.
+   */
+  class packed_take_callable : public masked_take_callable {
+  public:
+    packed_take_callable() : masked_take_callable(ndt::type("(Fixed * Any, Fixed * uint8) -> Any"), true) {}
   };
 
   class indexed_take_callable : public base_callable {
@@ -66,15 +126,11 @@ namespace nd {
     indexed_take_callable() : base_callable(ndt::type("(Any) -> Any")) {}
 
     ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
-                      const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+                      const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
                       size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
                       const std::map<std::string, ndt::type> &tp_vars) {
-
       ndt::type src0_element_tp = src_tp[0].get_type_at_dimension(NULL, 1).get_canonical_type();
 
-      nd::array error_mode = assign_error_default;
-      assign->resolve(this, nullptr, cg, src0_element_tp, 1, &src0_element_tp, 1, &error_mode, tp_vars);
-
       ndt::type resolved_dst_tp;
       if (src_tp[1].get_id() == var_dim_id) {
         resolved_dst_tp = ndt::make_type<ndt::var_dim_type>(src0_element_tp);
@@ -82,12 +138,49 @@ namespace nd {
         resolved_dst_tp = ndt::make_fixed_dim(src_tp[1].get_dim_size(NULL, NULL), src0_element_tp);
       }
 
-      cg.emplace_back([=](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
-                          const char *dst_arrmeta, size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
+      // Scalars of plain old data are copied directly, rather than with an
+      // assignment kernel for each element
+      if (src0_element_tp.get_ndim() == 0 && src0_element_tp.is_pod()) {
+        switch (src0_element_tp.get_data_size()) {
+        case 1:
+          emplace_kernel<typed_indexed_take_ck<uint8_t>>(cg, resolved_dst_tp, src_tp[0], src_tp[1]);
+          return resolved_dst_tp;
+        case 2:
+          emplace_kernel<typed_indexed_take_ck<uint16_t>>(cg, resolved_dst_tp, src_tp[0], src_tp[1]);
+          return resolved_dst_tp;
+        case 4:
+          emplace_kernel<typed_indexed_take_ck<uint32_t>>(cg, resolved_dst_tp, src_tp[0], src_tp[1]);
+          return resolved_dst_tp;
+        case 8:
+          emplace_kernel<typed_indexed_take_ck<uint64_t>>(cg, resolved_dst_tp, src_tp[0], src_tp[1]);
+          return resolved_dst_tp;
+        case 16:
+          emplace_kernel<typed_indexed_take_ck<detail::take_bytes16>>(cg, resolved_dst_tp, src_tp[0], src_tp[1]);
+          return resolved_dst_tp;
+        default:
+          break;
+        }
+      }
+
+      emplace_kernel<indexed_take_ck>(cg, resolved_dst_tp, src_tp[0], src_tp[1]);
+
+      nd::array error_mode = assign_error_default;
+      assign->resolve(this, nullptr, cg, src0_element_tp, 1, &src0_element_tp, 1, &error_mode, tp_vars);
+
+      return resolved_dst_tp;
+    }
+
+  private:
+    template <typename KernelType>
+    static void emplace_kernel(call_graph &cg, const ndt::type &dst_tp, const ndt::type &src0_tp,
+                               const ndt::type &index_tp) {
+      cg.emplace_back([dst_tp, src0_tp, index_tp](kernel_builder &kb, kernel_request_t kernreq,
+                                                  char *DYND_UNUSED(data), const char *dst_arrmeta,
+                                                  size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
         intptr_t self_offset = kb.size();
-        kb.emplace_back<indexed_take_ck>(kernreq);
+        kb.emplace_back<KernelType>(kernreq);
 
-        indexed_take_ck *self = kb.get_at<indexed_take_ck>(self_offset);
+        KernelType *self = kb.get_at<KernelType>(self_offset);
 
         ndt::type dst_el_tp;
         const char *dst_el_meta;
@@ -101,17 +194,17 @@ namespace nd {
         intptr_t index_dim_size;
         ndt::type src0_el_tp, index_el_tp;
         const char *src0_el_meta, *index_el_meta;
-        if (!src_tp[0].get_as_strided(src_arrmeta[0], &self->m_src0_dim_size, &self->m_src0_stride, &src0_el_tp,
-                                      &src0_el_meta)) {
+        if (!src0_tp.get_as_strided(src_arrmeta[0], &self->m_src0_dim_size, &self->m_src0_stride, &src0_el_tp,
+                                    &src0_el_meta)) {
           std::stringstream ss;
-          ss << "indexed take arrfunc: could not process type " << src_tp[0];
+          ss << "indexed take arrfunc: could not process type " << src0_tp;
           ss << " as a strided dimension";
           throw type_error(ss.str());
         }
-        if (!src_tp[1].get_as_strided(src_arrmeta[1], &index_dim_size, &self->m_index_stride, &index_el_tp,
-                                      &index_el_meta)) {
+        if (!index_tp.get_as_strided(src_arrmeta[1], &index_dim_size, &self->m_index_stride, &index_el_tp,
+                                     &index_el_meta)) {
           std::stringstream ss;
-          ss << "take arrfunc: could not process type " << src_tp[1];
+          ss << "take arrfunc: could not process type " << index_tp;
           ss << " as a strided dimension";
           throw type_error(ss.str());
         }
@@ -129,67 +222,11 @@ namespace nd {
         }
 
         // Create the child element assignment ckernel
-        kb(kernel_request_single, nullptr, dst_el_meta, 1, &src0_el_meta);
+        if (std::is_same<KernelType, indexed_take_ck>::value) {
+          kb(kernel_request_single, nullptr, dst_el_meta, 1, &src0_el_meta);
+        }
       });
-
-      return resolved_dst_tp;
     }
-
-    /*
-        void instantiate(call_node *&node, char *DYND_UNUSED(data), kernel_builder &kb, const ndt::type &dst_tp,
-                         const char *dst_arrmeta, intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
-                         const char *const *src_arrmeta, kernel_request_t kernreq, intptr_t DYND_UNUSED(nkwd),
-                         const array *DYND_UNUSED(kwds), const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
-          intptr_t self_offset = kb.size();
-          kb.emplace_back<indexed_take_ck>(kernreq);
-          node = next(node);
-
-          indexed_take_ck *self = kb.get_at<indexed_take_ck>(self_offset);
-
-          ndt::type dst_el_tp;
-          const char *dst_el_meta;
-          if (!dst_tp.get_as_strided(dst_arrmeta, &self->m_dst_dim_size, &self->m_dst_stride, &dst_el_tp, &dst_el_meta))
-       {
-            std::stringstream ss;
-            ss << "indexed take arrfunc: could not process type " << dst_tp;
-            ss << " as a strided dimension";
-            throw type_error(ss.str());
-          }
-
-          intptr_t index_dim_size;
-          ndt::type src0_el_tp, index_el_tp;
-          const char *src0_el_meta, *index_el_meta;
-          if (!src_tp[0].get_as_strided(src_arrmeta[0], &self->m_src0_dim_size, &self->m_src0_stride, &src0_el_tp,
-                                        &src0_el_meta)) {
-            std::stringstream ss;
-            ss << "indexed take arrfunc: could not process type " << src_tp[0];
-            ss << " as a strided dimension";
-            throw type_error(ss.str());
-          }
-          if (!src_tp[1].get_as_strided(src_arrmeta[1], &index_dim_size, &self->m_index_stride, &index_el_tp,
-                                        &index_el_meta)) {
-            std::stringstream ss;
-            ss << "take arrfunc: could not process type " << src_tp[1];
-            ss << " as a strided dimension";
-            throw type_error(ss.str());
-          }
-          if (self->m_dst_dim_size != index_dim_size) {
-            std::stringstream ss;
-            ss << "indexed take arrfunc: index data and dest have different sizes, ";
-            ss << index_dim_size << " and " << self->m_dst_dim_size;
-            throw std::invalid_argument(ss.str());
-          }
-          if (index_el_tp.get_id() != ndt::make_type<intptr_t>().get_id()) {
-            std::stringstream ss;
-            ss << "indexed take arrfunc: index type should be intptr, not ";
-            ss << index_el_tp;
-            throw type_error(ss.str());
-          }
-
-          // Create the child element assignment ckernel
-          node->instantiate(node, ckb, kernel_request_single, dst_el_meta, 1, &src0_el_meta);
-        }
-    */
   };
 
   class take_dispatch_callable : public base_callable {
@@ -209,6 +246,9 @@ namespace nd {
       } else {
         std::stringstream ss;
         ss << "take: unsupported type for the index " << mask_el_tp << ", need bool or intptr";
+        if (mask_el_tp.get_id() == uint8_id) {
+          ss << " (use take_packed for a mask of packed bits)";
+        }
         throw std::invalid_argument(ss.str());
       }
     }
@@ -7,6 +7,8 @@
 
 #include <dynd/callables/base_callable.hpp>
 #include <dynd/kernels/unique_kernel.hpp>
+#include <dynd/types/struct_type.hpp>
+#include <dynd/types/var_dim_type.hpp>
 
 namespace dynd {
 namespace nd {
@@ -14,33 +16,97 @@ namespace nd {
   class unique_callable : public base_callable {
   public:
     unique_callable()
-        : base_callable(ndt::make_type<ndt::callable_type>(ndt::make_type<void>(), {ndt::type("Fixed * Scalar")})) {}
+        : base_callable(ndt::type(
+              "(Fixed * Scalar, return_index: ?bool, return_inverse: ?bool, return_counts: ?bool) -> Any")) {}
 
-    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &DYND_UNUSED(cg),
-                      const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
-                      size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+                      size_t DYND_UNUSED(nkwd), const array *kwds,
                       const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
-      return dst_tp;
+      const ndt::type &src0_element_tp = src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type();
+      bool return_index = !kwds[0].is_na() && kwds[0].as<bool>();
+      bool return_inverse = !kwds[1].is_na() && kwds[1].as<bool>();
+      bool return_counts = !kwds[2].is_na() && kwds[2].as<bool>();
+
+      switch (src0_element_tp.get_id()) {
+      case bool_id:
+      case int8_id:
+      case uint8_id:
+        emplace_kernel<detail::unique_traits<uint8_t>>(cg, src0_element_tp, return_index, return_inverse,
+                                                       return_counts);
+        break;
+      case int16_id:
+      case uint16_id:
+        emplace_kernel<detail::unique_traits<uint16_t>>(cg, src0_element_tp, return_index, return_inverse,
+                                                        return_counts);
+        break;
+      case int32_id:
+      case uint32_id:
+        emplace_kernel<detail::unique_traits<uint32_t>>(cg, src0_element_tp, return_index, return_inverse,
+                                                        return_counts);
+        break;
+      case int64_id:
+      case uint64_id:
+        emplace_kernel<detail::unique_traits<uint64_t>>(cg, src0_element_tp, return_index, return_inverse,
+                                                        return_counts);
+        break;
+      case float32_id:
+        emplace_kernel<detail::unique_traits<float>>(cg, src0_element_tp, return_index, return_inverse, return_counts);
+        break;
+      case float64_id:
+        emplace_kernel<detail::unique_traits<double>>(cg, src0_element_tp, return_index, return_inverse,
+                                                      return_counts);
+        break;
+      case string_id:
+        emplace_kernel<detail::unique_traits<string>>(cg, src0_element_tp, return_index, return_inverse,
+                                                      return_counts);
+        break;
+      case fixed_bytes_id:
+        emplace_kernel<detail::unique_bytes_traits>(cg, src0_element_tp, return_index, return_inverse, return_counts);
+        break;
+      default:
+        throw std::invalid_argument("unique is not implemented for type " + src0_element_tp.str());
+      }
+
+      // The kernel replaces the result with fixed dimensions once it knows how
+      // many values there are, so this is a placeholder with var dimensions
+      ndt::type values_tp = ndt::make_type<ndt::var_dim_type>(src0_element_tp);
+      if (!return_index && !return_inverse && !return_counts) {
+        return values_tp;
+      }
+
+      ndt::type index_tp = ndt::make_type<ndt::var_dim_type>(ndt::make_type<intptr_t>());
+      std::vector<std::string> names{"values"};
+      std::vector<ndt::type> types{values_tp};
+      if (return_index) {
+        names.push_back("index");
+        types.push_back(index_tp);
+      }
+      if (return_inverse) {
+        names.push_back("inverse");
+        types.push_back(index_tp);
+      }
+      if (return_counts) {
+        names.push_back("counts");
+        types.push_back(index_tp);
+      }
+
+      return ndt::make_type<ndt::struct_type>(names, types);
     }
 
-    /*
-        void instantiate(call_node *&node, char *data, kernel_builder *ckb, const ndt::type &DYND_UNUSED(dst_tp),
-                         const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
-                         const char *const *src_arrmeta, kernel_request_t kernreq, intptr_t nkwd, const nd::array *kwds,
-                         const std::map<std::string, ndt::type> &tp_vars) {
-          const ndt::type &src0_element_tp = src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type();
-          ckb->emplace_back<unique_kernel>(
-              kernreq, reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
-              reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride,
-       src0_element_tp.get_data_size());
-          node = next(node);
-
-          const ndt::type equal_src_tp[2] = {src0_element_tp, src0_element_tp};
-          equal->instantiate(node, data, ckb, ndt::make_type<bool1>(), NULL, 2, equal_src_tp, NULL,
-       kernel_request_single,
-                             nkwd, kwds, tp_vars);
-        }
-    */
+  private:
+    template <typename TraitsType>
+    static void emplace_kernel(call_graph &cg, const ndt::type &src0_element_tp, bool return_index,
+                               bool return_inverse, bool return_counts) {
+      cg.emplace_back([src0_element_tp, return_index, return_inverse, return_counts](
+          kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data), const char *DYND_UNUSED(dst_arrmeta),
+          size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
+        kb.emplace_back<unique_kernel<TraitsType>>(
+            kernreq, reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
+            reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride, src0_element_tp, return_index,
+            return_inverse, return_counts);
+      });
+    }
   };
 
 } // namespace dynd::nd
@@ -42,7 +42,9 @@ nd::callable make_compound_arithmetic() {
   dispatcher.insert(nd::get_elwise(ndt::type("(Dim, Scalar) -> Any")));
   dispatcher.insert(nd::get_elwise(ndt::type("(Dim, Dim) -> Any")));
 
-  return nd::make_callable<nd::multidispatch_callable<2>>(tp, dispatcher);
+  nd::callable f = nd::make_callable<nd::multidispatch_callable<2>>(tp, dispatcher);
+  f->set_thread_safe(true);
+  return f;
 }
 
 } // anonymous namespace
@@ -164,8 +164,48 @@ inline void DYND_MEMCPY(char *dst, const char *src, intptr_t count) {
 #define DYND_MEMCPY(dst, src, count) std::memcpy(dst, src, count)
 #endif
 
+// Hints that the cache line holding ``addr`` is about to be read
+#if defined(__GNUC__) || defined(__clang__)
+#define DYND_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define DYND_PREFETCH(addr)
+#endif
+
 #include <dynd/type_sequence.hpp>
 
+namespace dynd {
+
+/**
+ * The number of set bits of ``x``.
+ */
+inline int popcount64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcountll(x);
+#else
+  x = x - ((x >> 1) & 0x5555555555555555ULL);
+  x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+  x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+  return static_cast<int>((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/**
+ * The position of the lowest set bit of ``x``, which must not be zero.
+ */
+inline int ctz64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(x);
+#else
+  int res = 0;
+  for (; (x & 1) == 0; x >>= 1) {
+    ++res;
+  }
+  return res;
+#endif
+}
+
+} // namespace dynd
+
 // These are small templates 'missing' from the standard library
 namespace dynd {
 
@@ -523,6 +563,20 @@ struct arg_at {
 #define DYND_END_IGNORE_MAYBE_UNINITIALIZED
 #endif
 
+/**
+ * DYND_TARGET(ISA) compiles a function for an instruction set extension
+ * beyond the baseline, e.g. DYND_TARGET("avx2"). Such a function may only be
+ * called after checking for the extension with dynd::cpu_supports. Where the
+ * compiler can't do this, DYND_ISA_DISPATCH is left undefined and every
+ * variant is compiled for the baseline.
+ */
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define DYND_ISA_DISPATCH
+#define DYND_TARGET(ISA) __attribute__((target(ISA)))
+#else
+#define DYND_TARGET(ISA)
+#endif
+
 // Check endian: define DYND_BIG_ENDIAN if big endian, otherwise assume little
 #if defined(__GLIBC__)
 #include <endian.h>
@@ -0,0 +1,59 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <cstdint>
+
+#include <dynd/config.hpp>
+
+namespace dynd {
+
+/**
+ * Instruction set extensions that kernels may have specialized variants for.
+ * A set of features is a bitwise or of these flags, and the empty set is the
+ * baseline ISA the library was compiled for.
+ */
+enum cpu_feature : uint32_t {
+  cpu_feature_none = 0x00000000,
+  cpu_feature_sse2 = 0x00000001,
+  cpu_feature_sse3 = 0x00000002,
+  cpu_feature_ssse3 = 0x00000004,
+  cpu_feature_sse4_1 = 0x00000008,
+  cpu_feature_sse4_2 = 0x00000010,
+  cpu_feature_avx = 0x00000020,
+  cpu_feature_fma = 0x00000040,
+  cpu_feature_avx2 = 0x00000080,
+  cpu_feature_avx512f = 0x00000100,
+  cpu_feature_avx512bw = 0x00000200
+};
+
+/**
+ * The features that the CPU running this process supports, and that the
+ * operating system saves the registers of. Detection uses cpuid, so it is
+ * only done on x86 with GCC or Clang; elsewhere this is cpu_feature_none.
+ */
+DYND_API uint32_t detected_cpu_features();
+
+/**
+ * The features that kernels may use, which are the detected ones minus any
+ * removed by ``restrict_cpu_features``.
+ */
+DYND_API uint32_t cpu_features();
+
+/**
+ * Limits the features that kernels may use to ``mask``, e.g. to get the same
+ * results on every machine of a heterogeneous fleet, or to test the
+ * baseline variants. Passing ``~0u`` goes back to everything detected.
+ * Callables resolved before this are resolved again on their next call.
+ */
+DYND_API void restrict_cpu_features(uint32_t mask);
+
+/**
+ * Returns true if every one of ``features`` may be used.
+ */
+inline bool cpu_supports(uint32_t features) { return (cpu_features() & features) == features; }
+
+} // namespace dynd
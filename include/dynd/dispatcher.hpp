@@ -5,9 +5,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <memory>
-
-// #include <sparsehash/dense_hash_map>
+#include <mutex>
 
 #include <dynd/type_registry.hpp>
 
@@ -132,21 +133,41 @@ inline std::ostream &print_ids(std::ostream &o, size_t nids, const ndt::type *tp
 
 template <size_t N, typename T>
 class dispatcher {
-  typedef std::map<size_t, T> Map;
-
 public:
   typedef T value_type;
 
-  typedef Map map_type;
-  //  typedef google::dense_hash_map<size_t, value_type> map_type;
-
   typedef typename std::vector<T>::iterator iterator;
   typedef typename std::vector<T>::const_iterator const_iterator;
 
 private:
+  // Calls with more types than this are not cached
+  static const size_t max_cache_ntp = 8;
+
+  /**
+   * A slot of the memoizing dispatch cache, which is empty when ``value`` is
+   * NULL. It is keyed on the types of the call itself, the destination type
+   * followed by the ``ntp - 1`` source types, so a hit needs neither the
+   * dispatch function nor the heap. The slot is found through the hash of the
+   * type ids, but the full types are kept and compared, as some children
+   * match on more than the ids.
+   */
+  struct cache_entry {
+    std::array<ndt::type, max_cache_ntp> tps;
+    size_t ntp;
+    const T *value;
+
+    cache_entry() : ntp(0), value(NULL) {}
+  };
+
+  // The cache is cleared instead of grown past this many entries
+  static const size_t max_cache_count = 1024;
+
   std::vector<T> m_children;
-  //  map_type m_map;
+  std::vector<std::array<ndt::type, N>> m_children_tps;
   dispatch_t m_dispatch;
+  std::vector<cache_entry> m_cache;
+  size_t m_cache_count;
+  std::mutex m_cache_mutex;
 
   static size_t hash_combine(size_t seed, type_id_t id) { return seed ^ (id + (seed << 6) + (seed >> 2)); }
 
@@ -164,18 +185,123 @@ private:
     return seed;
   }
 
+  // Some callers, like the option assignments, give a source count without
+  // the source types, which only the dispatch function knows to ignore
+  static bool is_cacheable(size_t nsrc, const ndt::type *src_tp) {
+    return nsrc < max_cache_ntp && (nsrc == 0 || src_tp != NULL);
+  }
+
+  static size_t hash_call(const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp) {
+    size_t seed = hash(dst_tp.get_id());
+    for (size_t i = 0; i < nsrc; ++i) {
+      seed = hash_combine(seed, src_tp[i].get_id());
+    }
+
+    return seed;
+  }
+
+  static bool matches(const cache_entry &entry, const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp) {
+    if (entry.ntp != nsrc + 1 || entry.tps[0] != dst_tp) {
+      return false;
+    }
+    for (size_t i = 0; i < nsrc; ++i) {
+      if (entry.tps[i + 1] != src_tp[i]) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  const T *find_cached(size_t key, const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp) {
+    std::lock_guard<std::mutex> lock(m_cache_mutex);
+    if (m_cache.empty()) {
+      return NULL;
+    }
+
+    size_t mask = m_cache.size() - 1;
+    for (size_t i = key & mask;; i = (i + 1) & mask) {
+      const cache_entry &entry = m_cache[i];
+      if (entry.value == NULL) {
+        return NULL;
+      }
+      if (matches(entry, dst_tp, nsrc, src_tp)) {
+        return entry.value;
+      }
+    }
+  }
+
+  void insert_cached(size_t key, const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp, const T *value) {
+    std::lock_guard<std::mutex> lock(m_cache_mutex);
+    if (m_cache_count == max_cache_count) {
+      m_cache.clear();
+      m_cache_count = 0;
+    }
+
+    // Keep the load factor at most 1/2, so probe sequences stay short
+    if (2 * (m_cache_count + 1) > m_cache.size()) {
+      std::vector<cache_entry> cache(std::max<size_t>(16, 2 * m_cache.size()));
+      for (cache_entry &entry : m_cache) {
+        if (entry.value != NULL) {
+          emplace_cached(cache, hash_call(entry.tps[0], entry.ntp - 1, entry.tps.data() + 1), entry);
+        }
+      }
+      m_cache.swap(cache);
+    }
+
+    cache_entry entry;
+    entry.tps[0] = dst_tp;
+    std::copy(src_tp, src_tp + nsrc, entry.tps.begin() + 1);
+    entry.ntp = nsrc + 1;
+    entry.value = value;
+    if (emplace_cached(m_cache, key, entry)) {
+      ++m_cache_count;
+    }
+  }
+
+  static bool emplace_cached(std::vector<cache_entry> &cache, size_t key, const cache_entry &entry) {
+    size_t mask = cache.size() - 1;
+    for (size_t i = key & mask;; i = (i + 1) & mask) {
+      if (cache[i].value == NULL) {
+        cache[i] = entry;
+        return true;
+      }
+      if (cache[i].ntp == entry.ntp && cache[i].tps == entry.tps) {
+        // Another thread got here first
+        return false;
+      }
+    }
+  }
+
+  void clear_cache() {
+    std::lock_guard<std::mutex> lock(m_cache_mutex);
+    m_cache.clear();
+    m_cache_count = 0;
+  }
+
 public:
-  dispatcher(dispatch_t dispatch) : m_dispatch(dispatch) {}
+  dispatcher(dispatch_t dispatch) : m_dispatch(dispatch), m_cache_count(0) {}
 
-  dispatcher(const dispatcher &other) : m_children(other.m_children), m_dispatch(other.m_dispatch) {}
+  dispatcher(const dispatcher &other)
+      : m_children(other.m_children), m_children_tps(other.m_children_tps), m_dispatch(other.m_dispatch),
+        m_cache_count(0) {}
 
   template <typename Iterator>
-  dispatcher(dispatch_t dispatch, Iterator begin, Iterator end) : m_dispatch(dispatch) {
-    //    m_map.set_empty_key(uninitialized_id);
-
+  dispatcher(dispatch_t dispatch, Iterator begin, Iterator end) : m_dispatch(dispatch), m_cache_count(0) {
     assign(begin, end);
   }
 
+  dispatcher &operator=(const dispatcher &other) {
+    if (this != &other) {
+      m_children = other.m_children;
+      m_children_tps = other.m_children_tps;
+      m_dispatch = other.m_dispatch;
+      clear_cache();
+    }
+
+    return *this;
+  }
+
   dispatcher(dispatch_t dispatch, std::initializer_list<T> pairs) : dispatcher(dispatch, pairs.begin(), pairs.end()) {}
 
   template <typename Iterator>
@@ -225,7 +351,14 @@ public:
 
     topological_sort(begin, end, edges, m_children.begin());
 
-    //    m_map.clear();
+    m_children_tps.resize(m_children.size());
+    for (size_t i = 0; i < m_children.size(); ++i) {
+      const T &child = m_children[i];
+      m_children_tps[i] =
+          as_array<N>(m_dispatch(child->get_ret_type(), child->get_narg(), child->get_arg_types().data()));
+    }
+
+    clear_cache();
   }
 
   void assign(std::initializer_list<T> pairs) { assign(pairs.begin(), pairs.end()); }
@@ -251,30 +384,25 @@ public:
   const_iterator cend() const { return m_children.cend(); }
 
   const value_type &operator()(const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp) {
-    std::vector<ndt::type> vector_tps = m_dispatch(dst_tp, nsrc, src_tp);
-    std::array<ndt::type, N> tps;
-
-    std::array<type_id_t, N> ids;
-    for (size_t i = 0; i < N; ++i) {
-      tps[i] = vector_tps[i];
-      ids[i] = tps[i].get_id();
+    // The cache is probed with the types of the call, before the dispatch
+    // function builds the types the children are matched on
+    bool cacheable = is_cacheable(nsrc, src_tp);
+    size_t key = 0;
+    if (cacheable) {
+      key = hash_call(dst_tp, nsrc, src_tp);
+      const T *cached = find_cached(key, dst_tp, nsrc, src_tp);
+      if (cached != NULL) {
+        return *cached;
+      }
     }
 
-    //    size_t key = hash(ids);
-
-    /*
-        const auto &it = m_map.find(key);
-        if (it != m_map.end()) {
-          return it->second;
+    std::array<ndt::type, N> tps = as_array<N>(m_dispatch(dst_tp, nsrc, src_tp));
+    for (size_t i = 0; i < m_children.size(); ++i) {
+      if (supercedes(tps, m_children_tps[i])) {
+        if (cacheable) {
+          insert_cached(key, dst_tp, nsrc, src_tp, &m_children[i]);
         }
-    */
-
-    for (const T &child : m_children) {
-      std::array<ndt::type, N> other_tps =
-          as_array<N>(m_dispatch(child->get_ret_type(), child->get_narg(), child->get_arg_types().data()));
-
-      if (supercedes(tps, other_tps)) {
-        return child;
+        return m_children[i];
       }
     }
 
@@ -13,8 +13,13 @@ namespace eval {
   struct DYNDT_API eval_context {
     // Default error mode for computations
     assign_error_mode errmode;
+    // Number of threads kernels may split their outer loop across,
+    // including the calling thread. 1 runs everything on the calling thread.
+    intptr_t nthreads;
+    // Smallest number of elements handed to a thread as one piece of work
+    intptr_t parallel_chunk_size;
 
-    eval_context() : errmode(assign_error_fractional) {}
+    eval_context() : errmode(assign_error_fractional), nthreads(1), parallel_chunk_size(16384) {}
   };
 
   extern DYNDT_API eval_context default_eval_context;
@@ -158,11 +158,26 @@ namespace nd {
     /**
      * Lifts the provided callable, broadcasting it as necessary to execute
      * across the additional dimensions in the ``lifted_types`` array.
+     *
+     * \param associative  If true, ``child`` is associative when it is applied
+     *                     to its own partial results and ``identity`` is
+     *                     neutral for it, so a reduction over one dimension may
+     *                     be split into chunks that are combined afterwards.
+     *                     Otherwise it is always evaluated serially.
      */
-    DYND_API callable reduction(const callable &identity, const callable &child);
+    DYND_API callable reduction(const callable &identity, const callable &child, bool associative = false);
 
     DYND_API callable where(const callable &child);
 
+    /**
+     * Makes a callable which picks one of ``variants`` when it is resolved,
+     * according to the features of the CPU. Each variant is paired with the
+     * cpu_feature flags it was compiled for, and they must all have the same
+     * signature. A variant for ``cpu_feature_none`` should be among them, so
+     * that there is one for every CPU.
+     */
+    DYND_API callable isa_dispatch(const std::vector<std::pair<uint32_t, callable>> &variants);
+
   } // namespace dynd::nd::functional
 } // namespace dynd::nd
 } // namespace dynd
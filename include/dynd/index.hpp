@@ -18,5 +18,11 @@ namespace nd {
    */
   extern DYND_API callable take;
 
+  /**
+   * A boolean masked take whose mask is a uint8 array of packed bits,
+   * eight elements to the byte with the first in the lowest bit.
+   */
+  extern DYND_API callable take_packed;
+
 } // namespace dynd::nd
 } // namespace dynd
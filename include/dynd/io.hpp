@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <string>
+
 #include <dynd/callable.hpp>
 
 namespace dynd {
@@ -12,5 +14,27 @@ namespace nd {
 
   extern DYND_API callable serialize;
 
+  /**
+   * Saves an array to a file in the native binary format, which ``nd::load``
+   * reads back. The file starts with a header and the datashape of the
+   * array, followed by its data in the default layout of its type, aligned
+   * to 64 bytes. The data of var dimensions, strings, bytes and pointers is
+   * out of line in a heap after it, with each value holding the offset of
+   * its data into the data section in place of a pointer.
+   *
+   * The data is in native byte order, and ``nd::load`` only reads files
+   * saved with the same byte order and pointer size.
+   */
+  DYND_API void save(const std::string &filename, const array &a);
+
+  /**
+   * Loads an array saved by ``nd::save`` by memory mapping the file. When
+   * its type holds all of its data in place, the array points into the
+   * mapping and nothing is copied. Otherwise var dimensions of such types
+   * still point into the mapping, while strings and bytes are copied out of
+   * it. The result is read-only.
+   */
+  DYND_API array load(const std::string &filename);
+
 } // namespace dynd::nd
 } // namespace dynd
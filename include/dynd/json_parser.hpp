@@ -5,14 +5,69 @@
 
 #pragma once
 
+#include <functional>
+#include <string>
+#include <vector>
+
 #include <dynd/array.hpp>
 
 namespace dynd {
 namespace ndt {
   namespace json {
 
+    /**
+     * Which values type discovery looks at, and whether it reuses an earlier
+     * result. The values are the elements of a document that is an array, or
+     * the lines of newline-delimited JSON.
+     */
+    struct discover_options {
+      /** The most values to look at, or all of them when zero */
+      intptr_t max_values;
+      /** Looks at every ``stride``-th value, starting with the first */
+      intptr_t stride;
+      /**
+       * When not empty, names the source of the input, and the type
+       * discovered for it is cached under that name. Discovery of another
+       * input with the same name returns the cached type without looking at
+       * the input at all, so the name should stand for a source whose values
+       * keep the same shape, like a feed of files with a common schema.
+       */
+      std::string cache_key;
+
+      discover_options() : max_values(0), stride(1) {}
+    };
+
+    /**
+     * Discovers the type of a JSON document, which is int64 or float64 for
+     * numbers, string, bool, a struct for an object, and an option type for
+     * a null. An array is a dimension of the common type of its elements,
+     * found by unifying the types of the elements in turn, and a tuple when
+     * they have none. Numbers unify with ``promote_types_arithmetic``, nulls
+     * make option types, arrays of different sizes make a var dimension, and
+     * objects make a struct of all their fields, with those missing from some
+     * of them optional.
+     */
     DYND_API void discover(ndt::type &res, const char *begin, const char *end);
 
+    /**
+     * Discovers the type of a JSON document, looking at only some of the
+     * elements when it is an array, as picked by ``opts``. Those are found
+     * with ``json::structural_index``, and when ``ectx->nthreads`` is more
+     * than one, their types are discovered in chunks on the thread pool and
+     * then unified in order.
+     *
+     * A sampled array is ``N * T`` with ``T`` the common type of the sampled
+     * elements, which the other elements are assumed to have.
+     */
+    DYND_API void discover(ndt::type &res, const char *begin, const char *end, const discover_options &opts,
+                           const eval::eval_context *ectx = &eval::default_eval_context);
+
+    inline void discover(ndt::type &res, const std::string &str, const discover_options &opts,
+                         const eval::eval_context *ectx = &eval::default_eval_context)
+    {
+      discover(res, str.data(), str.data() + str.size(), opts, ectx);
+    }
+
     inline void discover(ndt::type &res, const std::string &str)
     {
       discover(res, str.data(), str.data() + str.size());
@@ -26,6 +81,28 @@ namespace ndt {
       return res;
     }
 
+    /**
+     * Discovers the common type of the values of newline-delimited JSON, one
+     * on each line that is not blank, as the type to give ``parse_ndjson``.
+     * The values looked at are picked by ``opts``, and they are split among
+     * the thread pool like in ``discover``. Raises an error when they have no
+     * common type.
+     */
+    DYND_API ndt::type discover_ndjson(const char *begin, const char *end,
+                                       const discover_options &opts = discover_options(),
+                                       const eval::eval_context *ectx = &eval::default_eval_context);
+
+    inline ndt::type discover_ndjson(const std::string &str, const discover_options &opts = discover_options(),
+                                     const eval::eval_context *ectx = &eval::default_eval_context)
+    {
+      return discover_ndjson(str.data(), str.data() + str.size(), opts, ectx);
+    }
+
+    /**
+     * Forgets all of the types cached by discovery.
+     */
+    DYND_API void clear_discover_cache();
+
   } // namespace dynd::ndt::json
 } // namespace dynd::ndt
 
@@ -34,9 +111,101 @@ namespace nd {
 
     DYND_API array parse2(const ndt::type &tp, const std::string &str);
 
+    /**
+     * Reads newline-delimited JSON, which is one JSON value of the type ``tp``
+     * on each line that is not blank, from a source of bytes a chunk at a
+     * time. Only the chunk being parsed is held in memory, along with the
+     * start of a line it cuts off, so a stream of any length is read with a
+     * buffer of about ``chunk_size`` bytes. A line longer than that grows the
+     * buffer to fit it.
+     *
+     * When ``ectx->nthreads`` is more than one, the lines of a chunk are split
+     * at newlines into pieces which are parsed on the thread pool. Types with
+     * a var dimension allocate from the memory block of the array, so those
+     * are always parsed on the calling thread.
+     */
+    class DYND_API ndjson_reader {
+    public:
+      /**
+       * A source of bytes, which fills up to ``size`` bytes of ``buffer`` and
+       * returns how many it did, with zero meaning the end of the input.
+       */
+      typedef std::function<size_t(char *buffer, size_t size)> source_type;
+
+    private:
+      ndt::type m_tp;
+      source_type m_source;
+      const eval::eval_context *m_ectx;
+      std::vector<char> m_buffer;
+      // The bytes of the buffer read from the source and not yet parsed
+      size_t m_begin;
+      size_t m_end;
+      bool m_eof;
+      // The line number, counting from one, of the first byte not yet parsed
+      intptr_t m_line;
+
+      bool read_chunk(const char *&begin, const char *&end);
+
+    public:
+      ndjson_reader(const ndt::type &tp, const source_type &source, size_t chunk_size = 1 << 22,
+                    const eval::eval_context *ectx = &eval::default_eval_context);
+
+      /**
+       * Reads from a file descriptor, which is left open.
+       */
+      ndjson_reader(const ndt::type &tp, int fd, size_t chunk_size = 1 << 22,
+                    const eval::eval_context *ectx = &eval::default_eval_context);
+
+      const ndt::type &get_type() const { return m_tp; }
+
+      /**
+       * Parses the values in the next chunk into ``out`` as an ``N * T``
+       * array, returning false instead once the source is used up.
+       */
+      bool next(array &out);
+
+      /**
+       * Parses all of the values left into a single ``var * T`` array, which
+       * grows by each chunk in turn.
+       */
+      array read_all();
+    };
+
+    /**
+     * Parses newline-delimited JSON held in memory into a ``var * T`` array,
+     * the same way as ``ndjson_reader``.
+     */
+    DYND_API array parse_ndjson(const ndt::type &tp, const char *begin, const char *end,
+                                const eval::eval_context *ectx = &eval::default_eval_context);
+
+    inline array parse_ndjson(const ndt::type &tp, const std::string &str,
+                              const eval::eval_context *ectx = &eval::default_eval_context)
+    {
+      return parse_ndjson(tp, str.data(), str.data() + str.size(), ectx);
+    }
+
   } // namespace dynd::nd::json
 } // namespace dynd::nd
 
+namespace json {
+
+  /**
+   * Finds the structural characters of UTF-8 encoded JSON, which are the
+   * brackets, braces, commas and colons outside of strings and the quotes
+   * that begin and end strings, along with the first character of every
+   * other run of characters outside of strings that are not whitespace, like
+   * a number or ``true``. Their offsets from ``begin`` are appended to
+   * ``out`` in order. The buffer is classified 64 bytes at a time into bit
+   * masks, and the escaped quotes and the insides of strings are found with
+   * carries between the masks rather than a branch per character.
+   *
+   * Returns false if a string has no closing quote, or if the buffer is too
+   * large for 32-bit offsets.
+   */
+  DYND_API bool structural_index(const char *begin, const char *end, std::vector<uint32_t> &out);
+
+} // namespace dynd::json
+
 /**
  * Validates UTF-8 encoded JSON, throwing an exception if it
  * is not valid.
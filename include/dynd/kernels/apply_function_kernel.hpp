@@ -7,6 +7,7 @@
 
 #include <dynd/kernels/apply.hpp>
 #include <dynd/kernels/base_strided_kernel.hpp>
+#include <dynd/kernels/contiguous.hpp>
 
 namespace dynd {
 namespace nd {
@@ -33,6 +34,28 @@ namespace nd {
         void single(char *dst, char *const *DYND_IGNORE_UNUSED(src)) {
           *reinterpret_cast<R *>(dst) = func(apply_arg<A, I>::assign(src[I])..., apply_kwd<K, J>::get()...);
         }
+
+        void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+          typedef std::integral_constant<bool, sizeof...(K) == 0 && nd::detail::is_vectorizable<R, A...>::value>
+              vectorizable;
+          if (vectorizable::value && nd::detail::is_contiguous<R, A...>(dst_stride, src_stride)) {
+            contiguous_strided(dst, src, count, vectorizable());
+            return;
+          }
+
+          base_strided_kernel<apply_function_kernel, sizeof...(A)>::strided(dst, dst_stride, src, src_stride, count);
+        }
+
+        /**
+         * Applies func over packed arrays of builtin arithmetic types through typed pointers,
+         * so the loop is one the compiler can vectorize.
+         */
+        void contiguous_strided(char *dst, char *const *src, size_t count, std::true_type) {
+          nd::detail::contiguous_apply<R, A...>(dst, src, count, [](A... a) { return func(a...); });
+        }
+
+        void contiguous_strided(char *DYND_UNUSED(dst), char *const *DYND_UNUSED(src), size_t DYND_UNUSED(count),
+                                std::false_type) {}
       };
 
       template <typename func_type, func_type func, typename... A, size_t... I, typename... K, size_t... J>
@@ -0,0 +1,130 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <cstring>
+#include <numeric>
+
+#include <dynd/kernels/sort_kernel.hpp>
+
+namespace dynd {
+namespace nd {
+
+  namespace detail {
+
+    /**
+     * Writes the indices that would stably sort ``count`` elements, as ordered
+     * by ``less`` on pairs of indices, to a strided destination. When
+     * ``parallel`` is true, large arrays are sorted across the threads of the
+     * default eval context, which call ``less`` concurrently.
+     */
+    template <typename LessFunc>
+    void argsort_indices(char *dst, intptr_t dst_stride, intptr_t count, bool parallel, const LessFunc &less) {
+      std::vector<intptr_t> buffer;
+      intptr_t *indices = reinterpret_cast<intptr_t *>(dst);
+      if (dst_stride != static_cast<intptr_t>(sizeof(intptr_t))) {
+        buffer.resize(count);
+        indices = buffer.data();
+      }
+
+      std::iota(indices, indices + count, static_cast<intptr_t>(0));
+      if (parallel) {
+        parallel_sort(indices, count,
+                      [&less](intptr_t *data, intptr_t size) { std::stable_sort(data, data + size, less); }, less);
+      } else {
+        std::stable_sort(indices, indices + count, less);
+      }
+
+      if (!buffer.empty()) {
+        for (intptr_t i = 0; i < count; ++i) {
+          *reinterpret_cast<intptr_t *>(dst + i * dst_stride) = buffer[i];
+        }
+      }
+    }
+
+  } // namespace dynd::nd::detail
+
+  /**
+   * Writes the indices that would stably sort a one-dimensional array, as
+   * ordered by the child ``less`` kernel, which is only called from several
+   * threads at once when it is thread-safe.
+   */
+  struct argsort_kernel : base_strided_kernel<argsort_kernel, 1> {
+    const intptr_t dst_stride;
+    const intptr_t src0_size;
+    const intptr_t src0_stride;
+    const bool thread_safe;
+
+    argsort_kernel(intptr_t dst_stride, intptr_t src0_size, intptr_t src0_stride, bool thread_safe)
+        : dst_stride(dst_stride), src0_size(src0_size), src0_stride(src0_stride), thread_safe(thread_safe) {}
+
+    ~argsort_kernel() { get_child()->destroy(); }
+
+    void single(char *dst, char *const *src) {
+      kernel_prefix *child = get_child();
+      char *src0 = src[0];
+      intptr_t src0_stride = this->src0_stride;
+      auto less = [child, src0, src0_stride](intptr_t lhs, intptr_t rhs) {
+        bool1 res;
+        char *child_src[2] = {src0 + lhs * src0_stride, src0 + rhs * src0_stride};
+        child->single(reinterpret_cast<char *>(&res), child_src);
+        return static_cast<bool>(res);
+      };
+      detail::argsort_indices(dst, dst_stride, src0_size, thread_safe, less);
+    }
+  };
+
+  /**
+   * Writes the indices that would stably sort a one-dimensional array of
+   * builtin values or strings, in the same order as ``typed_sort_kernel``, so
+   * that every NaN goes last.
+   */
+  template <typename T>
+  struct typed_argsort_kernel : base_strided_kernel<typed_argsort_kernel<T>, 1> {
+    const intptr_t dst_stride;
+    const intptr_t src0_size;
+    const intptr_t src0_stride;
+
+    typed_argsort_kernel(intptr_t dst_stride, intptr_t src0_size, intptr_t src0_stride)
+        : dst_stride(dst_stride), src0_size(src0_size), src0_stride(src0_stride) {}
+
+    void single(char *dst, char *const *src) {
+      const char *src0 = src[0];
+      intptr_t src0_stride = this->src0_stride;
+      detail::argsort_indices(dst, dst_stride, src0_size, true, [src0, src0_stride](intptr_t lhs, intptr_t rhs) {
+        return detail::total_less(*reinterpret_cast<const T *>(src0 + lhs * src0_stride),
+                                  *reinterpret_cast<const T *>(src0 + rhs * src0_stride));
+      });
+    }
+  };
+
+  /**
+   * Writes the indices that would stably sort a one-dimensional array of
+   * fixed-size values that order as their bytes do, e.g. ASCII or UTF-8
+   * fixed strings.
+   */
+  struct bytes_argsort_kernel : base_strided_kernel<bytes_argsort_kernel, 1> {
+    const intptr_t dst_stride;
+    const intptr_t src0_size;
+    const intptr_t src0_stride;
+    const size_t data_size;
+
+    bytes_argsort_kernel(intptr_t dst_stride, intptr_t src0_size, intptr_t src0_stride, size_t data_size)
+        : dst_stride(dst_stride), src0_size(src0_size), src0_stride(src0_stride), data_size(data_size) {}
+
+    void single(char *dst, char *const *src) {
+      const char *src0 = src[0];
+      intptr_t src0_stride = this->src0_stride;
+      size_t data_size = this->data_size;
+      detail::argsort_indices(dst, dst_stride, src0_size, true,
+                              [src0, src0_stride, data_size](intptr_t lhs, intptr_t rhs) {
+                                return memcmp(src0 + lhs * src0_stride, src0 + rhs * src0_stride, data_size) < 0;
+                              });
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -23,6 +23,8 @@
 #include <dynd/types/fixed_bytes_type.hpp>
 #include <dynd/types/fixed_string_type.hpp>
 #include <dynd/types/option_type.hpp>
+#include <dynd/types/scalar_kind_type.hpp>
+#include <dynd/types/string_view_type.hpp>
 #include <dynd/types/type_id.hpp>
 #include <map>
 
@@ -1056,6 +1058,32 @@ namespace nd {
       }
     };
 
+    template <assign_error_mode ErrorMode>
+    struct assignment_kernel<string, string_view, ErrorMode>
+        : base_strided_kernel<assignment_kernel<string, string_view, ErrorMode>, 1> {
+      void single(char *dst, char *const *src) {
+        const string_view *src_sv = reinterpret_cast<const string_view *>(src[0]);
+        reinterpret_cast<string *>(dst)->assign(src_sv->data(), src_sv->size());
+      }
+    };
+
+    /**
+     * Copies the bytes of a string or string view into the memory block of
+     * the destination view.
+     */
+    template <typename Arg0Type, assign_error_mode ErrorMode>
+    struct assignment_kernel<string_view, Arg0Type, ErrorMode>
+        : base_strided_kernel<assignment_kernel<string_view, Arg0Type, ErrorMode>, 1> {
+      const char *dst_arrmeta;
+
+      assignment_kernel(const char *dst_arrmeta) : dst_arrmeta(dst_arrmeta) {}
+
+      void single(char *dst, char *const *src) {
+        const Arg0Type *src_s = reinterpret_cast<const Arg0Type *>(src[0]);
+        ndt::string_view_type::assign(dst_arrmeta, dst, src_s->data(), src_s->size());
+      }
+    };
+
     template <>
     struct assignment_kernel<bool1, string, assign_error_nocheck>
         : base_strided_kernel<assignment_kernel<bool1, string, assign_error_nocheck>, 1> {
@@ -1414,6 +1442,63 @@ namespace nd {
       }
     };
 
+    /**
+     * Encodes values of the category type as the values of a categorical
+     * type, with a hash table lookup for each and a single call for a whole
+     * strided run.
+     */
+    template <>
+    struct assignment_virtual_kernel<ndt::categorical_type, ndt::scalar_kind_type>
+        : base_strided_kernel<assignment_virtual_kernel<ndt::categorical_type, ndt::scalar_kind_type>, 1> {
+      ndt::type dst_tp;
+      const char *src_arrmeta;
+
+      assignment_virtual_kernel(const ndt::type &dst_tp, const char *src_arrmeta)
+          : dst_tp(dst_tp), src_arrmeta(src_arrmeta) {}
+
+      void single(char *dst, char *const *src) {
+        dst_tp.extended<ndt::categorical_type>()->get_values_from_categories(dst, 0, src_arrmeta, src[0], 0, 1);
+      }
+
+      void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+        dst_tp.extended<ndt::categorical_type>()->get_values_from_categories(dst, dst_stride, src_arrmeta, src[0],
+                                                                             src_stride[0], count);
+      }
+    };
+
+    /**
+     * Decodes the values of a categorical type as their categories, which the
+     * child kernel assigns to the destination.
+     */
+    template <>
+    struct assignment_virtual_kernel<ndt::scalar_kind_type, ndt::categorical_type>
+        : base_strided_kernel<assignment_virtual_kernel<ndt::scalar_kind_type, ndt::categorical_type>, 1> {
+      ndt::type src_tp;
+
+      assignment_virtual_kernel(const ndt::type &src_tp) : src_tp(src_tp) {}
+
+      ~assignment_virtual_kernel() { get_child()->destroy(); }
+
+      void single(char *dst, char *const *src) {
+        const ndt::categorical_type *cd = src_tp.extended<ndt::categorical_type>();
+        uint32_t value;
+        switch (cd->get_storage_type().get_id()) {
+        case uint8_id:
+          value = *reinterpret_cast<const uint8_t *>(src[0]);
+          break;
+        case uint16_id:
+          value = *reinterpret_cast<const uint16_t *>(src[0]);
+          break;
+        default:
+          value = *reinterpret_cast<const uint32_t *>(src[0]);
+          break;
+        }
+
+        char *category = const_cast<char *>(cd->get_category_data_from_value(value));
+        get_child()->single(dst, &category);
+      }
+    };
+
     template <assign_error_mode ErrorMode>
     struct assignment_kernel<ndt::type, string, ErrorMode>
         : base_strided_kernel<assignment_kernel<ndt::type, string, ErrorMode>, 1> {
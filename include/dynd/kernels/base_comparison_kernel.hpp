@@ -0,0 +1,40 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/kernels/base_strided_kernel.hpp>
+#include <dynd/kernels/contiguous.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * The kernel shared by the comparison operators, which writes
+   * ``SelfType::compare(src0, src1)`` to a ``bool1``. Packed arrays of builtin
+   * arithmetic types are compared in a typed loop, and everything else one
+   * element at a time.
+   */
+  template <typename SelfType, typename Arg0Type, typename Arg1Type>
+  struct base_comparison_kernel : base_strided_kernel<SelfType, 2> {
+    void single(char *dst, char *const *src) {
+      *reinterpret_cast<bool1 *>(dst) =
+          SelfType::compare(*reinterpret_cast<Arg0Type *>(src[0]), *reinterpret_cast<Arg1Type *>(src[1]));
+    }
+
+    void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+      if (detail::is_vectorizable<Arg0Type, Arg1Type>::value &&
+          detail::is_contiguous<bool1, Arg0Type, Arg1Type>(dst_stride, src_stride)) {
+        detail::contiguous_apply<bool1, Arg0Type, Arg1Type>(
+            dst, src, count, [](Arg0Type x, Arg1Type y) { return bool1(SelfType::compare(x, y)); });
+        return;
+      }
+
+      base_strided_kernel<SelfType, 2>::strided(dst, dst_stride, src, src_stride, count);
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -5,51 +5,303 @@
 
 #pragma once
 
+#include <algorithm>
+
+#include <dynd/array.hpp>
 #include <dynd/kernels/base_kernel.hpp>
+#include <dynd/kernels/sort_kernel.hpp>
+#include <dynd/types/option_type.hpp>
 
 namespace dynd {
 namespace nd {
 
-  struct binary_search_kernel : base_strided_kernel<binary_search_kernel, 2> {
-    const intptr_t src0_size;
-    const intptr_t src0_stride;
+  /**
+   * Which position a search returns for a needle: the first one it could be
+   * inserted at keeping the array sorted, the last one, or the first one that
+   * holds an equal value and -1 if there is none.
+   */
+  enum search_side { search_left, search_right, search_exact };
 
-    binary_search_kernel(intptr_t src0_size, intptr_t src0_stride) : src0_size(src0_size), src0_stride(src0_stride) {}
+  namespace detail {
+
+    /**
+     * Compares elements of a built-in numeric type inline, in the same order
+     * that ``nd::sort`` sorts them.
+     */
+    template <typename T>
+    struct typed_search_less {
+      static const bool has_child = false;
+
+      typed_search_less(kernel_prefix *DYND_UNUSED(child)) {}
+
+      bool operator()(const char *lhs, const char *rhs) const {
+        return total_less(*reinterpret_cast<const T *>(lhs), *reinterpret_cast<const T *>(rhs));
+      }
+    };
+
+    /**
+     * Compares optional elements of a built-in numeric type like
+     * ``typed_search_less``, with NA after every value and equal to the other
+     * NAs, which is where NaN goes. A floating point NA is a NaN, so for those
+     * the two agree.
+     */
+    template <typename T>
+    struct typed_option_search_less {
+      static const bool has_child = false;
+
+      typed_option_search_less(kernel_prefix *DYND_UNUSED(child)) {}
+
+      bool operator()(const char *lhs, const char *rhs) const {
+        if (!is_avail_builtin(ndt::id_of<T>::value, rhs)) {
+          return is_avail_builtin(ndt::id_of<T>::value, lhs);
+        }
+
+        return is_avail_builtin(ndt::id_of<T>::value, lhs) &&
+               total_less(*reinterpret_cast<const T *>(lhs), *reinterpret_cast<const T *>(rhs));
+      }
+    };
+
+    /**
+     * Compares elements with a child ``less`` kernel.
+     */
+    struct child_search_less {
+      static const bool has_child = true;
+
+      kernel_prefix *child;
+
+      child_search_less(kernel_prefix *child) : child(child) {}
+
+      bool operator()(const char *lhs, const char *rhs) const {
+        bool1 res;
+        char *src[2] = {const_cast<char *>(lhs), const_cast<char *>(rhs)};
+        child->single(reinterpret_cast<char *>(&res), src);
+        return static_cast<bool>(res);
+      }
+    };
+
+    /**
+     * Whether the search for ``needle`` continues past ``probe``.
+     */
+    template <typename LessType>
+    bool search_past(const LessType &less, search_side side, const char *probe, const char *needle) {
+      return (side == search_right) ? !less(needle, probe) : less(probe, needle);
+    }
+
+    /**
+     * Turns the insertion point ``pos`` from a left search into the result for
+     * ``side``, where an exact search wants the value at ``pos`` to be equal.
+     */
+    template <typename LessType>
+    intptr_t search_result(const LessType &less, search_side side, intptr_t pos, intptr_t size, const char *value,
+                           const char *needle) {
+      if (side == search_exact) {
+        return (pos < size && !less(needle, value)) ? pos : -1;
+      }
+
+      return pos;
+    }
 
-    void single(char *dst, char *const *src)
-    {
-      kernel_prefix *child = get_child();
-
-      intptr_t first = 0, last = src0_size;
-      while (first < last) {
-        intptr_t trial = first + (last - first) / 2;
-        char *trial_data = src[0] + trial * src0_stride;
-
-        // In order for the data to always match up with the arrmeta, need to have
-        // trial_data first and data second in the comparison operations.
-        char *src_try0[2] = {src[1], trial_data};
-        char *src_try1[2] = {trial_data, src[1]};
-        int child_dst0;
-        child->single(reinterpret_cast<char *>(&child_dst0), src_try0);
-        if (child_dst0) {
-          // value < arr[trial]
-          last = trial;
+    /**
+     * Searches a sorted array for ``count`` needles, each a ``needle_stride``
+     * apart, writing each result ``dst_stride`` apart. Every probe is a single
+     * comparison which moves the base of the range without a branch, and the
+     * range shrinks the same way for every needle, so a group of needles is
+     * searched in lockstep. The next probes of the whole group are prefetched
+     * before the current ones are compared, which overlaps their cache misses.
+     */
+    template <typename LessType>
+    void search_sorted(const LessType &less, search_side side, const char *data, intptr_t size, intptr_t stride,
+                       const char *needles, intptr_t needle_stride, intptr_t count, char *dst, intptr_t dst_stride) {
+      static const intptr_t group_size = 8;
+
+      intptr_t base[group_size];
+      for (intptr_t first = 0; first < count; first += group_size) {
+        intptr_t group_count = std::min(group_size, count - first);
+        const char *group_needles = needles + first * needle_stride;
+        char *group_dst = dst + first * dst_stride;
+
+        if (size == 0) {
+          for (intptr_t j = 0; j < group_count; ++j) {
+            *reinterpret_cast<intptr_t *>(group_dst + j * dst_stride) = (side == search_exact) ? -1 : 0;
+          }
+          continue;
         }
-        else {
-          int child_dst1;
-          child->single(reinterpret_cast<char *>(&child_dst1), src_try1);
-          if (child_dst1) {
-            // value > arr[trial]
-            first = trial + 1;
+
+        std::fill(base, base + group_count, static_cast<intptr_t>(0));
+        for (intptr_t n = size; n > 1;) {
+          intptr_t half = n / 2;
+          for (intptr_t j = 0; j < group_count; ++j) {
+            DYND_PREFETCH(data + (base[j] + half / 2) * stride);
+            DYND_PREFETCH(data + (base[j] + half + half / 2) * stride);
           }
-          else {
-            *reinterpret_cast<intptr_t *>(dst) = trial;
-            return;
+          for (intptr_t j = 0; j < group_count; ++j) {
+            base[j] += search_past(less, side, data + (base[j] + half) * stride, group_needles + j * needle_stride)
+                           ? half
+                           : 0;
           }
+          n -= half;
+        }
+
+        for (intptr_t j = 0; j < group_count; ++j) {
+          const char *needle = group_needles + j * needle_stride;
+          intptr_t pos = base[j] + (search_past(less, side, data + base[j] * stride, needle) ? 1 : 0);
+          *reinterpret_cast<intptr_t *>(group_dst + j * dst_stride) =
+              search_result(less, side, pos, size, data + pos * stride, needle);
         }
       }
+    }
+
+    /**
+     * The number of nodes in the subtree of the one-based Eytzinger node
+     * ``k``, in a tree of ``size`` nodes.
+     */
+    inline intptr_t eytzinger_subtree_size(intptr_t k, intptr_t size) {
+      intptr_t res = 0;
+      for (intptr_t first = k, last = k; first <= size; first = 2 * first, last = 2 * last + 1) {
+        res += std::min(last, size) - first + 1;
+      }
+
+      return res;
+    }
+
+    /**
+     * The position in sorted order of the one-based Eytzinger node ``k``, or
+     * ``size`` when ``k`` is zero, meaning past the end.
+     */
+    inline intptr_t eytzinger_rank(intptr_t k, intptr_t size) {
+      if (k == 0) {
+        return size;
+      }
 
-      *reinterpret_cast<intptr_t *>(dst) = -1;
+      intptr_t res = eytzinger_subtree_size(2 * k, size);
+      for (; k > 1; k /= 2) {
+        if (k % 2 == 1) {
+          res += eytzinger_subtree_size(k - 1, size) + 1;
+        }
+      }
+
+      return res;
+    }
+
+    /**
+     * Like ``search_sorted``, for an array in the Eytzinger layout made by
+     * ``nd::eytzinger``, where the children of the node at zero-based index
+     * ``i`` are at ``2 i + 1`` and ``2 i + 2``. The nodes four levels down
+     * share a few cache lines and are prefetched together, and the results
+     * are positions in sorted order.
+     */
+    template <typename LessType>
+    void search_eytzinger(const LessType &less, search_side side, const char *data, intptr_t size, intptr_t stride,
+                          const char *needles, intptr_t needle_stride, intptr_t count, char *dst,
+                          intptr_t dst_stride) {
+      for (intptr_t j = 0; j < count; ++j) {
+        const char *needle = needles + j * needle_stride;
+
+        // One-based node indices, so that the children of k are 2 k and 2 k + 1
+        intptr_t k = 1;
+        while (k <= size) {
+          // Clamped, so that the last levels do not point past the array
+          DYND_PREFETCH(data + (std::min(16 * k, size) - 1) * stride);
+          k = 2 * k + (search_past(less, side, data + (k - 1) * stride, needle) ? 1 : 0);
+        }
+
+        // Backs up past the right turns to the last node the search went left
+        // at, which is the first one it did not continue past
+        while (k % 2 == 1) {
+          k /= 2;
+        }
+        k /= 2;
+
+        *reinterpret_cast<intptr_t *>(dst + j * dst_stride) =
+            search_result(less, side, eytzinger_rank(k, size), size, (k == 0) ? nullptr : data + (k - 1) * stride,
+                          needle);
+      }
+    }
+
+  } // namespace dynd::nd::detail
+
+  /**
+   * Searches the first dimension of a sorted array for a single value, and
+   * returns the first index holding an equal value or -1.
+   */
+  template <typename LessType>
+  struct binary_search_kernel : base_strided_kernel<binary_search_kernel<LessType>, 2> {
+    const intptr_t src0_size;
+    const intptr_t src0_stride;
+
+    binary_search_kernel(intptr_t src0_size, intptr_t src0_stride) : src0_size(src0_size), src0_stride(src0_stride) {}
+
+    ~binary_search_kernel() {
+      if (LessType::has_child) {
+        this->get_child()->destroy();
+      }
+    }
+
+    void single(char *dst, char *const *src) {
+      detail::search_sorted(LessType(this->get_child()), search_exact, src[0], src0_size, src0_stride, src[1], 0, 1,
+                            dst, 0);
+    }
+  };
+
+  /**
+   * Assigns the needles of a search to a buffer of the element type of the
+   * array searched, and then searches for them there. The first child kernel
+   * is the search, and the second the assignment.
+   */
+  struct search_convert_kernel : base_strided_kernel<search_convert_kernel, 2> {
+    intptr_t convert_offset;
+    array buffer;
+
+    search_convert_kernel(const array &buffer) : convert_offset(0), buffer(buffer) {}
+
+    ~search_convert_kernel() {
+      get_child()->destroy();
+      get_child(convert_offset)->destroy();
+    }
+
+    void single(char *dst, char *const *src) {
+      char *buffer_data = buffer.data();
+      get_child(convert_offset)->single(buffer_data, src + 1);
+
+      char *search_src[2] = {src[0], buffer_data};
+      get_child()->single(dst, search_src);
+    }
+  };
+
+  /**
+   * Searches the first dimension of a sorted array, or one in the Eytzinger
+   * layout, for every value of a one-dimensional array of needles.
+   */
+  template <typename LessType>
+  struct searchsorted_kernel : base_strided_kernel<searchsorted_kernel<LessType>, 2> {
+    const search_side side;
+    const bool eytzinger;
+    const intptr_t dst_stride;
+    const intptr_t src0_size;
+    const intptr_t src0_stride;
+    const intptr_t src1_size;
+    const intptr_t src1_stride;
+
+    searchsorted_kernel(search_side side, bool eytzinger, intptr_t dst_stride, intptr_t src0_size, intptr_t src0_stride,
+                        intptr_t src1_size, intptr_t src1_stride)
+        : side(side), eytzinger(eytzinger), dst_stride(dst_stride), src0_size(src0_size), src0_stride(src0_stride),
+          src1_size(src1_size), src1_stride(src1_stride) {}
+
+    ~searchsorted_kernel() {
+      if (LessType::has_child) {
+        this->get_child()->destroy();
+      }
+    }
+
+    void single(char *dst, char *const *src) {
+      LessType less(this->get_child());
+      if (eytzinger) {
+        detail::search_eytzinger(less, side, src[0], src0_size, src0_stride, src[1], src1_stride, src1_size, dst,
+                                 dst_stride);
+      } else {
+        detail::search_sorted(less, side, src[0], src0_size, src0_stride, src[1], src1_stride, src1_size, dst,
+                              dst_stride);
+      }
     }
   };
 
@@ -5,7 +5,9 @@
 
 #pragma once
 
-#include <dynd/arrmeta_holder.hpp>
+#include <cstddef>
+#include <memory>
+
 #include <dynd/callable.hpp>
 #include <dynd/kernels/base_kernel.hpp>
 #include <dynd/kernels/convert_kernel.hpp>
@@ -15,36 +17,66 @@ namespace nd {
   namespace functional {
 
     /**
-     * A kernel for chaining two other kernels, using temporary buffers
-     * dynamically allocated on the heap.
+     * A kernel for chaining two other kernels, through an intermediate buffer
+     * of up to DYND_BUFFER_CHUNK_SIZE elements.
+     *
+     * When the buffer type is plain data that fits in ``local_buffer_size``,
+     * the buffer is on the stack of each call, so that several threads can
+     * run the same kernel over different chunks at once. Otherwise the one
+     * allocated with the kernel is reused, and its arrmeta and contents are
+     * reset after every chunk when they need to be.
      */
     // All methods are inlined, so this does not need to be declared DYND_API.
     struct compose_kernel : base_strided_kernel<compose_kernel, 1> {
+      static const size_t local_buffer_size = DYND_BUFFER_CHUNK_SIZE * 16;
+
       intptr_t second_offset; // The offset to the second child kernel
-      ndt::type buffer_tp;
-      arrmeta_holder buffer_arrmeta;
-      std::vector<intptr_t> buffer_shape;
-
-      compose_kernel(const ndt::type &buffer_tp) : buffer_tp(buffer_tp)
-      {
-        arrmeta_holder(this->buffer_tp).swap(buffer_arrmeta);
-        buffer_arrmeta.arrmeta_default_construct(true);
-        buffer_shape.push_back(DYND_BUFFER_CHUNK_SIZE);
+      buffer_storage buffer;
+      uint32_t buffer_flags;
+
+      compose_kernel(const ndt::type &buffer_tp) : buffer(buffer_tp), buffer_flags(buffer_tp.get_flags()) {
+        if (buffer_flags & (type_flag_blockref | type_flag_zeroinit | type_flag_destructor)) {
+          memset(buffer.get_storage(), 0, DYND_BUFFER_CHUNK_SIZE * buffer.get_stride());
+        }
       }
 
-      ~compose_kernel()
-      {
+      ~compose_kernel() {
         // The first child ckernel
         get_child()->destroy();
         // The second child ckernel
         get_child(second_offset)->destroy();
       }
 
-      void single(char *dst, char *const *src)
-      {
-        // Allocate a temporary buffer on the heap
-        array buffer = empty(buffer_tp);
-        char *buffer_data = buffer.data();
+      /**
+       * Releases whatever the first child left in the first ``count`` elements
+       * of the buffer, so that it can be used again.
+       */
+      void reset_buffer(size_t count) {
+        if (buffer_flags & type_flag_destructor) {
+          buffer.get_type().extended()->data_destruct_strided(buffer.get_arrmeta(), buffer.get_storage(),
+                                                              buffer.get_stride(), count);
+        }
+        if (buffer_flags & (type_flag_blockref | type_flag_zeroinit | type_flag_destructor)) {
+          memset(buffer.get_storage(), 0, count * buffer.get_stride());
+          buffer.reset_arrmeta();
+        }
+      }
+
+      /**
+       * Returns true when each call can keep its buffer on the stack.
+       */
+      static bool is_local_buffer(const ndt::type &buffer_tp) {
+        return (buffer_tp.get_flags() & (type_flag_blockref | type_flag_zeroinit | type_flag_destructor)) == 0 &&
+               buffer_tp.get_data_size() <= local_buffer_size;
+      }
+
+      void single(char *dst, char *const *src) {
+        alignas(std::max_align_t) char local_buffer[local_buffer_size];
+
+        char *buffer_data = buffer.get_storage();
+        if (is_local_buffer(buffer.get_type())) {
+          buffer_data = local_buffer;
+        }
 
         kernel_prefix *first = get_child();
         kernel_single_t first_func = first->get_function<kernel_single_t>();
@@ -54,14 +86,21 @@ namespace nd {
 
         first_func(first, buffer_data, src);
         second_func(second, dst, &buffer_data);
+        reset_buffer(1);
       }
 
-      void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count)
-      {
-        // Allocate a temporary buffer on the heap
-        array buffer = empty(buffer_shape[0], buffer_tp);
-        char *buffer_data = buffer.data();
-        intptr_t buffer_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(buffer.get()->metadata())->stride;
+      void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+        alignas(std::max_align_t) char local_buffer[local_buffer_size];
+
+        char *buffer_data = buffer.get_storage();
+        intptr_t buffer_stride = buffer.get_stride();
+        size_t max_chunk_size = DYND_BUFFER_CHUNK_SIZE;
+        if (is_local_buffer(buffer.get_type())) {
+          buffer_data = local_buffer;
+          if (buffer_stride != 0) {
+            max_chunk_size = std::min(max_chunk_size, local_buffer_size / buffer_stride);
+          }
+        }
 
         kernel_prefix *first = get_child();
         kernel_strided_t first_func = first->get_function<kernel_strided_t>();
@@ -72,17 +111,14 @@ namespace nd {
         char *src0 = src[0];
         intptr_t src0_stride = src_stride[0];
 
-        size_t chunk_size = std::min(count, static_cast<size_t>(DYND_BUFFER_CHUNK_SIZE));
-        first_func(first, buffer_data, buffer_stride, &src0, src_stride, chunk_size);
-        second_func(second, dst, dst_stride, &buffer_data, &buffer_stride, chunk_size);
-        count -= chunk_size;
         while (count) {
-          src0 += chunk_size * src0_stride;
-          dst += chunk_size * dst_stride;
-          reset_strided_buffer_array(buffer);
-          chunk_size = std::min(count, static_cast<size_t>(DYND_BUFFER_CHUNK_SIZE));
+          size_t chunk_size = std::min(count, max_chunk_size);
           first_func(first, buffer_data, buffer_stride, &src0, src_stride, chunk_size);
           second_func(second, dst, dst_stride, &buffer_data, &buffer_stride, chunk_size);
+          reset_buffer(chunk_size);
+
+          src0 += chunk_size * src0_stride;
+          dst += chunk_size * dst_stride;
           count -= chunk_size;
         }
       }
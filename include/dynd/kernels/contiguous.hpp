@@ -0,0 +1,140 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <dynd/config.hpp>
+#include <dynd/cpu_features.hpp>
+
+namespace dynd {
+namespace nd {
+  namespace detail {
+
+    /**
+     * Whether every one of the types is a builtin C++ arithmetic type, for
+     * which a plain loop over typed pointers is something the compiler knows
+     * how to vectorize.
+     */
+    template <typename... Types>
+    struct is_vectorizable;
+
+    template <>
+    struct is_vectorizable<> : std::true_type {};
+
+    template <typename Type0, typename... Types>
+    struct is_vectorizable<Type0, Types...>
+        : std::integral_constant<bool, std::is_arithmetic<Type0>::value && is_vectorizable<Types...>::value> {};
+
+    /**
+     * Returns true when the destination and all the sources of a strided call
+     * are packed arrays of their element types.
+     */
+    template <typename DstType, typename... SrcTypes>
+    bool is_contiguous(intptr_t dst_stride, const intptr_t *src_stride) {
+      const intptr_t src_size[sizeof...(SrcTypes) + 1] = {static_cast<intptr_t>(sizeof(SrcTypes))...};
+      for (size_t i = 0; i < sizeof...(SrcTypes); ++i) {
+        if (src_stride[i] != src_size[i]) {
+          return false;
+        }
+      }
+
+      return dst_stride == static_cast<intptr_t>(sizeof(DstType));
+    }
+
+#define DYND_DEF_CONTIGUOUS_LOOPS(NAME, TARGET)                                                                        \
+  template <typename DstType, typename... SrcTypes, size_t... I, typename FuncType>                                    \
+  TARGET void NAME##_apply(char *dst, char *const *src, size_t count, std::index_sequence<I...>, FuncType f) {         \
+    DstType *dst0 = reinterpret_cast<DstType *>(dst);                                                                  \
+    std::tuple<const SrcTypes *...> src0(reinterpret_cast<const SrcTypes *>(src[I])...);                               \
+    (void)src0; /* Unused when there are no sources */                                                                 \
+    for (size_t i = 0; i < count; ++i) {                                                                               \
+      dst0[i] = f(std::get<I>(src0)[i]...);                                                                            \
+    }                                                                                                                  \
+  }                                                                                                                    \
+                                                                                                                       \
+  template <size_t NAccum, typename DstType, typename Arg0Type, typename FuncType>                                     \
+  TARGET void NAME##_accumulate(DstType &dst, DstType init, const char *src, size_t count, FuncType f) {               \
+    const Arg0Type *src0 = reinterpret_cast<const Arg0Type *>(src);                                                    \
+    DstType accum[NAccum];                                                                                             \
+    for (size_t j = 0; j < NAccum; ++j) {                                                                              \
+      accum[j] = init;                                                                                                 \
+    }                                                                                                                  \
+                                                                                                                       \
+    size_t i = 0;                                                                                                      \
+    for (; i + NAccum <= count; i += NAccum) {                                                                         \
+      for (size_t j = 0; j < NAccum; ++j) {                                                                            \
+        accum[j] = f(accum[j], src0[i + j]);                                                                           \
+      }                                                                                                                \
+    }                                                                                                                  \
+    for (; i < count; ++i) {                                                                                           \
+      accum[0] = f(accum[0], src0[i]);                                                                                 \
+    }                                                                                                                  \
+                                                                                                                       \
+    for (size_t j = 0; j < NAccum; ++j) {                                                                              \
+      dst = f(dst, accum[j]);                                                                                          \
+    }                                                                                                                  \
+  }
+
+    // One copy of the loops for each instruction set they are specialized
+    // for, picked at runtime according to cpu_features()
+    DYND_DEF_CONTIGUOUS_LOOPS(baseline, )
+    DYND_DEF_CONTIGUOUS_LOOPS(avx2, DYND_TARGET("avx2"))
+    DYND_DEF_CONTIGUOUS_LOOPS(avx512, DYND_TARGET("avx512f"))
+
+#undef DYND_DEF_CONTIGUOUS_LOOPS
+
+    /**
+     * Loops over packed arrays, assigning ``f(src0[i], src1[i], ...)`` to
+     * ``dst[i]``.
+     */
+    template <typename DstType, typename... SrcTypes, typename FuncType>
+    void contiguous_apply(char *dst, char *const *src, size_t count, FuncType f) {
+      typedef std::make_index_sequence<sizeof...(SrcTypes)> indices;
+
+#ifdef DYND_ISA_DISPATCH
+      if (cpu_supports(cpu_feature_avx512f)) {
+        avx512_apply<DstType, SrcTypes...>(dst, src, count, indices(), f);
+        return;
+      }
+      if (cpu_supports(cpu_feature_avx2)) {
+        avx2_apply<DstType, SrcTypes...>(dst, src, count, indices(), f);
+        return;
+      }
+#endif
+
+      baseline_apply<DstType, SrcTypes...>(dst, src, count, indices(), f);
+    }
+
+    /**
+     * Folds a packed array into ``dst`` with ``f(acc, src0[i])``, keeping
+     * several independent accumulators so that consecutive iterations don't
+     * wait on each other. Each accumulator starts from ``init``, which must be
+     * the identity of ``f`` or the current value of ``dst`` when ``f`` is
+     * idempotent, and they are merged into ``dst`` with ``f`` at the end.
+     */
+    template <typename DstType, typename Arg0Type, typename FuncType>
+    void contiguous_accumulate(DstType &dst, DstType init, const char *src, size_t count, FuncType f) {
+#ifdef DYND_ISA_DISPATCH
+      // Two registers' worth of accumulators for the wider vectors
+      if (cpu_supports(cpu_feature_avx512f)) {
+        avx512_accumulate<128 / sizeof(DstType), DstType, Arg0Type>(dst, init, src, count, f);
+        return;
+      }
+      if (cpu_supports(cpu_feature_avx2)) {
+        avx2_accumulate<64 / sizeof(DstType), DstType, Arg0Type>(dst, init, src, count, f);
+        return;
+      }
+#endif
+
+      baseline_accumulate<8, DstType, Arg0Type>(dst, init, src, count, f);
+    }
+
+  } // namespace dynd::nd::detail
+} // namespace dynd::nd
+} // namespace dynd
@@ -7,6 +7,7 @@
 
 #include <dynd/callable.hpp>
 #include <dynd/kernels/base_kernel.hpp>
+#include <dynd/parallel.hpp>
 
 namespace dynd {
 namespace nd {
@@ -30,9 +31,10 @@ namespace nd {
 
       intptr_t m_size;
       intptr_t m_dst_stride, m_src_stride[N];
+      bool m_parallel;
 
-      elwise_kernel(char *data, intptr_t size, intptr_t dst_stride, const intptr_t *src_stride)
-          : TraitsType(data), m_size(size), m_dst_stride(dst_stride) {
+      elwise_kernel(char *data, intptr_t size, intptr_t dst_stride, const intptr_t *src_stride, bool parallel)
+          : TraitsType(data), m_size(size), m_dst_stride(dst_stride), m_parallel(parallel) {
         memcpy(m_src_stride, src_stride, sizeof(m_src_stride));
       }
 
@@ -42,7 +44,20 @@ namespace nd {
         kernel_prefix *child = this->get_child();
         kernel_strided_t opchild = child->get_function<kernel_strided_t>();
 
-        opchild(child, dst, m_dst_stride, src, m_src_stride, m_size);
+        if (!m_parallel) {
+          opchild(child, dst, m_dst_stride, src, m_src_stride, m_size);
+          return;
+        }
+
+        // Each chunk of the outer dimension is an independent strided call of the child
+        parallel_for(m_size, [&](size_t begin, size_t end) {
+          char *src_begin[N];
+          for (size_t i = 0; i < N; ++i) {
+            src_begin[i] = src[i] + static_cast<intptr_t>(begin) * m_src_stride[i];
+          }
+          opchild(child, dst + static_cast<intptr_t>(begin) * m_dst_stride, m_dst_stride, src_begin, m_src_stride,
+                  end - begin);
+        });
       }
     };
 
@@ -54,7 +69,8 @@ namespace nd {
       intptr_t m_size;
       intptr_t m_dst_stride;
 
-      elwise_kernel(char *data, intptr_t size, intptr_t dst_stride, const intptr_t *DYND_UNUSED(src_stride))
+      elwise_kernel(char *data, intptr_t size, intptr_t dst_stride, const intptr_t *DYND_UNUSED(src_stride),
+                    bool DYND_UNUSED(parallel))
           : TraitsType(data), m_size(size), m_dst_stride(dst_stride) {}
 
       ~elwise_kernel() { this->get_child()->destroy(); }
@@ -6,26 +6,25 @@
 #pragma once
 
 #include <dynd/kernels/base_kernel.hpp>
+#include <dynd/kernels/base_comparison_kernel.hpp>
 #include <dynd/types/callable_type.hpp>
 
 namespace dynd {
 namespace nd {
 
   template <typename Arg0Type, typename Arg1Type>
-  struct equal_kernel : base_strided_kernel<equal_kernel<Arg0Type, Arg1Type>, 2> {
-    typedef typename std::common_type<Arg0Type, Arg1Type>::type T;
+  struct equal_kernel : base_comparison_kernel<equal_kernel<Arg0Type, Arg1Type>, Arg0Type, Arg1Type> {
+    typedef typename std::common_type<Arg0Type, Arg1Type>::type common_type;
 
-    void single(char *dst, char *const *src) {
-      *reinterpret_cast<bool1 *>(dst) = static_cast<T>(*reinterpret_cast<Arg0Type *>(src[0])) ==
-                                        static_cast<T>(*reinterpret_cast<Arg1Type *>(src[1]));
+    static bool compare(const Arg0Type &lhs, const Arg1Type &rhs) {
+      return static_cast<common_type>(lhs) == static_cast<common_type>(rhs);
     }
   };
 
   template <typename Arg0Type>
-  struct equal_kernel<Arg0Type, Arg0Type> : base_strided_kernel<equal_kernel<Arg0Type, Arg0Type>, 2> {
-    void single(char *dst, char *const *src) {
-      *reinterpret_cast<bool1 *>(dst) = *reinterpret_cast<Arg0Type *>(src[0]) == *reinterpret_cast<Arg0Type *>(src[1]);
-    }
+  struct equal_kernel<Arg0Type, Arg0Type>
+      : base_comparison_kernel<equal_kernel<Arg0Type, Arg0Type>, Arg0Type, Arg0Type> {
+    static bool compare(const Arg0Type &lhs, const Arg0Type &rhs) { return lhs == rhs; }
   };
 
   template <>
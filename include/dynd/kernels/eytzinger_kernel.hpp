@@ -0,0 +1,51 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/kernels/base_strided_kernel.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * Copies a sorted one-dimensional array of plain old data into the Eytzinger
+   * layout, which stores a binary search tree breadth first. Searches visit
+   * the top levels of the tree often enough for them to stay in cache, and the
+   * nodes a few levels below any node are close together.
+   */
+  struct eytzinger_kernel : base_strided_kernel<eytzinger_kernel, 1> {
+    const intptr_t dst_stride;
+    const intptr_t src0_size;
+    const intptr_t src0_stride;
+    const size_t data_size;
+
+    eytzinger_kernel(intptr_t dst_stride, intptr_t src0_size, intptr_t src0_stride, size_t data_size)
+        : dst_stride(dst_stride), src0_size(src0_size), src0_stride(src0_stride), data_size(data_size) {}
+
+    void single(char *dst, char *const *src) {
+      intptr_t i = 0;
+      fill(dst, src[0], 1, i);
+    }
+
+  private:
+    /**
+     * Fills the subtree of the one-based node ``k`` in order, from the sorted
+     * values starting at ``i``.
+     */
+    void fill(char *dst, const char *src0, intptr_t k, intptr_t &i) {
+      if (k > src0_size) {
+        return;
+      }
+
+      fill(dst, src0, 2 * k, i);
+      memcpy(dst + (k - 1) * dst_stride, src0 + i * src0_stride, data_size);
+      ++i;
+      fill(dst, src0, 2 * k + 1, i);
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
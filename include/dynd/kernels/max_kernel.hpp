@@ -6,6 +6,7 @@
 #pragma once
 
 #include <dynd/kernels/base_kernel.hpp>
+#include <dynd/kernels/contiguous.hpp>
 #include <dynd/kernels/base_strided_kernel.hpp>
 #include <dynd/types/callable_type.hpp>
 
@@ -23,6 +24,25 @@ namespace nd {
     }
 
     void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+      if (detail::is_vectorizable<dst_type, Arg0Type>::value &&
+          src_stride[0] == static_cast<intptr_t>(sizeof(Arg0Type))) {
+        if (dst_stride == 0) {
+          // Taking the current value as the initial one is fine, as max is idempotent
+          dst_type &res = *reinterpret_cast<dst_type *>(dst);
+          detail::contiguous_accumulate<dst_type, Arg0Type>(res, res, src[0], count, [](dst_type x, Arg0Type y) {
+            return y > x ? static_cast<dst_type>(y) : x;
+          });
+          return;
+        }
+        if (dst_stride == static_cast<intptr_t>(sizeof(dst_type))) {
+          char *const src_with_dst[2] = {dst, src[0]};
+          detail::contiguous_apply<dst_type, dst_type, Arg0Type>(dst, src_with_dst, count, [](dst_type x, Arg0Type y) {
+            return y > x ? static_cast<dst_type>(y) : x;
+          });
+          return;
+        }
+      }
+
       char *src0 = src[0];
       intptr_t src0_stride = src_stride[0];
       for (size_t i = 0; i < count; ++i) {
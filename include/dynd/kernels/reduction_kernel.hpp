@@ -5,17 +5,62 @@
 
 #pragma once
 
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include <dynd/assignment.hpp>
 #include <dynd/callable.hpp>
 #include <dynd/functional.hpp>
 #include <dynd/kernels/base_kernel.hpp>
 #include <dynd/kernels/constant_kernel.hpp>
 #include <dynd/kernels/reduction_kernel_prefix.hpp>
+#include <dynd/parallel.hpp>
 
 namespace dynd {
 namespace nd {
   namespace functional {
 
+    /**
+     * Reduces [0, size) into ``dst`` by splitting it into chunks across threads.
+     * ``reduce(acc, begin, end)`` must initialize ``acc`` and reduce the chunk
+     * [begin, end) into it. Each chunk gets a private accumulator of
+     * ``accum_size`` bytes, and once all of them are done the partial results
+     * are merged into ``dst`` in order with the single ``combine`` kernel.
+     *
+     * When ``first`` is true ``dst`` holds no value yet, and the chunk starting
+     * at zero is reduced into it directly.
+     */
+    template <typename FuncType>
+    void parallel_reduce(kernel_prefix *combine, size_t accum_size, char *dst, bool first, size_t size,
+                         FuncType &&reduce) {
+      std::mutex partials_mutex;
+      std::vector<std::pair<size_t, std::unique_ptr<char[]>>> partials;
+      parallel_for(size, [&](size_t begin, size_t end) {
+        if (first && begin == 0) {
+          // Nothing else touches dst until the partial results are combined
+          reduce(dst, begin, end);
+          return;
+        }
+
+        std::unique_ptr<char[]> acc(new char[accum_size]);
+        reduce(acc.get(), begin, end);
+
+        std::lock_guard<std::mutex> lock(partials_mutex);
+        partials.emplace_back(begin, std::move(acc));
+      });
+
+      // Combine in a fixed order so the result doesn't depend on scheduling
+      std::sort(partials.begin(), partials.end(),
+                [](const std::pair<size_t, std::unique_ptr<char[]>> &lhs,
+                   const std::pair<size_t, std::unique_ptr<char[]>> &rhs) { return lhs.first < rhs.first; });
+      for (const auto &partial : partials) {
+        char *src = partial.second.get();
+        combine->single(dst, &src);
+      }
+    }
+
     template <typename SelfType, size_t NArg>
     struct base_reduction_kernel : reduction_kernel_prefix {
       /**
@@ -105,6 +150,8 @@ namespace nd {
      *  - The child first_call function must be *single*.
      *  - The child followup_call function must be *strided*.
      *
+     * When every dimension after this one is reduced too, a *single* combine
+     * kernel at combine_offset lets the dimension be split across threads.
      */
     template <typename Arg0Type, bool Broadcast, bool Inner, size_t NArg>
     struct reduction_kernel;
@@ -114,17 +161,50 @@ namespace nd {
         : base_reduction_kernel<reduction_kernel<ndt::fixed_dim_type, false, false, NArg>, NArg> {
       intptr_t src0_element_size;
       intptr_t src_element_stride[NArg];
+      intptr_t combine_offset;
+      size_t accum_size;
 
       reduction_kernel(std::intptr_t src0_element_size, const char *const *src_arrmeta)
-          : src0_element_size(src0_element_size) {
+          : src0_element_size(src0_element_size), combine_offset(0), accum_size(0) {
         for (size_t j = 0; j < NArg; ++j) {
           src_element_stride[j] = reinterpret_cast<const size_stride_t *>(src_arrmeta[j])->stride;
         }
       }
 
-      ~reduction_kernel() { this->get_child()->destroy(); }
+      ~reduction_kernel() {
+        this->get_child()->destroy();
+        if (combine_offset != 0) {
+          this->get_child(combine_offset)->destroy();
+        }
+      }
+
+      bool is_parallel() const { return combine_offset != 0 && runs_in_parallel(src0_element_size); }
+
+      void reduce_in_parallel(char *dst, char *const *src, bool first) {
+        reduction_kernel_prefix *child = this->get_reduction_child();
+        parallel_reduce(this->get_child(combine_offset), accum_size, dst, first, src0_element_size,
+                        [&](char *acc, size_t begin, size_t end) {
+                          char *child_src[NArg];
+                          for (size_t j = 0; j < NArg; ++j) {
+                            child_src[j] = src[j] + static_cast<intptr_t>(begin) * src_element_stride[j];
+                          }
+
+                          child->single_first(acc, child_src);
+                          if (end - begin > 1) {
+                            for (size_t j = 0; j < NArg; ++j) {
+                              child_src[j] += src_element_stride[j];
+                            }
+                            child->strided_followup(acc, 0, child_src, src_element_stride, end - begin - 1);
+                          }
+                        });
+      }
 
       void single_first(char *dst, char *const *src) {
+        if (is_parallel()) {
+          reduce_in_parallel(dst, src, true);
+          return;
+        }
+
         reduction_kernel_prefix *child = this->get_reduction_child();
         // The first call at the "dst" address
         child->single_first(dst, src);
@@ -147,7 +227,15 @@ namespace nd {
           child_src[i] = src[i];
         }
 
-        if (dst_stride == 0) {
+        if (is_parallel()) {
+          for (size_t i = 0; i != count; ++i) {
+            reduce_in_parallel(dst, child_src, dst_stride != 0 || i == 0);
+            dst += dst_stride;
+            for (size_t j = 0; j < NArg; ++j) {
+              child_src[j] += src_stride[j];
+            }
+          }
+        } else if (dst_stride == 0) {
           // With a zero stride, we have one "first", followed by many
           // "followup" calls
           child->single_first(dst, child_src);
@@ -196,8 +284,13 @@ namespace nd {
           child_src[i] = src[i];
         }
 
+        bool parallel = is_parallel();
         for (size_t i = 0; i != count; ++i) {
-          child->strided_followup(dst, 0, child_src, src_element_stride, src0_element_size);
+          if (parallel) {
+            reduce_in_parallel(dst, child_src, false);
+          } else {
+            child->strided_followup(dst, 0, child_src, src_element_stride, src0_element_size);
+          }
 
           dst += dst_stride;
           for (size_t j = 0; j < NArg; ++j) {
@@ -219,6 +312,8 @@ namespace nd {
      *  - The child destination initialization kernel must be *single*.
      *  - The child reduction kernel must be *strided*.
      *
+     * An optional *single* combine kernel at combine_offset lets the dimension
+     * be split across threads.
      */
     template <size_t NArg>
     struct reduction_kernel<ndt::fixed_dim_type, false, true, NArg>
@@ -229,13 +324,42 @@ namespace nd {
       intptr_t _size;
       intptr_t src_stride[NArg];
       size_t init_offset;
+      intptr_t combine_offset;
+      size_t accum_size;
+
+      reduction_kernel() : combine_offset(0), accum_size(0) {}
 
       ~reduction_kernel() {
         this->get_child()->destroy();
         this->get_child(init_offset)->destroy();
+        if (combine_offset != 0) {
+          this->get_child(combine_offset)->destroy();
+        }
+      }
+
+      bool is_parallel() const { return combine_offset != 0 && runs_in_parallel(_size); }
+
+      void reduce_in_parallel(char *dst, char *const *src, bool first) {
+        kernel_prefix *init_child = this->get_child(init_offset);
+        kernel_prefix *reduction_child = this->get_child();
+        parallel_reduce(this->get_child(combine_offset), accum_size, dst, first, _size,
+                        [&](char *acc, size_t begin, size_t end) {
+                          char *child_src[NArg];
+                          for (size_t j = 0; j < NArg; ++j) {
+                            child_src[j] = src[j] + static_cast<intptr_t>(begin) * this->src_stride[j];
+                          }
+
+                          init_child->single(acc, child_src);
+                          reduction_child->strided(acc, 0, child_src, this->src_stride, end - begin);
+                        });
       }
 
       void single_first(char *dst, char *const *src) {
+        if (is_parallel()) {
+          reduce_in_parallel(dst, src, true);
+          return;
+        }
+
         char *child_src[NArg];
         for (size_t i = 0; i < NArg; ++i) {
           child_src[i] = src[i];
@@ -273,6 +397,15 @@ namespace nd {
           for (std::size_t i = 1; i != count; ++i) {
             reduction_child->strided(dst, 0, child_src, this->src_stride, size_first);
 
+            dst += dst_stride;
+            for (size_t j = 0; j < NArg; ++j) {
+              child_src[j] += src_stride[j];
+            }
+          }
+        } else if (is_parallel()) {
+          for (size_t i = 0; i != count; ++i) {
+            reduce_in_parallel(dst, child_src, true);
+
             dst += dst_stride;
             for (size_t j = 0; j < NArg; ++j) {
               child_src[j] += src_stride[j];
@@ -308,8 +441,13 @@ namespace nd {
           child_src[j] = src[j];
         }
 
+        bool parallel = is_parallel();
         for (size_t i = 0; i != count; ++i) {
-          reduce_child->strided(dst, 0, child_src, this->src_stride, _size);
+          if (parallel) {
+            reduce_in_parallel(dst, child_src, false);
+          } else {
+            reduce_child->strided(dst, 0, child_src, this->src_stride, _size);
+          }
 
           dst += dst_stride;
           for (size_t j = 0; j < NArg; ++j) {
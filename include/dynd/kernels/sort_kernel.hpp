@@ -5,11 +5,238 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
 #include <dynd/bytes.hpp>
 #include <dynd/kernels/base_strided_kernel.hpp>
+#include <dynd/parallel.hpp>
+#include <dynd/types/string_type.hpp>
 
 namespace dynd {
 namespace nd {
+  namespace detail {
+
+    /**
+     * Below this many elements, comparison sorting beats the fixed number of
+     * passes that the radix sort makes.
+     */
+    static const intptr_t radix_sort_threshold = 1024;
+
+    /**
+     * Maps a value to an unsigned integer of the same width whose unsigned order
+     * is the order of the values. Floating point values are ordered by their
+     * sign and magnitude, with -0.0 before 0.0 and every NaN last.
+     */
+    template <typename T, typename Enable = void>
+    struct sort_key;
+
+    template <typename T>
+    struct sort_key<T, typename std::enable_if<std::is_integral<T>::value>::type> {
+      typedef typename std::make_unsigned<T>::type type;
+
+      static type get(T value) {
+        return static_cast<type>(value) ^
+               (std::is_signed<T>::value ? static_cast<type>(type(1) << (8 * sizeof(T) - 1)) : type(0));
+      }
+    };
+
+    template <typename T>
+    struct sort_key<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+      typedef typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type type;
+
+      static type get(T value) {
+        if (value != value) {
+          return ~type(0);
+        }
+
+        type bits;
+        memcpy(&bits, &value, sizeof(T));
+        const type sign = type(1) << (8 * sizeof(T) - 1);
+        return (bits & sign) ? ~bits : (bits | sign);
+      }
+    };
+
+    /**
+     * The comparison used for small sorts and for merging, which orders values
+     * the way ``sort_key`` does, -0.0 before 0.0 included, so that the result
+     * does not depend on which of them is used.
+     */
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value, bool>::type total_less(T lhs, T rhs) {
+      return lhs < rhs;
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_floating_point<T>::value, bool>::type total_less(T lhs, T rhs) {
+      return lhs < rhs || (rhs != rhs && lhs == lhs) ||
+             (lhs == 0 && rhs == 0 && std::signbit(lhs) && !std::signbit(rhs));
+    }
+
+    inline bool total_less(const string &lhs, const string &rhs) { return lhs < rhs; }
+
+    /**
+     * Sorts ``size`` values with a least significant digit radix sort on the
+     * bytes of their ``sort_key``, using ``buffer`` as scratch space for as
+     * many values. The histograms for every digit are counted in one pass, and
+     * digits that are the same for all the values are skipped.
+     */
+    template <typename T>
+    void radix_sort(T *data, T *buffer, intptr_t size) {
+      typedef sort_key<T> key;
+      static const int ndigits = sizeof(T);
+
+      intptr_t counts[ndigits][256];
+      memset(counts, 0, sizeof(counts));
+      for (intptr_t i = 0; i < size; ++i) {
+        typename key::type k = key::get(data[i]);
+        for (int d = 0; d < ndigits; ++d) {
+          ++counts[d][(k >> (8 * d)) & 0xff];
+        }
+      }
+
+      T *src = data, *dst = buffer;
+      for (int d = 0; d < ndigits; ++d) {
+        intptr_t *count = counts[d];
+        if (count[(key::get(src[0]) >> (8 * d)) & 0xff] == size) {
+          continue;
+        }
+
+        intptr_t offset = 0;
+        for (int j = 0; j < 256; ++j) {
+          intptr_t c = count[j];
+          count[j] = offset;
+          offset += c;
+        }
+
+        for (intptr_t i = 0; i < size; ++i) {
+          dst[count[(key::get(src[i]) >> (8 * d)) & 0xff]++] = src[i];
+        }
+        std::swap(src, dst);
+      }
+
+      if (src != data) {
+        memcpy(data, src, size * sizeof(T));
+      }
+    }
+
+    /**
+     * Sorts ``size`` contiguous values, with a radix sort when there are enough
+     * of them and an inlined comparison sort otherwise.
+     */
+    template <typename T>
+    void sort_values(T *data, intptr_t size) {
+      if (size < radix_sort_threshold) {
+        std::sort(data, data + size, total_less<T>);
+        return;
+      }
+
+      std::unique_ptr<T[]> buffer(new T[size]);
+      radix_sort(data, buffer.get(), size);
+    }
+
+    /**
+     * The first eight bytes of a string as a big-endian integer, padded with
+     * zeros, so that comparing prefixes orders strings the way
+     * ``string::operator<`` does whenever they differ. Since that compares
+     * ``char``, the bytes are biased when it is signed.
+     */
+    inline uint64_t string_prefix(const string &value) {
+      const unsigned char bias = std::numeric_limits<char>::is_signed ? 0x80 : 0x00;
+
+      size_t size = std::min<size_t>(value.size(), 8);
+      const char *data = value.data();
+      uint64_t res = 0;
+      for (size_t i = 0; i < size; ++i) {
+        res |= static_cast<uint64_t>(static_cast<unsigned char>(data[i]) ^ bias) << (56 - 8 * i);
+      }
+
+      return res;
+    }
+
+    /**
+     * The number of elements of ``a`` among the first ``k`` elements of the
+     * stable merge of ``a`` and ``b``, found by binary search along the merge
+     * path so that pieces of one merge can be done independently.
+     */
+    template <typename T, typename LessFunc>
+    intptr_t merge_split(const T *a, intptr_t a_size, const T *b, intptr_t b_size, intptr_t k, LessFunc &less) {
+      intptr_t lo = std::max<intptr_t>(0, k - b_size), hi = std::min(k, a_size);
+      while (lo < hi) {
+        intptr_t i = lo + (hi - lo) / 2;
+        if (!less(b[k - i - 1], a[i])) {
+          lo = i + 1;
+        } else {
+          hi = i;
+        }
+      }
+
+      return lo;
+    }
+
+    /**
+     * Sorts ``size`` contiguous values with ``sort_chunk(data, size)``, which
+     * must order them consistently with ``less``. When the array is large
+     * enough for the default eval context to run it in parallel, it is split
+     * into one chunk per thread, the chunks are sorted concurrently, and then
+     * merged pairwise. Each merge is itself split along its merge path across
+     * the threads, so the last rounds are as parallel as the first. The merges
+     * are stable, so the result is stable if ``sort_chunk`` is.
+     */
+    template <typename T, typename SortFunc, typename LessFunc>
+    void parallel_sort(T *data, intptr_t size, SortFunc sort_chunk, LessFunc less) {
+      const eval::eval_context *ectx = &eval::default_eval_context;
+      if (!runs_in_parallel(size, ectx)) {
+        sort_chunk(data, size);
+        return;
+      }
+
+      size_t chunk_size = ectx->parallel_chunk_size > 0 ? ectx->parallel_chunk_size : 1;
+      size_t nchunks = std::min(static_cast<size_t>(ectx->nthreads), size / chunk_size);
+      std::vector<intptr_t> bounds(nchunks + 1);
+      for (size_t i = 0; i <= nchunks; ++i) {
+        bounds[i] = static_cast<intptr_t>(size * i / nchunks);
+      }
+
+      dynd::detail::parallel_run(nchunks, [&](size_t i) { sort_chunk(data + bounds[i], bounds[i + 1] - bounds[i]); },
+                                 ectx->nthreads);
+
+      std::unique_ptr<T[]> buffer(new T[size]);
+      T *src = data, *dst = buffer.get();
+      for (size_t width = 1; width < nchunks; width *= 2) {
+        size_t nmerges = (nchunks + 2 * width - 1) / (2 * width);
+        size_t npieces = std::max<size_t>(1, ectx->nthreads / nmerges);
+        dynd::detail::parallel_run(nmerges * npieces,
+                                   [&](size_t task) {
+                                     size_t first = 2 * width * (task / npieces);
+                                     intptr_t begin = bounds[first];
+                                     intptr_t mid = bounds[std::min(first + width, nchunks)];
+                                     intptr_t end = bounds[std::min(first + 2 * width, nchunks)];
+
+                                     const T *a = src + begin, *b = src + mid;
+                                     intptr_t a_size = mid - begin, b_size = end - mid;
+                                     size_t piece = task % npieces;
+                                     intptr_t k0 = static_cast<intptr_t>((end - begin) * piece / npieces);
+                                     intptr_t k1 = static_cast<intptr_t>((end - begin) * (piece + 1) / npieces);
+                                     intptr_t i0 = merge_split(a, a_size, b, b_size, k0, less);
+                                     intptr_t i1 = merge_split(a, a_size, b, b_size, k1, less);
+                                     std::merge(a + i0, a + i1, b + (k0 - i0), b + (k1 - i1), dst + begin + k0, less);
+                                   },
+                                   ectx->nthreads);
+        std::swap(src, dst);
+      }
+
+      if (src != data) {
+        std::copy(src, src + size, data);
+      }
+    }
+
+  } // namespace dynd::nd::detail
 
   struct sort_kernel : base_strided_kernel<sort_kernel, 1> {
     const intptr_t src0_size;
@@ -37,5 +264,85 @@ namespace nd {
     }
   };
 
+  /**
+   * Sorts a one-dimensional array of a built-in numeric type without calling a
+   * comparison kernel. Contiguous arrays are sorted in place, and strided ones
+   * are gathered into a contiguous buffer and scattered back. Large arrays are
+   * sorted across the threads of the default eval context.
+   */
+  template <typename T>
+  struct typed_sort_kernel : base_strided_kernel<typed_sort_kernel<T>, 1> {
+    const intptr_t src0_size;
+    const intptr_t src0_stride;
+
+    typed_sort_kernel(intptr_t src0_size, intptr_t src0_stride) : src0_size(src0_size), src0_stride(src0_stride) {}
+
+    void single(char *DYND_UNUSED(dst), char *const *src) {
+      if (src0_stride == static_cast<intptr_t>(sizeof(T))) {
+        sort_contiguous(reinterpret_cast<T *>(src[0]), src0_size);
+        return;
+      }
+
+      std::vector<T> values(src0_size);
+      char *src0 = src[0];
+      for (intptr_t i = 0; i < src0_size; ++i, src0 += src0_stride) {
+        values[i] = *reinterpret_cast<T *>(src0);
+      }
+      sort_contiguous(values.data(), src0_size);
+      src0 = src[0];
+      for (intptr_t i = 0; i < src0_size; ++i, src0 += src0_stride) {
+        *reinterpret_cast<T *>(src0) = values[i];
+      }
+    }
+
+    static void sort_contiguous(T *data, intptr_t size) {
+      detail::parallel_sort(data, size, &detail::sort_values<T>, &detail::total_less<T>);
+    }
+  };
+
+  /**
+   * Sorts a one-dimensional array of strings by their eight-byte prefixes,
+   * which are read once up front, and only compares the full strings when the
+   * prefixes are equal. The strings are then permuted by moving their 16-byte
+   * representations, which leaves any heap buffers they own untouched.
+   */
+  template <>
+  struct typed_sort_kernel<string> : base_strided_kernel<typed_sort_kernel<string>, 1> {
+    const intptr_t src0_size;
+    const intptr_t src0_stride;
+
+    typed_sort_kernel(intptr_t src0_size, intptr_t src0_stride) : src0_size(src0_size), src0_stride(src0_stride) {}
+
+    void single(char *DYND_UNUSED(dst), char *const *src) {
+      char *src0 = src[0];
+      intptr_t src0_stride = this->src0_stride;
+
+      std::vector<std::pair<uint64_t, intptr_t>> order(src0_size);
+      for (intptr_t i = 0; i < src0_size; ++i) {
+        order[i] = std::make_pair(detail::string_prefix(*reinterpret_cast<const string *>(src0 + i * src0_stride)), i);
+      }
+
+      auto less = [src0, src0_stride](const std::pair<uint64_t, intptr_t> &lhs,
+                                      const std::pair<uint64_t, intptr_t> &rhs) {
+        if (lhs.first != rhs.first) {
+          return lhs.first < rhs.first;
+        }
+        return *reinterpret_cast<const string *>(src0 + lhs.second * src0_stride) <
+               *reinterpret_cast<const string *>(src0 + rhs.second * src0_stride);
+      };
+      detail::parallel_sort(order.data(), src0_size, [&less](std::pair<uint64_t, intptr_t> *data, intptr_t size) {
+        std::sort(data, data + size, less);
+      }, less);
+
+      std::unique_ptr<char[]> sorted(new char[src0_size * sizeof(string)]);
+      for (intptr_t i = 0; i < src0_size; ++i) {
+        memcpy(sorted.get() + i * sizeof(string), src0 + order[i].second * src0_stride, sizeof(string));
+      }
+      for (intptr_t i = 0; i < src0_size; ++i) {
+        memcpy(src0 + i * src0_stride, sorted.get() + i * sizeof(string), sizeof(string));
+      }
+    }
+  };
+
 } // namespace dynd::nd
 } // namespace dynd
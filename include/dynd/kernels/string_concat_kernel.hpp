@@ -12,7 +12,32 @@
 namespace dynd {
 namespace nd {
 
-  struct string_concatenation_kernel : base_strided_kernel<string_concatenation_kernel, 2> {
+  /**
+   * Concatenates two strings into a ``string_view``, whose bytes are
+   * allocated from the memory block of the destination arrmeta.
+   */
+  template <typename Arg0Type, typename Arg1Type>
+  struct string_concatenation_kernel : base_strided_kernel<string_concatenation_kernel<Arg0Type, Arg1Type>, 2> {
+    const char *dst_arrmeta;
+
+    string_concatenation_kernel(const char *dst_arrmeta) : dst_arrmeta(dst_arrmeta) {}
+
+    void single(char *dst, char *const *src)
+    {
+      string_view s0(*reinterpret_cast<const Arg0Type *>(src[0]));
+      string_view s1(*reinterpret_cast<const Arg1Type *>(src[1]));
+
+      char *d = ndt::string_view_type::resize(dst_arrmeta, dst, s0.size() + s1.size());
+      if (d != NULL) {
+        DYND_MEMCPY(d, s0.data(), s0.size());
+        DYND_MEMCPY(d + s0.size(), s1.data(), s1.size());
+      }
+    }
+  };
+
+  template <>
+  struct string_concatenation_kernel<string, string>
+      : base_strided_kernel<string_concatenation_kernel<string, string>, 2> {
     void single(char *dst, char *const *src)
     {
       dynd::string_concat(2, *reinterpret_cast<string *>(dst), reinterpret_cast<const string *const *>(src));
@@ -0,0 +1,59 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <vector>
+
+#include <dynd/kernels/base_kernel.hpp>
+#include <dynd/string_search.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
+#include <dynd/types/string_view_type.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * Tells for each string of a one-dimensional array whether any of the
+   * strings of another one-dimensional array, the needles, occurs in it.
+   * The needles are built into one ``dynd::detail::multi_string_searcher`` for
+   * the whole call, so each string is scanned once for all of them.
+   */
+  template <typename Arg0Type, typename Arg1Type>
+  struct string_contains_any_kernel : base_kernel<string_contains_any_kernel<Arg0Type, Arg1Type>> {
+    const intptr_t src0_size;
+    const intptr_t src0_stride;
+    const intptr_t src1_size;
+    const intptr_t src1_stride;
+
+    string_contains_any_kernel(intptr_t src0_size, intptr_t src0_stride, intptr_t src1_size, intptr_t src1_stride)
+        : src0_size(src0_size), src0_stride(src0_stride), src1_size(src1_size), src1_stride(src1_stride) {}
+
+    void call(array *dst, const array *src) {
+      const char *src1 = src[1].cdata();
+      std::vector<string_view> needles;
+      needles.reserve(src1_size);
+      for (intptr_t i = 0; i < src1_size; ++i) {
+        needles.emplace_back(*reinterpret_cast<const Arg1Type *>(src1 + i * src1_stride));
+      }
+      dynd::detail::multi_string_searcher searcher(needles);
+
+      array res = empty(src0_size, ndt::make_type<bool1>());
+      char *res_data = res.data();
+      intptr_t res_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(res->metadata())->stride;
+
+      const char *src0 = src[0].cdata();
+      for (intptr_t i = 0; i < src0_size; ++i) {
+        string_view s(*reinterpret_cast<const Arg0Type *>(src0 + i * src0_stride));
+        *reinterpret_cast<bool1 *>(res_data) = searcher.contains(s.begin(), s.end());
+        res_data += res_stride;
+      }
+
+      *dst = res;
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
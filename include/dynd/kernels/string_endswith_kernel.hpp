@@ -12,13 +12,14 @@
 namespace dynd {
 namespace nd {
 
-  struct string_endswith_kernel : base_strided_kernel<string_endswith_kernel, 2> {
+  template <typename Arg0Type, typename Arg1Type>
+  struct string_endswith_kernel : base_strided_kernel<string_endswith_kernel<Arg0Type, Arg1Type>, 2> {
     void single(char *dst, char *const *src)
     {
       bool1 *d = reinterpret_cast<bool1 *>(dst);
-      const string *const *s = reinterpret_cast<const string *const *>(src);
 
-      *d = dynd::string_endswith(*(s[0]), *(s[1]));
+      *d = dynd::string_endswith(string_view(*reinterpret_cast<const Arg0Type *>(src[0])),
+                                 string_view(*reinterpret_cast<const Arg1Type *>(src[1])));
     }
   };
 
@@ -0,0 +1,79 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/kernels/base_kernel.hpp>
+#include <dynd/memblock/pod_memory_block.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
+#include <dynd/types/string_type.hpp>
+#include <dynd/types/string_view_type.hpp>
+
+namespace dynd {
+namespace nd {
+
+  namespace detail {
+
+    /**
+     * Copies the bytes of ``size`` string views, one after another, into a
+     * single buffer of exactly their total size, and points the views at the
+     * copies. Returns the memory block that owns the buffer.
+     */
+    inline memory_block pack_string_views(char *data, intptr_t stride, intptr_t size) {
+      size_t total_size = 0;
+      for (intptr_t i = 0; i < size; ++i) {
+        total_size += reinterpret_cast<const string_view *>(data + i * stride)->size();
+      }
+
+      memory_block blockref = make_memory_block<pod_memory_block>(1, 1, std::max<size_t>(total_size, 1));
+      char *buffer = blockref->alloc(total_size);
+      for (intptr_t i = 0; i < size; ++i) {
+        string_view &s = *reinterpret_cast<string_view *>(data + i * stride);
+        if (!s.empty()) {
+          DYND_MEMCPY(buffer, s.data(), s.size());
+        }
+        s = string_view(buffer, s.size());
+        buffer += s.size();
+      }
+
+      return blockref;
+    }
+
+  } // namespace dynd::nd::detail
+
+  /**
+   * Copies the bytes of each string of a one-dimensional array, one after
+   * another, into a single buffer, and makes the result a ``string_view`` for
+   * each string into that buffer. The buffer is owned by one memory block,
+   * so the column is allocated once and freed at once, with nothing to
+   * release per element, and a scan over it walks contiguous bytes.
+   */
+  template <typename Arg0Type>
+  struct string_pack_kernel : base_kernel<string_pack_kernel<Arg0Type>> {
+    const intptr_t src0_size;
+    const intptr_t src0_stride;
+
+    string_pack_kernel(intptr_t src0_size, intptr_t src0_stride) : src0_size(src0_size), src0_stride(src0_stride) {}
+
+    void call(array *dst, const array *src) {
+      const char *src0 = src[0].cdata();
+
+      array res = empty(src0_size, ndt::make_type<string_view>());
+      char *res_data = res.data();
+      intptr_t res_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(res->metadata())->stride;
+      for (intptr_t i = 0; i < src0_size; ++i) {
+        *reinterpret_cast<string_view *>(res_data + i * res_stride) =
+            string_view(*reinterpret_cast<const Arg0Type *>(src0 + i * src0_stride));
+      }
+
+      reinterpret_cast<string_view_type_arrmeta *>(res->metadata() + sizeof(fixed_dim_type_arrmeta))->blockref =
+          detail::pack_string_views(res_data, res_stride, src0_size);
+
+      *dst = res;
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -12,13 +12,15 @@
 namespace dynd {
 namespace nd {
 
-  struct string_replace_kernel : base_strided_kernel<string_replace_kernel, 3> {
+  template <typename Arg0Type, typename Arg1Type, typename Arg2Type>
+  struct string_replace_kernel : base_strided_kernel<string_replace_kernel<Arg0Type, Arg1Type, Arg2Type>, 3> {
     void single(char *dst, char *const *src)
     {
       string *d = reinterpret_cast<string *>(dst);
-      const string *const *s = reinterpret_cast<const string *const *>(src);
 
-      dynd::string_replace(*d, *s[0], *s[1], *s[2]);
+      dynd::string_replace(*d, string_view(*reinterpret_cast<const Arg0Type *>(src[0])),
+                           string_view(*reinterpret_cast<const Arg1Type *>(src[1])),
+                           string_view(*reinterpret_cast<const Arg2Type *>(src[2])));
     }
   };
 
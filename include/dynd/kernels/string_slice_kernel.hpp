@@ -0,0 +1,67 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <algorithm>
+
+#include <dynd/kernels/base_kernel.hpp>
+#include <dynd/kernels/string_pack_kernel.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
+#include <dynd/types/string_type.hpp>
+#include <dynd/types/string_view_type.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * Slices each string of a one-dimensional array to the bytes from
+   * ``start`` up to ``stop``, which count from the end when negative and are
+   * clipped to the string as in Python. The slices are views into the data
+   * of an immutable source array, which the result keeps alive. The strings
+   * of any other source may be reassigned, freeing their bytes, so the sliced
+   * bytes are copied into one buffer instead. The result replaces the
+   * destination array.
+   */
+  struct string_slice_kernel : base_kernel<string_slice_kernel> {
+    const intptr_t src0_size;
+    const intptr_t src0_stride;
+
+    string_slice_kernel(intptr_t src0_size, intptr_t src0_stride) : src0_size(src0_size), src0_stride(src0_stride) {}
+
+    static intptr_t clip(intptr_t i, intptr_t size) {
+      if (i < 0) {
+        i += size;
+      }
+
+      return std::min(std::max(i, static_cast<intptr_t>(0)), size);
+    }
+
+    void call(array *dst, const array *src) {
+      const char *src0 = src[0].cdata();
+      intptr_t start = src[1].as<intptr_t>();
+      intptr_t stop = src[2].as<intptr_t>();
+
+      array res = empty(src0_size, ndt::make_type<string_view>());
+      char *res_data = res.data();
+      intptr_t res_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(res->metadata())->stride;
+      for (intptr_t i = 0; i < src0_size; ++i) {
+        const string &s = *reinterpret_cast<const string *>(src0 + i * src0_stride);
+        intptr_t size = static_cast<intptr_t>(s.size());
+        intptr_t begin = clip(start, size);
+        intptr_t end = std::max(begin, clip(stop, size));
+        *reinterpret_cast<string_view *>(res_data + i * res_stride) = string_view(s.data() + begin, end - begin);
+      }
+
+      reinterpret_cast<string_view_type_arrmeta *>(res->metadata() + sizeof(fixed_dim_type_arrmeta))->blockref =
+          src[0].is_immutable() ? src[0].get_data_memblock()
+                                : detail::pack_string_views(res_data, res_stride, src0_size);
+
+      *dst = res;
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
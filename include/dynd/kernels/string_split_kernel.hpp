@@ -7,14 +7,20 @@
 
 #pragma once
 
+#include <vector>
+
+#include <dynd/kernels/string_pack_kernel.hpp>
 #include <dynd/string.hpp>
 #include <dynd/string_search.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
+#include <dynd/types/string_view_type.hpp>
 #include <dynd/types/var_dim_type.hpp>
 
 namespace dynd {
 namespace nd {
 
-  struct string_split_kernel : base_strided_kernel<string_split_kernel, 2> {
+  template <typename Arg0Type, typename Arg1Type>
+  struct string_split_kernel : base_strided_kernel<string_split_kernel<Arg0Type, Arg1Type>, 2> {
     memory_block m_dst_memblock;
 
     string_split_kernel(const memory_block &dst_memblock) : m_dst_memblock(dst_memblock) {}
@@ -22,9 +28,8 @@ namespace nd {
     void single(char *dst, char *const *src) {
       ndt::var_dim_type::data_type *dst_v = reinterpret_cast<ndt::var_dim_type::data_type *>(dst);
 
-      const string *const *s = reinterpret_cast<const string *const *>(src);
-      const string &haystack = *(s[0]);
-      const string &needle = *(s[1]);
+      string_view haystack(*reinterpret_cast<const Arg0Type *>(src[0]));
+      string_view needle(*reinterpret_cast<const Arg1Type *>(src[1]));
 
       intptr_t count = dynd::string_count(haystack, needle);
 
@@ -32,7 +37,7 @@ namespace nd {
         dst_v->begin = m_dst_memblock->alloc(1);
         dst_v->size = 1;
         string *dst_str = reinterpret_cast<string *>(dst_v->begin);
-        dst_str[0] = haystack;
+        dst_str[0].assign(haystack.begin(), haystack.size());
         return;
       }
 
@@ -40,11 +45,73 @@ namespace nd {
       dst_v->size = count + 1;
       string *dst_str = reinterpret_cast<string *>(dst_v->begin);
 
-      dynd::detail::string_splitter<string> f(dst_str, haystack, needle);
+      dynd::detail::string_splitter<string, string_view> f(dst_str, haystack, needle);
       dynd::detail::string_search(haystack, needle, f);
       f.finish();
     }
   };
 
+  /**
+   * Splits each string of a one-dimensional array in a single pass, into
+   * views that point into the data of an immutable source array, which the
+   * result keeps alive. The strings of any other source may be reassigned,
+   * freeing their bytes, so those are first copied into one buffer that the
+   * views point into instead. Apart from that, only the views themselves are
+   * allocated, one block for each string, so the result replaces the
+   * destination array.
+   */
+  struct string_split_view_kernel : base_kernel<string_split_view_kernel> {
+    const intptr_t src0_size;
+    const intptr_t src0_stride;
+
+    string_split_view_kernel(intptr_t src0_size, intptr_t src0_stride)
+        : src0_size(src0_size), src0_stride(src0_stride) {}
+
+    void call(array *dst, const array *src) {
+      const char *src0 = src[0].cdata();
+      string_view needle(*reinterpret_cast<const string *>(src[1].cdata()));
+
+      std::vector<string_view> haystacks(src0_size);
+      for (intptr_t i = 0; i < src0_size; ++i) {
+        haystacks[i] = string_view(*reinterpret_cast<const string *>(src0 + i * src0_stride));
+      }
+      memory_block haystacks_blockref =
+          src[0].is_immutable() ? src[0].get_data_memblock()
+                                : detail::pack_string_views(reinterpret_cast<char *>(haystacks.data()),
+                                                            sizeof(string_view), src0_size);
+
+      array res = empty(src0_size, ndt::make_type<ndt::var_dim_type>(ndt::make_type<string_view>()));
+      char *res_data = res.data();
+      intptr_t res_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(res->metadata())->stride;
+      const ndt::var_dim_type::metadata_type *res_md = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(
+          res->metadata() + sizeof(fixed_dim_type_arrmeta));
+      reinterpret_cast<string_view_type_arrmeta *>(res->metadata() + sizeof(fixed_dim_type_arrmeta) +
+                                                   sizeof(ndt::var_dim_type::metadata_type))
+          ->blockref = haystacks_blockref;
+
+      std::vector<string_view> pieces;
+      for (intptr_t i = 0; i < src0_size; ++i) {
+        const string_view &haystack = haystacks[i];
+
+        pieces.clear();
+        if (needle.empty()) {
+          pieces.push_back(haystack);
+        } else {
+          dynd::detail::string_view_splitter<string_view, std::vector<string_view>> f(pieces, haystack, needle);
+          dynd::detail::string_search(haystack, needle, f);
+          f.finish();
+        }
+
+        ndt::var_dim_type::data_type *dst_v = reinterpret_cast<ndt::var_dim_type::data_type *>(res_data);
+        dst_v->begin = res_md->blockref->alloc(pieces.size());
+        dst_v->size = pieces.size();
+        memcpy(dst_v->begin, pieces.data(), pieces.size() * sizeof(string_view));
+        res_data += res_stride;
+      }
+
+      *dst = res;
+    }
+  };
+
 } // namespace nd
 } // namespace dynd
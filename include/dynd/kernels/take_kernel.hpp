@@ -5,57 +5,227 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <dynd/cpu_features.hpp>
 #include <dynd/shape_tools.hpp>
+#include <dynd/parallel.hpp>
 #include <dynd/kernels/base_kernel.hpp>
 #include <dynd/assignment.hpp>
 
+#ifdef DYND_ISA_DISPATCH
+#include <immintrin.h>
+#endif
+
 namespace dynd {
 namespace nd {
 
-  struct DYND_API masked_take_ck : base_strided_kernel<masked_take_ck, 2> {
-    const char *m_dst_meta;
-    intptr_t m_dim_size, m_src0_stride, m_mask_stride;
+  namespace detail {
 
-    ~masked_take_ck() { get_child()->destroy(); }
+    /**
+     * How many indices ahead of the current one an indexed take prefetches
+     * its source element.
+     */
+    static const intptr_t take_prefetch_distance = 16;
 
-    void single(char *dst, char *const *src) {
-      kernel_prefix *child = get_child();
-      kernel_strided_t child_fn = child->get_function<kernel_strided_t>();
-      char *src0 = src[0];
-      char *mask = src[1];
-      intptr_t dim_size = m_dim_size, src0_stride = m_src0_stride, mask_stride = m_mask_stride;
-      // Start with the dst matching the dim size. (Maybe better to
-      // do smaller? This means no resize required in the loop.)
-      ndt::var_dim_type::data_type *vdd = reinterpret_cast<ndt::var_dim_type::data_type *>(dst);
-      vdd->begin = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(m_dst_meta)->blockref->alloc(dim_size);
-      vdd->size = dim_size;
-      char *dst_ptr = vdd->begin;
-      intptr_t dst_stride = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(m_dst_meta)->stride;
-      intptr_t dst_count = 0;
-      intptr_t i = 0;
-      while (i < dim_size) {
-        // Run of false
-        for (; i < dim_size && *mask == 0; src0 += src0_stride, mask += mask_stride, ++i) {
+    /**
+     * Checks all the indices of an indexed take against the size of the
+     * source dimension at once, throwing for the first one out of bounds, so
+     * that the gather itself needs no checks.
+     */
+    inline void check_take_indices(const char *index, intptr_t index_stride, intptr_t size, intptr_t src0_dim_size) {
+      intptr_t lo = 0, hi = 0;
+      for (intptr_t i = 0; i < size; ++i) {
+        intptr_t ix = *reinterpret_cast<const intptr_t *>(index + i * index_stride);
+        lo = std::min(lo, ix);
+        hi = std::max(hi, ix);
+      }
+
+      if (size > 0 && (lo < -src0_dim_size || hi >= src0_dim_size)) {
+        for (intptr_t i = 0; i < size; ++i) {
+          apply_single_index(*reinterpret_cast<const intptr_t *>(index + i * index_stride), src0_dim_size, NULL);
         }
-        // Run of true
-        intptr_t i_saved = i;
-        for (; i < dim_size && *mask != 0; mask += mask_stride, ++i) {
+      }
+    }
+
+    /**
+     * The position of a checked index, with Python-style negative indices
+     * wrapped around without a branch.
+     */
+    inline intptr_t wrap_take_index(intptr_t ix, intptr_t src0_dim_size) {
+      return ix + (src0_dim_size & (ix >> (8 * sizeof(intptr_t) - 1)));
+    }
+
+    /**
+     * A sixteen byte element, copied as two words.
+     */
+    struct take_bytes16 {
+      uint64_t words[2];
+    };
+
+    /**
+     * Copies the elements at indices [begin, end) of a checked index array,
+     * as values of type ``T``.
+     */
+    template <typename T>
+    void gather(char *dst, intptr_t dst_stride, const char *src0, intptr_t src0_dim_size, intptr_t src0_stride,
+                const char *index, intptr_t index_stride, intptr_t begin, intptr_t end) {
+      for (intptr_t i = begin; i < end; ++i) {
+        if (i + take_prefetch_distance < end) {
+          intptr_t ahead = *reinterpret_cast<const intptr_t *>(index + (i + take_prefetch_distance) * index_stride);
+          DYND_PREFETCH(src0 + wrap_take_index(ahead, src0_dim_size) * src0_stride);
         }
-        // Copy the run of true
-        if (i > i_saved) {
-          intptr_t run_count = i - i_saved;
-          child_fn(child, dst_ptr, dst_stride, &src0, &src0_stride, run_count);
-          dst_ptr += run_count * dst_stride;
-          src0 += run_count * src0_stride;
-          dst_count += run_count;
+
+        intptr_t ix = wrap_take_index(*reinterpret_cast<const intptr_t *>(index + i * index_stride), src0_dim_size);
+        *reinterpret_cast<T *>(dst + i * dst_stride) = *reinterpret_cast<const T *>(src0 + ix * src0_stride);
+      }
+    }
+
+#ifdef DYND_ISA_DISPATCH
+    /**
+     * Like ``gather``, for a packed source, index and destination, as a plain
+     * loop that the compiler turns into AVX2 gathers for four and eight byte
+     * elements.
+     */
+    template <typename T>
+    DYND_TARGET("avx2")
+    void avx2_gather(T *dst, const T *src0, intptr_t src0_dim_size, const intptr_t *index, intptr_t begin,
+                     intptr_t end) {
+      for (intptr_t i = begin; i < end; ++i) {
+        dst[i] = src0[wrap_take_index(index[i], src0_dim_size)];
+      }
+    }
+#endif
+
+    /**
+     * The mask of a masked take as words of 64 bits, the first element in the
+     * lowest bit. A packed mask is read in place, eight elements to the byte,
+     * while a ``bool1`` mask is packed into words up front.
+     */
+    class take_mask {
+      const unsigned char *m_bits;
+      std::vector<uint64_t> m_words;
+      intptr_t m_size;
+
+    public:
+      take_mask(const char *mask, intptr_t mask_stride, bool packed, intptr_t size) : m_bits(NULL), m_size(size) {
+        if (packed) {
+          m_bits = reinterpret_cast<const unsigned char *>(mask);
+          return;
+        }
+
+        m_words.assign((size + 63) / 64, 0);
+        intptr_t i = 0;
+        if (mask_stride == 1) {
+          for (; i + 8 <= size; i += 8) {
+            // Assembled little endian whatever the host, so that the first
+            // byte lands in the lowest bit below
+            uint64_t bytes = 0;
+            for (int k = 0; k < 8; ++k) {
+              bytes |= static_cast<uint64_t>(static_cast<unsigned char>(mask[i + k])) << (8 * k);
+            }
+            // Any nonzero byte is true, so fold each byte into its lowest bit
+            // and then gather those bits into one byte with a multiply
+            bytes |= bytes >> 4;
+            bytes |= bytes >> 2;
+            bytes |= bytes >> 1;
+            bytes &= 0x0101010101010101ULL;
+            m_words[i / 64] |= ((bytes * 0x0102040810204080ULL) >> 56) << (i % 64);
+          }
+        }
+        for (; i < size; ++i) {
+          m_words[i / 64] |= static_cast<uint64_t>(mask[i * mask_stride] != 0) << (i % 64);
         }
       }
 
-      vdd->begin = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(m_dst_meta)
-                       ->blockref->resize(vdd->begin, dst_count);
-      vdd->size = dst_count;
+      intptr_t size() const { return m_size; }
+
+      intptr_t nwords() const { return (m_size + 63) / 64; }
+
+      /**
+       * The bits of elements [64 k, 64 k + 64), with those past the end clear.
+       */
+      uint64_t word(intptr_t k) const {
+        intptr_t nbits = std::min(static_cast<intptr_t>(64), m_size - 64 * k);
+        uint64_t res = 0;
+        if (m_bits == NULL) {
+          res = m_words[k];
+        } else {
+          // Bytes rather than a load of the whole word, so that packed masks
+          // read the same on any host and may end short of a word
+          const unsigned char *bytes = m_bits + 8 * k;
+          for (intptr_t j = 0; j < (nbits + 7) / 8; ++j) {
+            res |= static_cast<uint64_t>(bytes[j]) << (8 * j);
+          }
+        }
+
+        return (nbits == 64) ? res : (res & ((static_cast<uint64_t>(1) << nbits) - 1));
+      }
+
+      /**
+       * How many elements are selected, so the destination can be allocated
+       * once at its final size.
+       */
+      intptr_t count() const {
+        intptr_t res = 0;
+        for (intptr_t k = 0; k < nwords(); ++k) {
+          res += popcount64(word(k));
+        }
+
+        return res;
+      }
+    };
+
+    /**
+     * Copies the selected elements of one word of a mask as values of type
+     * ``T``, returning the destination past the last one.
+     */
+    template <typename T>
+    char *compress(char *dst, intptr_t dst_stride, const char *src0, intptr_t src0_stride, uint64_t bits) {
+      for (; bits != 0; bits &= bits - 1) {
+        *reinterpret_cast<T *>(dst) = *reinterpret_cast<const T *>(src0 + ctz64(bits) * src0_stride);
+        dst += dst_stride;
+      }
+
+      return dst;
     }
-  };
+
+#ifdef DYND_ISA_DISPATCH
+    /**
+     * Like ``compress`` for a full word of a packed source and destination,
+     * with the AVX-512 compressing stores, a vector of elements at a time.
+     * Element sizes without such a store go through ``compress``.
+     */
+    template <typename T>
+    char *avx512_compress(T *dst, const T *src0, uint64_t bits) {
+      return compress<T>(reinterpret_cast<char *>(dst), sizeof(T), reinterpret_cast<const char *>(src0), sizeof(T),
+                         bits);
+    }
+
+    DYND_TARGET("avx512f") inline char *avx512_compress(uint32_t *dst, const uint32_t *src0, uint64_t bits) {
+      for (int j = 0; j < 64; j += 16) {
+        __mmask16 m = static_cast<__mmask16>(bits >> j);
+        _mm512_mask_compressstoreu_epi32(dst, m, _mm512_loadu_si512(src0 + j));
+        dst += popcount64(m);
+      }
+
+      return reinterpret_cast<char *>(dst);
+    }
+
+    DYND_TARGET("avx512f") inline char *avx512_compress(uint64_t *dst, const uint64_t *src0, uint64_t bits) {
+      for (int j = 0; j < 64; j += 8) {
+        __mmask8 m = static_cast<__mmask8>(bits >> j);
+        _mm512_mask_compressstoreu_epi64(dst, m, _mm512_loadu_si512(src0 + j));
+        dst += popcount64(m);
+      }
+
+      return reinterpret_cast<char *>(dst);
+    }
+#endif
+
+  } // namespace dynd::nd::detail
 
   /**
    * CKernel which does an indexed take operation. The child ckernel
@@ -74,11 +244,15 @@ namespace nd {
       const char *index = src[1];
       intptr_t dst_dim_size = m_dst_dim_size, src0_dim_size = m_src0_dim_size, dst_stride = m_dst_stride,
                src0_stride = m_src0_stride, index_stride = m_index_stride;
+      detail::check_take_indices(index, index_stride, dst_dim_size, src0_dim_size);
       for (intptr_t i = 0; i < dst_dim_size; ++i) {
-        intptr_t ix = *reinterpret_cast<const intptr_t *>(index);
-        // Handle Python-style negative index, bounds checking
-        ix = apply_single_index(ix, src0_dim_size, NULL);
+        if (i + detail::take_prefetch_distance < dst_dim_size) {
+          intptr_t ahead = *reinterpret_cast<const intptr_t *>(index + detail::take_prefetch_distance * index_stride);
+          DYND_PREFETCH(src0 + detail::wrap_take_index(ahead, src0_dim_size) * src0_stride);
+        }
+
         // Copy one element at a time
+        intptr_t ix = detail::wrap_take_index(*reinterpret_cast<const intptr_t *>(index), src0_dim_size);
         char *child_src0 = src0 + ix * src0_stride;
         child_fn(child, dst, &child_src0);
         dst += dst_stride;
@@ -87,5 +261,128 @@ namespace nd {
     }
   };
 
+  /**
+   * CKernel which does an indexed take of plain old data elements of the
+   * same size as ``T``, copying them directly rather than through a child.
+   * Large index arrays are split across threads.
+   */
+  template <typename T>
+  struct typed_indexed_take_ck : base_strided_kernel<typed_indexed_take_ck<T>, 2> {
+    intptr_t m_dst_dim_size, m_dst_stride, m_index_stride;
+    intptr_t m_src0_dim_size, m_src0_stride;
+
+    void single(char *dst, char *const *src) {
+      const char *src0 = src[0];
+      const char *index = src[1];
+      intptr_t dst_stride = m_dst_stride, src0_dim_size = m_src0_dim_size, src0_stride = m_src0_stride,
+               index_stride = m_index_stride;
+      detail::check_take_indices(index, index_stride, m_dst_dim_size, src0_dim_size);
+
+#ifdef DYND_ISA_DISPATCH
+      if ((sizeof(T) == 4 || sizeof(T) == 8) && cpu_supports(cpu_feature_avx2) &&
+          dst_stride == static_cast<intptr_t>(sizeof(T)) && src0_stride == static_cast<intptr_t>(sizeof(T)) &&
+          index_stride == static_cast<intptr_t>(sizeof(intptr_t))) {
+        parallel_for(m_dst_dim_size, [&](size_t begin, size_t end) {
+          detail::avx2_gather(reinterpret_cast<T *>(dst), reinterpret_cast<const T *>(src0), src0_dim_size,
+                              reinterpret_cast<const intptr_t *>(index), static_cast<intptr_t>(begin),
+                              static_cast<intptr_t>(end));
+        });
+        return;
+      }
+#endif
+
+      parallel_for(m_dst_dim_size, [&](size_t begin, size_t end) {
+        detail::gather<T>(dst, dst_stride, src0, src0_dim_size, src0_stride, index, index_stride,
+                          static_cast<intptr_t>(begin), static_cast<intptr_t>(end));
+      });
+    }
+  };
+
+  /**
+   * CKernel which does a masked take operation into a var dimension. The
+   * selected elements are counted first, so the destination is allocated
+   * once at its final size, and then each run of them is copied with one
+   * call of the strided child.
+   */
+  struct DYND_API masked_take_ck : base_strided_kernel<masked_take_ck, 2> {
+    const char *m_dst_meta;
+    intptr_t m_dim_size, m_src0_stride, m_mask_stride;
+    bool m_packed;
+
+    ~masked_take_ck() { get_child()->destroy(); }
+
+    void single(char *dst, char *const *src) {
+      kernel_prefix *child = get_child();
+      kernel_strided_t child_fn = child->get_function<kernel_strided_t>();
+      intptr_t src0_stride = m_src0_stride;
+      detail::take_mask mask(src[1], m_mask_stride, m_packed, m_dim_size);
+
+      const ndt::var_dim_type::metadata_type *dst_md =
+          reinterpret_cast<const ndt::var_dim_type::metadata_type *>(m_dst_meta);
+      intptr_t dst_count = mask.count();
+      ndt::var_dim_type::data_type *vdd = reinterpret_cast<ndt::var_dim_type::data_type *>(dst);
+      vdd->begin = dst_md->blockref->alloc(dst_count);
+      vdd->size = dst_count;
+
+      char *dst_ptr = vdd->begin;
+      intptr_t dst_stride = dst_md->stride;
+      for (intptr_t k = 0; k < mask.nwords(); ++k) {
+        uint64_t bits = mask.word(k);
+        while (bits != 0) {
+          // Copy the run of true starting at the lowest set bit
+          int start = ctz64(bits);
+          uint64_t rest = ~(bits >> start);
+          int run_count = (rest == 0) ? 64 - start : ctz64(rest);
+          char *run_src0 = src[0] + (64 * k + start) * src0_stride;
+          child_fn(child, dst_ptr, dst_stride, &run_src0, &src0_stride, run_count);
+          dst_ptr += run_count * dst_stride;
+          bits &= (start + run_count == 64) ? 0 : (~static_cast<uint64_t>(0) << (start + run_count));
+        }
+      }
+    }
+  };
+
+  /**
+   * CKernel which does a masked take of plain old data elements of the same
+   * size as ``T``, copying them directly rather than through a child. Packed
+   * four and eight byte elements use the AVX-512 compressing stores where
+   * they are supported.
+   */
+  template <typename T>
+  struct typed_masked_take_ck : base_strided_kernel<typed_masked_take_ck<T>, 2> {
+    const char *m_dst_meta;
+    intptr_t m_dim_size, m_src0_stride, m_mask_stride;
+    bool m_packed;
+
+    void single(char *dst, char *const *src) {
+      intptr_t src0_stride = m_src0_stride;
+      detail::take_mask mask(src[1], m_mask_stride, m_packed, m_dim_size);
+
+      const ndt::var_dim_type::metadata_type *dst_md =
+          reinterpret_cast<const ndt::var_dim_type::metadata_type *>(m_dst_meta);
+      intptr_t dst_count = mask.count();
+      ndt::var_dim_type::data_type *vdd = reinterpret_cast<ndt::var_dim_type::data_type *>(dst);
+      vdd->begin = dst_md->blockref->alloc(dst_count);
+      vdd->size = dst_count;
+
+      char *dst_ptr = vdd->begin;
+      intptr_t dst_stride = dst_md->stride;
+      intptr_t k = 0;
+#ifdef DYND_ISA_DISPATCH
+      if ((sizeof(T) == 4 || sizeof(T) == 8) && cpu_supports(cpu_feature_avx512f) &&
+          dst_stride == static_cast<intptr_t>(sizeof(T)) && src0_stride == static_cast<intptr_t>(sizeof(T))) {
+        // Whole words only, as the vector loads read every element of one
+        for (; k < m_dim_size / 64; ++k) {
+          dst_ptr = detail::avx512_compress(reinterpret_cast<T *>(dst_ptr),
+                                            reinterpret_cast<const T *>(src[0] + 64 * k * src0_stride), mask.word(k));
+        }
+      }
+#endif
+      for (; k < mask.nwords(); ++k) {
+        dst_ptr = detail::compress<T>(dst_ptr, dst_stride, src[0] + 64 * k * src0_stride, src0_stride, mask.word(k));
+      }
+    }
+  };
+
 } // namespace dynd::nd
 } // namespace dynd
@@ -7,6 +7,7 @@
 
 #include <dynd/kernels/base_kernel.hpp>
 #include <dynd/types/fixed_string_type.hpp>
+#include <dynd/types/string_view_type.hpp>
 
 namespace dynd {
 namespace nd {
@@ -38,5 +39,15 @@ namespace nd {
     }
   };
 
+  template <>
+  struct total_order_kernel<string_view, string_view>
+      : base_strided_kernel<total_order_kernel<string_view, string_view>, 2> {
+    void single(char *dst, char *const *src) {
+      *reinterpret_cast<int *>(dst) = std::lexicographical_compare(
+          reinterpret_cast<string_view *>(src[0])->begin(), reinterpret_cast<string_view *>(src[0])->end(),
+          reinterpret_cast<string_view *>(src[1])->begin(), reinterpret_cast<string_view *>(src[1])->end());
+    }
+  };
+
 } // namespace dynd::nd
 } // namespace dynd
@@ -5,39 +5,266 @@
 
 #pragma once
 
-#include <dynd/bytes.hpp>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
 #include <dynd/kernels/base_kernel.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
+#include <dynd/types/string_type.hpp>
 
 namespace dynd {
 namespace nd {
+  namespace detail {
+
+    inline uint64_t hash_mix(uint64_t x) {
+      x ^= x >> 33;
+      x *= 0xff51afd7ed558ccdULL;
+      x ^= x >> 33;
+      x *= 0xc4ceb9fe1a85ec53ULL;
+      x ^= x >> 33;
+      return x;
+    }
+
+    /**
+     * Hashes ``size`` bytes eight at a time, with the size folded into the
+     * last word so that zero padding does not collide with zero bytes.
+     */
+    inline uint64_t hash_bytes(const char *data, size_t size) {
+      uint64_t res = 0;
+      size_t i = 0;
+      for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        memcpy(&word, data + i, 8);
+        res = hash_mix(res ^ word);
+      }
+
+      uint64_t word = 0;
+      memcpy(&word, data + i, size - i);
+      return hash_mix(res ^ word ^ (static_cast<uint64_t>(size) << 56));
+    }
+
+    /**
+     * How ``unique_kernel`` hashes, compares and copies the elements of a
+     * built-in numeric type. Floating point zeros are all one value, and so are
+     * the NaNs.
+     */
+    template <typename T>
+    struct unique_traits {
+      unique_traits(const ndt::type &DYND_UNUSED(tp)) {}
+
+      static T canonical(T value) {
+        if (std::is_floating_point<T>::value) {
+          if (value == 0) {
+            return 0;
+          }
+          if (value != value) {
+            return std::numeric_limits<T>::quiet_NaN();
+          }
+        }
+
+        return value;
+      }
+
+      uint64_t hash(const char *data) const {
+        T value = canonical(*reinterpret_cast<const T *>(data));
+        uint64_t bits = 0;
+        memcpy(&bits, &value, sizeof(T));
+        return hash_mix(bits);
+      }
+
+      bool equal(const char *lhs, const char *rhs) const {
+        T lhs_value = *reinterpret_cast<const T *>(lhs), rhs_value = *reinterpret_cast<const T *>(rhs);
+        return lhs_value == rhs_value || (lhs_value != lhs_value && rhs_value != rhs_value);
+      }
+
+      void copy(char *dst, const char *src) const { *reinterpret_cast<T *>(dst) = *reinterpret_cast<const T *>(src); }
+    };
+
+    /**
+     * Strings short enough for the small string optimization are hashed and
+     * compared as the two words of their representation, which hold the bytes
+     * zero padded and the size in the top byte. Short strings that happen to
+     * be on the heap are hashed as the same two words.
+     */
+    template <>
+    struct unique_traits<string> {
+      unique_traits(const ndt::type &DYND_UNUSED(tp)) {}
+
+      static bool is_sso(const char *data) {
+        int64_t size;
+        memcpy(&size, data + 8, 8);
+        return size >= 0;
+      }
+
+      uint64_t hash(const char *data) const {
+        uint64_t words[2];
+        if (!is_sso(data)) {
+          const string &value = *reinterpret_cast<const string *>(data);
+          if (value.size() >= 15) {
+            return hash_bytes(value.data(), value.size());
+          }
+
+          memset(words, 0, sizeof(words));
+          memcpy(words, value.data(), value.size());
+          words[1] |= static_cast<uint64_t>(value.size()) << 56;
+        } else {
+          memcpy(words, data, sizeof(words));
+        }
+
+        return hash_mix(words[0] ^ hash_mix(words[1]));
+      }
+
+      bool equal(const char *lhs, const char *rhs) const {
+        if (is_sso(lhs) && is_sso(rhs)) {
+          return memcmp(lhs, rhs, 16) == 0;
+        }
+
+        return *reinterpret_cast<const string *>(lhs) == *reinterpret_cast<const string *>(rhs);
+      }
+
+      void copy(char *dst, const char *src) const {
+        *reinterpret_cast<string *>(dst) = *reinterpret_cast<const string *>(src);
+      }
+    };
 
-  struct unique_kernel : base_kernel<unique_kernel> {
+    /**
+     * Fixed bytes are hashed and compared as raw bytes of the type's size.
+     */
+    struct unique_bytes_traits {
+      size_t data_size;
+
+      unique_bytes_traits(const ndt::type &tp) : data_size(tp.get_data_size()) {}
+
+      uint64_t hash(const char *data) const { return hash_bytes(data, data_size); }
+
+      bool equal(const char *lhs, const char *rhs) const { return memcmp(lhs, rhs, data_size) == 0; }
+
+      void copy(char *dst, const char *src) const { memcpy(dst, src, data_size); }
+    };
+
+  } // namespace dynd::nd::detail
+
+  /**
+   * Finds the distinct values of a one-dimensional array, in the order they
+   * first occur, with an open addressing hash table of indices into the
+   * source. Each element is hashed once, so this is linear in the size of the
+   * source, and the source is left as it is.
+   *
+   * How many values there are is only known once they are hashed, so the
+   * kernel replaces the destination array. It is the distinct values, or a
+   * struct of them with any of the first occurrence ``index``, the ``inverse``
+   * mapping from each element to its value, and the ``counts`` of each value.
+   */
+  template <typename TraitsType>
+  struct unique_kernel : base_kernel<unique_kernel<TraitsType>> {
     const intptr_t src0_size;
     const intptr_t src0_stride;
-    const intptr_t src0_element_data_size;
-
-    unique_kernel(intptr_t src0_size, intptr_t src0_stride, size_t src0_element_data_size)
-        : src0_size(src0_size), src0_stride(src0_stride), src0_element_data_size(src0_element_data_size) {}
-
-    ~unique_kernel() { get_child()->destroy(); }
-
-    void call(array *DYND_UNUSED(dst), const array *src) {
-      kernel_prefix *child = get_child();
-      size_t new_size =
-          (std::unique(strided_iterator(src[0].data(), src0_element_data_size, src0_stride),
-                       strided_iterator(src[0].data() + src0_size * src0_stride, src0_element_data_size, src0_stride),
-                       [child](char *lhs, char *rhs) {
-                         bool1 dst;
-                         char *src[2] = {lhs, rhs};
-                         child->single(reinterpret_cast<char *>(&dst), src);
-                         return dst;
-                       }) -
-           src[0].data()) /
-          src0_stride;
-
-//      src[0]->set_type(
-  //        ndt::make_fixed_dim(new_size, src[0]->get_type().extended<ndt::fixed_dim_type>()->get_element_type()));
-      reinterpret_cast<size_stride_t *>(src[0]->metadata())->dim_size = new_size;
+    const ndt::type src0_element_tp;
+    const TraitsType traits;
+    const bool return_index;
+    const bool return_inverse;
+    const bool return_counts;
+
+    unique_kernel(intptr_t src0_size, intptr_t src0_stride, const ndt::type &src0_element_tp, bool return_index,
+                  bool return_inverse, bool return_counts)
+        : src0_size(src0_size), src0_stride(src0_stride), src0_element_tp(src0_element_tp), traits(src0_element_tp),
+          return_index(return_index), return_inverse(return_inverse), return_counts(return_counts) {}
+
+    void call(array *dst, const array *src) {
+      const char *src0 = src[0].cdata();
+
+      std::vector<intptr_t> index;
+      std::vector<uint64_t> hashes;
+      std::vector<intptr_t> counts;
+      array inverse;
+      intptr_t *inverse_data = nullptr;
+      if (return_inverse) {
+        inverse = empty(src0_size, ndt::make_type<intptr_t>());
+        inverse_data = reinterpret_cast<intptr_t *>(inverse.data());
+      }
+
+      // Slots hold indices into ``index``, or -1 when empty, and the table is
+      // kept at most half full
+      std::vector<intptr_t> slots(16, -1);
+      size_t mask = slots.size() - 1;
+      for (intptr_t i = 0; i < src0_size; ++i) {
+        const char *value = src0 + i * src0_stride;
+        uint64_t h = traits.hash(value);
+
+        size_t slot = static_cast<size_t>(h) & mask;
+        intptr_t j;
+        while ((j = slots[slot]) != -1 &&
+               (hashes[j] != h || !traits.equal(value, src0 + index[j] * src0_stride))) {
+          slot = (slot + 1) & mask;
+        }
+
+        if (j == -1) {
+          j = static_cast<intptr_t>(index.size());
+          slots[slot] = j;
+          index.push_back(i);
+          hashes.push_back(h);
+          if (return_counts) {
+            counts.push_back(0);
+          }
+
+          if (2 * index.size() > slots.size()) {
+            slots.assign(2 * slots.size(), -1);
+            mask = slots.size() - 1;
+            for (size_t k = 0; k < hashes.size(); ++k) {
+              size_t s = static_cast<size_t>(hashes[k]) & mask;
+              while (slots[s] != -1) {
+                s = (s + 1) & mask;
+              }
+              slots[s] = static_cast<intptr_t>(k);
+            }
+          }
+        }
+
+        if (return_counts) {
+          ++counts[j];
+        }
+        if (return_inverse) {
+          inverse_data[i] = j;
+        }
+      }
+
+      intptr_t size = static_cast<intptr_t>(index.size());
+      array values = empty(size, src0_element_tp);
+      char *values_data = values.data();
+      intptr_t values_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(values->metadata())->stride;
+      for (intptr_t j = 0; j < size; ++j) {
+        traits.copy(values_data + j * values_stride, src0 + index[j] * src0_stride);
+      }
+
+      if (!return_index && !return_inverse && !return_counts) {
+        *dst = values;
+        return;
+      }
+
+      std::vector<std::pair<const char *, array>> fields;
+      fields.emplace_back("values", values);
+      if (return_index) {
+        fields.emplace_back("index", make_intptr_array(index));
+      }
+      if (return_inverse) {
+        fields.emplace_back("inverse", inverse);
+      }
+      if (return_counts) {
+        fields.emplace_back("counts", make_intptr_array(counts));
+      }
+      *dst = as_struct(fields.size(), fields.data());
+    }
+
+  private:
+    static array make_intptr_array(const std::vector<intptr_t> &values) {
+      array res = empty(values.size(), ndt::make_type<intptr_t>());
+      if (!values.empty()) {
+        memcpy(res.data(), values.data(), values.size() * sizeof(intptr_t));
+      }
+
+      return res;
     }
   };
 
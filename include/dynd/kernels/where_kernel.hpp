@@ -5,50 +5,130 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include <dynd/kernels/base_strided_kernel.hpp>
 
 namespace dynd {
 namespace nd {
 
+  /**
+   * Appends the index of every element for which the child predicate is true
+   * to a var_dim result. The result grows geometrically and is only trimmed to
+   * its size once it is finished, when the kernel moves on to another result or
+   * is destroyed, and a strided run evaluates the predicate a chunk at a time
+   * into a mask before compacting the matches.
+   */
   struct where_kernel : base_strided_kernel<where_kernel, 2> {
+    typedef ndt::var_dim_type::data_type ret_type;
+
     size_t &it;
     intptr_t ret_stride;
     memory_block dst_memory_block;
     size_t ret_element_size;
+    ret_type *res;
     size_t capacity;
 
     where_kernel(char *data, intptr_t ret_stride, const memory_block &dst_memory_block)
         : it(*reinterpret_cast<size_t *>(data)), ret_stride(ret_stride), dst_memory_block(dst_memory_block),
-          ret_element_size(sizeof(intptr_t)), capacity(0) {}
+          ret_element_size(sizeof(intptr_t)), res(NULL), capacity(0) {}
+
+    ~where_kernel() {
+      if (res != NULL) {
+        trim(res);
+      }
+      get_child()->destroy();
+    }
 
     void single(char *ret, char *const *src) {
+      static const intptr_t child_src_stride[1] = {0};
+
       bool child_ret;
-      get_child()->single(reinterpret_cast<char *>(&child_ret), src);
+      get_child()->strided(reinterpret_cast<char *>(&child_ret), 0, src, child_src_stride, 1);
 
       if (child_ret) {
-        const state &src1 = *reinterpret_cast<state *>(src[1]);
-
-        size_t &size = reinterpret_cast<ndt::var_dim_type::data_type *>(ret)->size;
-        if (size == 0) {
-          capacity = 1;
-          reinterpret_cast<ndt::var_dim_type::data_type *>(ret)->begin = dst_memory_block->alloc(capacity);
-        } else if (size == capacity) {
-          capacity = size + 1;
-          reinterpret_cast<ndt::var_dim_type::data_type *>(ret)->begin =
-              dst_memory_block->resize(reinterpret_cast<ndt::var_dim_type::data_type *>(ret)->begin, capacity);
-        }
-        ++size;
+        reserve(reinterpret_cast<ret_type *>(ret), 1);
+        append(reinterpret_cast<ret_type *>(ret), *reinterpret_cast<state *>(src[1]));
+      }
+    }
+
+    void strided(char *ret, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+      if (dst_stride != 0) {
+        base_strided_kernel<where_kernel, 2>::strided(ret, dst_stride, src, src_stride, count);
+        return;
+      }
 
-        intptr_t *index = reinterpret_cast<intptr_t *>(reinterpret_cast<ndt::var_dim_type::data_type *>(ret)->begin +
-                                                       (size - 1) * ret_stride);
-        *index = src1.index[0];
+      ret_type *dst = reinterpret_cast<ret_type *>(ret);
+      const state &src1 = *reinterpret_cast<state *>(src[1]);
+      kernel_prefix *child = get_child();
+
+      bool mask[DYND_BUFFER_CHUNK_SIZE];
+      char *src0 = src[0];
+      for (size_t i = 0; i < count; i += DYND_BUFFER_CHUNK_SIZE) {
+        size_t chunk_size = std::min(count - i, static_cast<size_t>(DYND_BUFFER_CHUNK_SIZE));
+        child->strided(reinterpret_cast<char *>(mask), sizeof(bool), &src0, src_stride, chunk_size);
+        src0 += static_cast<intptr_t>(chunk_size) * src_stride[0];
+
+        reserve(dst, std::count(mask, mask + chunk_size, true));
+        for (size_t j = 0; j < chunk_size; ++j) {
+          if (mask[j]) {
+            it = i + j;
+            append(dst, src1);
+          }
+        }
       }
+
+      it = count;
     }
 
     size_t &begin() {
       it = 0;
       return it;
     }
+
+  private:
+    /**
+     * Makes room for ``count`` more indices in ``dst``, growing the capacity
+     * geometrically. Switching to another result finishes the previous one.
+     */
+    void reserve(ret_type *dst, size_t count) {
+      if (count == 0) {
+        return;
+      }
+
+      if (dst != res) {
+        if (res != NULL) {
+          trim(res);
+        }
+        res = dst;
+        capacity = dst->size;
+      }
+
+      size_t required = dst->size + count;
+      if (dst->size == 0) {
+        capacity = std::max(required, static_cast<size_t>(16));
+        dst->begin = dst_memory_block->alloc(capacity);
+      } else if (required > capacity) {
+        capacity = std::max(required, 2 * capacity);
+        dst->begin = dst_memory_block->resize(dst->begin, capacity);
+      }
+    }
+
+    void append(ret_type *dst, const state &src1) {
+      *reinterpret_cast<intptr_t *>(dst->begin + dst->size * ret_stride) = src1.index[0];
+      ++dst->size;
+    }
+
+    /**
+     * Gives back the capacity past the last index, which is in place because the
+     * result is the last allocation of its memory block.
+     */
+    void trim(ret_type *dst) {
+      if (dst->size != 0 && dst->size < capacity) {
+        capacity = dst->size;
+        dst->begin = dst_memory_block->resize(dst->begin, capacity);
+      }
+    }
   };
 
 } // namespace dynd::nd
@@ -0,0 +1,36 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * Flags for how ``nd::memmap`` maps a file.
+   */
+  enum memmap_flags {
+    /** Creates a file opened for writing, or grows it, to hold the whole array */
+    memmap_create = 0x01,
+    /** Reads the whole mapping in up front, rather than a page at a time on first use */
+    memmap_populate = 0x02,
+    /** Asks for huge pages, which only some file systems provide for files */
+    memmap_huge_pages = 0x04
+  };
+
+  /**
+   * How the data of a memory-mapped array is going to be used, as a hint for
+   * how far the system reads ahead and which pages it drops first.
+   */
+  enum memmap_advice {
+    memmap_advice_normal,
+    memmap_advice_sequential,
+    memmap_advice_random,
+    memmap_advice_willneed,
+    memmap_advice_dontneed
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -6,6 +6,9 @@
 #pragma once
 
 #include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 
 #ifdef _WIN32
@@ -20,7 +23,9 @@
 #include <unistd.h>
 #endif
 
+#include <dynd/buffer.hpp>
 #include <dynd/memblock/base_memory_block.hpp>
+#include <dynd/memblock/memmap_flags.hpp>
 
 namespace dynd {
 
@@ -66,7 +71,9 @@ namespace nd {
    * Creates a memory block of a memory-mapped file.
    *
    * \param filename  The filename of the file to memory map.
-   * \param access  A combination of write_access_flag, read_access_flag, immutable_access_flag.
+   * \param access  A combination of write_access_flag, read_access_flag, immutable_access_flag. With
+   *                write_access_flag, the file is opened for writing and the mapping is shared, so
+   *                writes through it go to the file.
    * \param out_pointer  This is the pointer to the mapped memory.
    * \param out_size  This is the size of the mapped memory. Note that the size may be different
    *                  than requested by begin/end, because this function uses Python semantics to
@@ -79,6 +86,7 @@ namespace nd {
    *             (default end of the file). This value may be
    *             negative, in which case it is interpreted as an offset from the
    *             end of the file.
+   * \param flags  A combination of memmap_create, memmap_populate, memmap_huge_pages.
    */
   class memmap_memory_block : public base_memory_block {
     // Parameters used to construct the memory block
@@ -95,12 +103,15 @@ namespace nd {
     // Offset to the actual data requested (memory mapping has strict
     // alignment requirements)
     intptr_t m_mapOffset;
+    intptr_t m_mapSize;
 
   public:
-    memmap_memory_block(const std::string &filename, uint32_t DYND_UNUSED(access), char **out_pointer,
-                        intptr_t *out_size, intptr_t begin = 0, intptr_t end = std::numeric_limits<intptr_t>::max())
-        : m_filename(filename), m_begin(begin), m_end(end) {
-      bool readwrite = false; // ((access & nd::write_access_flag) == nd::write_access_flag);
+    memmap_memory_block(const std::string &filename, uint32_t access, char **out_pointer, intptr_t *out_size,
+                        intptr_t begin = 0, intptr_t end = std::numeric_limits<intptr_t>::max(), uint32_t flags = 0)
+        : m_filename(filename), m_begin(begin), m_end(end), m_mapPointer(NULL), m_mapOffset(0), m_mapSize(0) {
+      bool readwrite = ((access & nd::write_access_flag) == nd::write_access_flag);
+      // Growing the file to the end of the mapping needs to know where that is
+      bool create = readwrite && (flags & memmap_create) != 0 && end != std::numeric_limits<intptr_t>::max();
 #ifdef WIN32
       // TODO: This function isn't quite exception-safe, use a smart pointer for the handles to fix.
 
@@ -112,14 +123,18 @@ namespace nd {
 
       // Open the file using the windows API
       m_hFile = CreateFile(m_filename.c_str(), GENERIC_READ | (readwrite ? GENERIC_WRITE : 0), FILE_SHARE_READ, NULL,
-                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
-      if (m_hFile == NULL) {
+                           create ? OPEN_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+      if (m_hFile == INVALID_HANDLE_VALUE) {
         std::stringstream ss;
         ss << "failed to open file \"" << m_filename << "\" for memory mapping";
         throw std::runtime_error(ss.str());
       }
 
+      // A writable file mapping larger than the file grows it
       intptr_t filesize = get_file_size(m_hFile);
+      if (create && end > filesize) {
+        filesize = end;
+      }
       // Handle the begin offset, following Python
       // semantics of bytes[begin:end]
       clip_begin_end(filesize, begin, end);
@@ -130,7 +145,7 @@ namespace nd {
       // on a boundary based on the system allocation granularity
       intptr_t mapbegin = (begin / sysGran) * sysGran;
       m_mapOffset = begin - mapbegin;
-      intptr_t mapsize = end - mapbegin;
+      m_mapSize = end - mapbegin;
 
       m_hMapFile = CreateFileMapping(m_hFile, NULL, readwrite ? PAGE_READWRITE : PAGE_READONLY,
 #ifdef _WIN64
@@ -153,7 +168,7 @@ namespace nd {
 #else
                                            0,
 #endif
-                                           (uint32_t)mapbegin, mapsize);
+                                           (uint32_t)mapbegin, m_mapSize);
       if (m_mapPointer == NULL) {
         CloseHandle(m_hMapFile);
         CloseHandle(m_hFile);
@@ -164,7 +179,7 @@ namespace nd {
       *out_pointer = m_mapPointer + m_mapOffset;
       *out_size = end - begin;
 #else // Finished win32 implementation, now posix
-      m_fd = open(m_filename.c_str(), readwrite ? O_RDWR : O_RDONLY);
+      m_fd = open(m_filename.c_str(), readwrite ? (O_RDWR | (create ? O_CREAT : 0)) : O_RDONLY, 0666);
       if (m_fd == -1) {
         std::stringstream ss;
         ss << "failed to open file \"" << m_filename << "\" for memory mapping";
@@ -179,11 +194,21 @@ namespace nd {
 #endif
       struct stat st;
       if (fstat(m_fd, &st) == -1) {
+        close(m_fd);
         std::stringstream ss;
         ss << "failed to stat file \"" << m_filename << "\" for memory mapping";
         throw std::runtime_error(ss.str());
       }
       intptr_t filesize = st.st_size;
+      if (create && end > filesize) {
+        if (ftruncate(m_fd, end) == -1) {
+          close(m_fd);
+          std::stringstream ss;
+          ss << "failed to grow file \"" << m_filename << "\" to " << end << " bytes for memory mapping";
+          throw std::runtime_error(ss.str());
+        }
+        filesize = end;
+      }
 
       // Handle the begin offset, following Python
       // semantics of bytes[begin:end]
@@ -194,14 +219,34 @@ namespace nd {
       intptr_t pageSize = sysconf(_SC_PAGE_SIZE);
       intptr_t mapbegin = (begin / pageSize) * pageSize;
       m_mapOffset = begin - mapbegin;
-      intptr_t mapsize = end - mapbegin;
+      m_mapSize = end - mapbegin;
 
-      m_mapPointer = (char *)mmap(NULL, mapsize, PROT_READ | (readwrite ? PROT_WRITE : 0), MAP_SHARED, m_fd, mapbegin);
-      if (m_mapPointer == (char *)MAP_FAILED) {
-        close(m_fd);
-        std::stringstream ss;
-        ss << "failed to mmap file \"" << m_filename << "\" for memory mapping";
-        throw std::runtime_error(ss.str());
+      // An empty range has nothing to map, which mmap rejects
+      if (m_mapSize > 0) {
+        int mapflags = MAP_SHARED;
+#ifdef MAP_POPULATE
+        mapflags |= (flags & memmap_populate) ? MAP_POPULATE : 0;
+#endif
+        m_mapPointer =
+            (char *)mmap(NULL, m_mapSize, PROT_READ | (readwrite ? PROT_WRITE : 0), mapflags, m_fd, mapbegin);
+        if (m_mapPointer == (char *)MAP_FAILED) {
+          close(m_fd);
+          std::stringstream ss;
+          ss << "failed to mmap file \"" << m_filename << "\" for memory mapping";
+          throw std::runtime_error(ss.str());
+        }
+
+#ifndef MAP_POPULATE
+        if (flags & memmap_populate) {
+          (void)madvise(m_mapPointer, m_mapSize, MADV_WILLNEED);
+        }
+#endif
+#ifdef MADV_HUGEPAGE
+        // Only a hint, which file systems without huge page support turn down
+        if (flags & memmap_huge_pages) {
+          (void)madvise(m_mapPointer, m_mapSize, MADV_HUGEPAGE);
+        }
+#endif
       }
 
       *out_pointer = m_mapPointer + m_mapOffset;
@@ -215,12 +260,73 @@ namespace nd {
       CloseHandle(m_hMapFile);
       CloseHandle(m_hFile);
 #else
-      intptr_t mapsize = m_end - m_begin + m_mapOffset;
-      munmap((void *)m_mapPointer, mapsize);
+      if (m_mapPointer != NULL) {
+        munmap((void *)m_mapPointer, m_mapSize);
+      }
       close(m_fd);
 #endif
     }
 
+    /**
+     * Writes the changes made through a writable mapping back to the file.
+     * When ``wait`` is false, the writes are only scheduled.
+     */
+    void flush(bool wait = true) {
+      if (m_mapPointer == NULL) {
+        return;
+      }
+
+#ifdef WIN32
+      bool failed = !FlushViewOfFile(m_mapPointer, 0) || (wait && !FlushFileBuffers(m_hFile));
+#else
+      bool failed = msync(m_mapPointer, m_mapSize, wait ? MS_SYNC : MS_ASYNC) == -1;
+#endif
+      if (failed) {
+        std::stringstream ss;
+        ss << "failed to flush memory mapped file \"" << m_filename << "\"";
+        throw std::runtime_error(ss.str());
+      }
+    }
+
+    /**
+     * Tells the system how the mapped pages are going to be used, which
+     * decides how far it reads ahead and which pages it drops first.
+     */
+    void advise(memmap_advice advice) {
+#ifndef WIN32
+      if (m_mapPointer == NULL) {
+        return;
+      }
+
+      int madv = MADV_NORMAL;
+      switch (advice) {
+      case memmap_advice_normal:
+        madv = MADV_NORMAL;
+        break;
+      case memmap_advice_sequential:
+        madv = MADV_SEQUENTIAL;
+        break;
+      case memmap_advice_random:
+        madv = MADV_RANDOM;
+        break;
+      case memmap_advice_willneed:
+        madv = MADV_WILLNEED;
+        break;
+      case memmap_advice_dontneed:
+        madv = MADV_DONTNEED;
+        break;
+      }
+      if (madvise(m_mapPointer, m_mapSize, madv) == -1) {
+        std::stringstream ss;
+        ss << "failed to advise the system on memory mapped file \"" << m_filename << "\"";
+        throw std::runtime_error(ss.str());
+      }
+#else
+      // There is no equivalent for a view of a file mapping
+      (void)advice;
+#endif
+    }
+
     void debug_print(std::ostream &o, const std::string &indent) {
       o << indent << "------ memory_block at " << static_cast<const void *>(this) << "\n";
       o << indent << " reference count: " << static_cast<long>(m_use_count) << "\n";
@@ -0,0 +1,62 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <cstdint>
+
+#include <dynd/config.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * Provides the chunks of memory that the POD memory blocks dole out their
+   * data from. A memory block keeps the allocator it was created with, and
+   * gives every chunk back to it when it is destroyed or reset.
+   */
+  class DYNDT_API base_memory_allocator {
+  public:
+    virtual ~base_memory_allocator();
+
+    /**
+     * Allocates a chunk of at least ``size`` bytes, setting ``size`` to the
+     * number of bytes that may actually be used. Throws std::bad_alloc on
+     * failure.
+     */
+    virtual char *allocate(intptr_t &size) = 0;
+
+    /**
+     * Gives back a chunk returned by ``allocate``, along with the size it set.
+     */
+    virtual void deallocate(char *ptr, intptr_t size) = 0;
+  };
+
+  /**
+   * An allocator that goes straight to malloc and free.
+   */
+  DYNDT_API base_memory_allocator &malloc_memory_allocator();
+
+  /**
+   * An allocator that rounds chunks up to a power of two between 1 KiB and
+   * 1 MiB, and keeps a few freed chunks of each size per thread to hand out
+   * again. Larger chunks go straight to malloc and free.
+   */
+  DYNDT_API base_memory_allocator &pool_memory_allocator();
+
+  /**
+   * The allocator that memory blocks use when they are not given one, which
+   * is the pool allocator unless changed by ``set_default_memory_allocator``.
+   */
+  DYNDT_API base_memory_allocator &default_memory_allocator();
+
+  /**
+   * Sets the allocator used by memory blocks created from here on. The
+   * allocator must outlive every memory block that uses it.
+   */
+  DYNDT_API void set_default_memory_allocator(base_memory_allocator &allocator);
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -113,12 +113,14 @@ namespace nd {
 
       if (mc->capacity_count - previous_index < count) {
         append_memory(std::max(m_total_allocated_count, count));
+        // Appending may have moved the chunks, so the old one is looked up again
+        mc = &m_memory_handles[m_memory_handles.size() - 2];
         memory_chunk *new_mc = &m_memory_handles.back();
         // Move the old memory to the newly allocated block
         if (previous_count > 0) {
           // Subtract the previously used memory from the old chunk's count
           mc->used_count -= previous_count;
-          memcpy(new_mc->memory, previous_allocated, previous_count);
+          memcpy(new_mc->memory, previous_allocated, m_stride * previous_count);
           // If the old memory only had the memory being resized,
           // free it completely.
           if (previous_allocated == mc->memory) {
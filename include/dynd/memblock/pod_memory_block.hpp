@@ -9,6 +9,7 @@
 #include <string>
 
 #include <dynd/memblock/base_memory_block.hpp>
+#include <dynd/memblock/memory_allocator.hpp>
 #include <dynd/type.hpp>
 
 namespace dynd {
@@ -19,22 +20,27 @@ namespace nd {
     size_t data_size;
     intptr_t data_alignment;
     intptr_t m_total_allocated_capacity;
-    /** The malloc'd memory */
-    std::vector<char *> m_memory_handles;
-    /** The current malloc'd memory being doled out */
+    /** The allocator the memory chunks come from */
+    base_memory_allocator *m_allocator;
+    /** The allocated memory chunks, with their sizes */
+    std::vector<std::pair<char *, intptr_t>> m_memory_handles;
+    /** The current memory chunk being doled out */
     char *m_memory_begin, *m_memory_current, *m_memory_end;
 
-    pod_memory_block(size_t data_size, intptr_t data_alignment, intptr_t initial_capacity_bytes = 2048)
-        : data_size(data_size), data_alignment(data_alignment), m_total_allocated_capacity(0), m_memory_handles() {
+    pod_memory_block(size_t data_size, intptr_t data_alignment, intptr_t initial_capacity_bytes = 2048,
+                     base_memory_allocator &allocator = default_memory_allocator())
+        : data_size(data_size), data_alignment(data_alignment), m_total_allocated_capacity(0), m_allocator(&allocator),
+          m_memory_handles() {
       append_memory(initial_capacity_bytes);
     }
 
-    pod_memory_block(const ndt::type &tp, intptr_t initial_capacity_bytes = 2048)
-        : pod_memory_block(tp.get_default_data_size(), tp.get_data_alignment(), initial_capacity_bytes) {}
+    pod_memory_block(const ndt::type &tp, intptr_t initial_capacity_bytes = 2048,
+                     base_memory_allocator &allocator = default_memory_allocator())
+        : pod_memory_block(tp.get_default_data_size(), tp.get_data_alignment(), initial_capacity_bytes, allocator) {}
 
     ~pod_memory_block() {
       for (size_t i = 0, i_end = m_memory_handles.size(); i != i_end; ++i) {
-        free(m_memory_handles[i]);
+        m_allocator->deallocate(m_memory_handles[i].first, m_memory_handles[i].second);
       }
     }
 
@@ -43,13 +49,9 @@ namespace nd {
      * more. Adds it to the memory handles vector.
      */
     void append_memory(intptr_t capacity_bytes) {
-      m_memory_handles.push_back(NULL);
-      m_memory_begin = reinterpret_cast<char *>(malloc(capacity_bytes));
-      m_memory_handles.back() = m_memory_begin;
-      if (m_memory_begin == NULL) {
-        m_memory_handles.pop_back();
-        throw std::bad_alloc();
-      }
+      m_memory_handles.reserve(m_memory_handles.size() + 1);
+      m_memory_begin = m_allocator->allocate(capacity_bytes);
+      m_memory_handles.push_back(std::make_pair(m_memory_begin, capacity_bytes));
       m_memory_current = m_memory_begin;
       m_memory_end = m_memory_current + capacity_bytes;
       m_total_allocated_capacity += capacity_bytes;
@@ -97,10 +99,11 @@ namespace nd {
       } else {
         // If it doesn't fit, need to copy to newly malloc'd memory
         char *old_current = inout_begin, *old_end = *inout_end;
+        intptr_t old_size_bytes = *inout_end - inout_begin;
         // Allocate memory to double the amount used so far, or the requested size, whichever is larger
         // NOTE: We're assuming malloc produces memory which has good enough alignment for anything
         append_memory(std::max(m_total_allocated_capacity, size_bytes));
-        memcpy(m_memory_begin, inout_begin, *inout_end - inout_begin);
+        memcpy(m_memory_begin, inout_begin, old_size_bytes);
         end = m_memory_begin + size_bytes;
         m_memory_current = end;
         inout_begin = m_memory_begin;
@@ -129,7 +132,7 @@ namespace nd {
         // If there are more than one allocated memory chunks,
         // throw them all away except the last
         for (size_t i = 0, i_end = m_memory_handles.size() - 1; i != i_end; ++i) {
-          free(m_memory_handles[i]);
+          m_allocator->deallocate(m_memory_handles[i].first, m_memory_handles[i].second);
         }
         m_memory_handles.front() = m_memory_handles.back();
         m_memory_handles.resize(1);
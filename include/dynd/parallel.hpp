@@ -0,0 +1,69 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+
+#include <dynd/config.hpp>
+#include <dynd/eval/eval_context.hpp>
+
+namespace dynd {
+namespace detail {
+
+  /**
+   * Returns true when called from inside a parallel_for, in which case any
+   * nested parallel_for runs on the calling thread.
+   */
+  DYND_API bool in_parallel_region();
+
+  /**
+   * Runs ``task(i)`` for every ``i`` in [0, ntasks) on the shared thread pool,
+   * which is sized to ``nthreads`` threads including the calling one. Tasks
+   * are handed out one at a time from a shared counter, so threads which
+   * finish early take over the remaining work of the slower ones. The first
+   * exception thrown by a task is rethrown once all threads have stopped.
+   */
+  DYND_API void parallel_run(size_t ntasks, const std::function<void(size_t)> &task, intptr_t nthreads);
+
+} // namespace dynd::detail
+
+/**
+ * Returns true when a parallel_for over ``size`` elements would split them
+ * across threads rather than run on the calling thread.
+ */
+inline bool runs_in_parallel(size_t size, const eval::eval_context *ectx = &eval::default_eval_context) {
+  size_t chunk_size = ectx->parallel_chunk_size > 0 ? ectx->parallel_chunk_size : 1;
+  return ectx->nthreads > 1 && size >= 2 * chunk_size && !detail::in_parallel_region();
+}
+
+/**
+ * Calls ``f(begin, end)`` over chunks which together cover [0, size),
+ * spreading them across ``ectx->nthreads`` threads. Small ranges, a single
+ * thread, and calls nested inside another parallel_for all run ``f(0, size)``
+ * directly on the calling thread.
+ */
+template <typename FuncType>
+void parallel_for(size_t size, FuncType &&f, const eval::eval_context *ectx = &eval::default_eval_context) {
+  if (!runs_in_parallel(size, ectx)) {
+    f(static_cast<size_t>(0), size);
+    return;
+  }
+
+  // Oversplit a little so that uneven progress across threads evens out
+  size_t chunk_size = ectx->parallel_chunk_size > 0 ? ectx->parallel_chunk_size : 1;
+  size_t nchunks = std::min((size + chunk_size - 1) / chunk_size, static_cast<size_t>(4 * ectx->nthreads));
+  size_t step = (size + nchunks - 1) / nchunks;
+  nchunks = (size + step - 1) / step;
+  detail::parallel_run(nchunks,
+                       [&](size_t i) {
+                         size_t begin = i * step;
+                         f(begin, std::min(begin + step, size));
+                       },
+                       ectx->nthreads);
+}
+
+} // namespace dynd
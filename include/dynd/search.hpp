@@ -12,11 +12,34 @@ namespace nd {
 
   /**
    * Performs a binary search of the first dimension of the array, which
-   * should be sorted.
+   * should be sorted. A value of another type is assigned to the element
+   * type first. NaN and NA come after every other value, as ``nd::sort``
+   * puts them.
    *
-   * \returns  The index of the found element, or -1 if not found.
+   * \returns  The first index of an equal element, or -1 if not found.
    */
   extern DYND_API callable binary_search;
 
+  /**
+   * Searches the first dimension of a sorted array for every element of a
+   * one-dimensional array of values, many at a time. The ``side`` keyword is
+   * "left" for the first position each value could be inserted at keeping
+   * the array sorted, "right" for the last one, or "exact" for the first
+   * index of an equal element or -1. With ``layout`` "eytzinger" the array is
+   * one made by ``nd::eytzinger``, and the results are still positions in
+   * sorted order. Values are assigned to the element type and ordered like
+   * ``nd::binary_search`` orders them.
+   *
+   * \returns  The ``intptr`` position of each value.
+   */
+  extern DYND_API callable searchsorted;
+
+  /**
+   * Copies a sorted one-dimensional array of plain old data into the
+   * Eytzinger layout, which is faster to search when it is much larger than
+   * the cache and is searched often.
+   */
+  extern DYND_API callable eytzinger;
+
 } // namespace dynd::nd
 } // namespace dynd
@@ -10,7 +10,16 @@
 namespace dynd {
 namespace nd {
 
+  /**
+   * Sorts a one-dimensional array in place.
+   */
   extern DYND_API callable sort;
+
+  /**
+   * Returns the ``intptr`` indices that would stably sort a one-dimensional
+   * array, e.g. to reorder other arrays the same way with ``nd::take``.
+   */
+  extern DYND_API callable argsort;
   extern DYND_API callable unique;
 
 } // namespace dynd::nd
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <map>
 #include <new>
@@ -13,6 +14,27 @@
 #include <dynd/visibility.hpp>
 
 namespace dynd {
+namespace detail {
+
+  /**
+   * The largest heap block that a thread keeps around for reuse.
+   */
+  static const intptr_t max_storagebuf_scratch_capacity = 64 * 1024;
+
+  /**
+   * Takes the heap block that this thread kept from a destroyed storagebuf, if
+   * it holds at least ``capacity`` bytes, and sets ``capacity`` to its size.
+   * Otherwise returns NULL.
+   */
+  DYND_API void *take_storagebuf_scratch(intptr_t &capacity);
+
+  /**
+   * Gives a heap block back to this thread, which either keeps it for the next
+   * storagebuf that outgrows its static data or frees it.
+   */
+  DYND_API void give_storagebuf_scratch(void *data, intptr_t capacity);
+
+} // namespace dynd::detail
 
 template <typename PrefixType, typename DerivedType>
 class storagebuf {
@@ -35,7 +57,7 @@ public:
 
   ~storagebuf() {
     if (!using_static_data() && m_data != NULL) {
-      free(m_data);
+      detail::give_storagebuf_scratch(m_data, m_capacity);
     }
   }
 
@@ -57,8 +79,20 @@ public:
       if (requested_capacity < grown_capacity) {
         requested_capacity = grown_capacity;
       }
-      // Do a realloc
-      char *new_data = reinterpret_cast<char *>(realloc(m_data, m_capacity, requested_capacity));
+      char *new_data;
+      if (using_static_data()) {
+        // Reuse the block of a buffer this thread destroyed earlier, so that
+        // building a large kernel over and over does not go back to malloc
+        new_data = reinterpret_cast<char *>(detail::take_storagebuf_scratch(requested_capacity));
+        if (new_data != NULL) {
+          copy(new_data, m_data, m_capacity);
+        } else {
+          new_data = reinterpret_cast<char *>(realloc(m_data, m_capacity, requested_capacity));
+        }
+      } else {
+        // Do a realloc
+        new_data = reinterpret_cast<char *>(realloc(m_data, m_capacity, requested_capacity));
+      }
       if (new_data == NULL) {
         reinterpret_cast<DerivedType *>(this)->destroy();
         m_data = NULL;
@@ -7,6 +7,7 @@
 
 #include <dynd/callable.hpp>
 #include <dynd/string_search.hpp>
+#include <dynd/types/string_view_type.hpp>
 
 namespace dynd {
 
@@ -77,20 +78,21 @@ intptr_t string_rfind(const StringType &haystack, const StringType &needle)
 
 /*
   In string `src`, replace all non-overlapping appearances of
-  `old_str` with `new_str`, storing the result in `dst`.
+  `old_str` with `new_str`, storing the result in `dst`. The sources
+  may be views of a type other than that of `dst`.
 */
-template <class StringType>
-void string_replace(StringType &dst, const StringType &src, const StringType &old_str, const StringType &new_str)
+template <class DstStringType, class StringType>
+void string_replace(DstStringType &dst, const StringType &src, const StringType &old_str, const StringType &new_str)
 {
 
   if (old_str.size() == 0 || old_str.size() > src.size()) {
     /* Just copy -- there's nothing to replace */
-    dst = src;
+    dst.assign(src.begin(), src.size());
   }
   else if (old_str.size() == new_str.size()) {
     /* Special case when old_str and new_str are same length,
        we copy src to dst and the replace in-place. */
-    dst = src;
+    dst.assign(src.begin(), src.size());
 
     if (old_str.size() == 1) {
       /* Special case when old_str and new_str are both 1 character */
@@ -103,7 +105,7 @@ void string_replace(StringType &dst, const StringType &src, const StringType &ol
       }
     }
     else {
-      detail::string_inplace_replacer<StringType> replacer(dst, new_str);
+      detail::string_inplace_replacer<DstStringType, StringType> replacer(dst, new_str);
       detail::string_search(src, old_str, replacer);
     }
   }
@@ -116,7 +118,7 @@ void string_replace(StringType &dst, const StringType &src, const StringType &ol
 
     dst.resize((intptr_t)src.size() + delta);
 
-    detail::string_copy_replacer<StringType> replacer(dst, src, old_str, new_str);
+    detail::string_copy_replacer<DstStringType, StringType> replacer(dst, src, old_str, new_str);
     detail::string_search(src, old_str, replacer);
     replacer.finish();
   }
@@ -169,9 +171,46 @@ namespace nd {
   extern DYND_API callable string_rfind;
   extern DYND_API callable string_replace;
   extern DYND_API callable string_split;
+
+  /**
+   * Like ``string_split`` for a one-dimensional array of strings, but the
+   * pieces are ``string_view`` values. When the source is immutable they
+   * point into its data, which the result keeps alive, so none of the data is
+   * copied. Otherwise they point into one copy of all the strings.
+   */
+  extern DYND_API callable string_split_view;
+
+  /**
+   * Slices a one-dimensional array of strings to the bytes from ``start`` up
+   * to ``stop``, counting from the end when negative, as ``string_view``
+   * values. They point into the data of the source when it is immutable, and
+   * into one copy of the sliced bytes otherwise.
+   */
+  extern DYND_API callable string_slice;
+
+  /**
+   * Packs a one-dimensional array of strings into ``string_view`` values
+   * whose bytes are laid out one after another in a single buffer, owned by
+   * one memory block. This is for speed, not size: each view is still two
+   * words, more than a short ``string`` stored inline. In exchange, packing
+   * is one allocation, scans over the bytes read contiguous memory, and
+   * destroying the result frees one block rather than each string. Packing
+   * views drops the array they point into. The other string functions run
+   * on the result directly, and assigning it to ``string`` converts it back.
+   */
+  extern DYND_API callable string_pack;
+
   extern DYND_API callable string_startswith;
   extern DYND_API callable string_endswith;
   extern DYND_API callable string_contains;
 
+  /**
+   * Tells for each string of a one-dimensional array whether any of the
+   * needles in another one-dimensional array of strings occurs in it. The
+   * needles are built into an Aho-Corasick automaton, so each string is
+   * scanned once however many needles there are.
+   */
+  extern DYND_API callable string_contains_any;
+
 } // namespace dynd::nd
 } // namespace dynd
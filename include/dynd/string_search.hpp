@@ -5,6 +5,19 @@
 
 #pragma once
 
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <dynd/cpu_features.hpp>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef DYND_ISA_DISPATCH
+#include <immintrin.h>
+#endif
+
 ////////////////////////////////////////////////////////////
 // String algorithms
 
@@ -43,7 +56,7 @@ namespace detail {
     else {
       const char *s = haystack;
       while (s < haystack + n) {
-        void *candidate = memchr((void *)s, needle, n);
+        void *candidate = memchr((void *)s, needle, haystack + n - s);
         if (candidate == NULL) {
           return;
         }
@@ -59,7 +72,7 @@ namespace detail {
   template <class match_handler>
   void string_search_1char_reverse(const char *haystack, size_t n, char needle, match_handler &handle_match)
   {
-    for (size_t i = n - 1; i <= 0; --i) {
+    for (size_t i = n; i-- > 0;) {
       if (haystack[i] == needle) {
         if (handle_match(i)) {
           return;
@@ -68,8 +81,8 @@ namespace detail {
     }
   }
 
-  template <class StringType, class match_handler>
-  void string_search(const StringType &haystack, const StringType &needle, match_handler &handle_match)
+  template <class match_handler>
+  void string_search_scalar(const char *s, size_t n, const char *p, size_t m, match_handler &handle_match)
   {
     /*
       This is a mostly direct copy of the algorithm by Fredrik Lundh in
@@ -88,11 +101,6 @@ namespace detail {
       this is UTF-8. For example, we could skip over multi-byte
       sequences when a match fails, but this doesn't currently do that.
     */
-    const char *s = haystack.begin();
-    const char *p = needle.begin();
-    size_t n = haystack.size();
-    size_t m = needle.size();
-
     intptr_t w = n - m;
     if (w < 0) {
       return;
@@ -104,7 +112,7 @@ namespace detail {
         return;
       }
 
-      string_search_1char(haystack.begin(), n, needle.begin()[0], handle_match);
+      string_search_1char(s, n, p[0], handle_match);
       return;
     }
 
@@ -147,6 +155,7 @@ namespace detail {
             return;
           }
           i = i + mlast;
+          continue;
         }
         /* miss: check if next character is part of pattern */
         if (i < w && !bloom.has_char(ss[i + 1])) {
@@ -167,6 +176,146 @@ namespace detail {
     return;
   }
 
+  /*
+    Passes the matches found by a search of part of a haystack on to the
+    handler of the search of the whole, as positions in the whole.
+  */
+  template <class match_handler>
+  struct offset_match_handler {
+    match_handler &m_handle_match;
+    size_t m_offset;
+
+    offset_match_handler(match_handler &handle_match, size_t offset) : m_handle_match(handle_match), m_offset(offset)
+    {
+    }
+
+    bool operator()(const size_t match) { return m_handle_match(m_offset + match); }
+  };
+
+  /*
+    Checks the candidates of a block of haystack positions starting at `i`,
+    which are the set bits of `mask`, by comparing the bytes of the needle
+    between its first and last. Matches don't overlap, so any starting
+    before `next` are skipped. Returns true once the handler is done.
+  */
+  template <class match_handler>
+  bool string_search_candidates(const char *s, size_t i, uint32_t mask, const char *p, size_t m, size_t &next,
+                                match_handler &handle_match)
+  {
+    while (mask != 0) {
+      size_t k = i + ctz64(mask);
+      mask &= mask - 1;
+      if (k >= next && memcmp(s + k + 1, p + 1, m - 2) == 0) {
+        if (handle_match(k)) {
+          return true;
+        }
+        next = k + m;
+      }
+    }
+
+    return false;
+  }
+
+  /*
+    Finishes a block search with the scalar one, from position `i` to the
+    end of the haystack.
+  */
+  template <class match_handler>
+  void string_search_tail(const char *s, size_t n, const char *p, size_t m, size_t i, match_handler &handle_match)
+  {
+    if (i < n) {
+      offset_match_handler<match_handler> tail_handle_match(handle_match, i);
+      string_search_scalar(s + i, n - i, p, m, tail_handle_match);
+    }
+  }
+
+#ifdef __SSE2__
+  /*
+    Searches for a needle of at least two bytes 16 haystack positions at a
+    time, by comparing the first and last bytes of the needle against those
+    of all of the positions at once. Only the positions where both match are
+    compared in full, which for most needles is few of them. This is the
+    "generic SIMD" search described by Wojciech Mula.
+  */
+  template <class match_handler>
+  void string_search_sse2(const char *s, size_t n, const char *p, size_t m, match_handler &handle_match)
+  {
+    const __m128i first = _mm_set1_epi8(p[0]);
+    const __m128i last = _mm_set1_epi8(p[m - 1]);
+
+    size_t i = 0, next = 0;
+    for (; i + m + 15 <= n; i += 16) {
+      __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+      __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i + m - 1));
+      uint32_t mask = static_cast<uint32_t>(
+          _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(last, block_last))));
+      if (mask != 0 && string_search_candidates(s, i, mask, p, m, next, handle_match)) {
+        return;
+      }
+    }
+
+    string_search_tail(s, n, p, m, std::max(i, next), handle_match);
+  }
+#endif
+
+#ifdef DYND_ISA_DISPATCH
+  /*
+    The same search as `string_search_sse2`, 32 positions at a time.
+  */
+  template <class match_handler>
+  DYND_TARGET("avx2") void string_search_avx2(const char *s, size_t n, const char *p, size_t m,
+                                               match_handler &handle_match)
+  {
+    const __m256i first = _mm256_set1_epi8(p[0]);
+    const __m256i last = _mm256_set1_epi8(p[m - 1]);
+
+    size_t i = 0, next = 0;
+    for (; i + m + 31 <= n; i += 32) {
+      __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+      __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i + m - 1));
+      uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+          _mm256_and_si256(_mm256_cmpeq_epi8(first, block_first), _mm256_cmpeq_epi8(last, block_last))));
+      if (mask != 0 && string_search_candidates(s, i, mask, p, m, next, handle_match)) {
+        return;
+      }
+    }
+
+    string_search_tail(s, n, p, m, std::max(i, next), handle_match);
+  }
+#endif
+
+  /*
+    Calls `handle_match` with the position of each match of `needle` in
+    `haystack`, in order and not overlapping, until it returns true. Long
+    haystacks are searched a block of positions at a time with SIMD, and
+    short ones, or needles of a single byte, with the scalar search.
+  */
+  template <class StringType, class match_handler>
+  void string_search(const StringType &haystack, const StringType &needle, match_handler &handle_match)
+  {
+    const char *s = haystack.begin();
+    const char *p = needle.begin();
+    size_t n = haystack.size();
+    size_t m = needle.size();
+
+    if (m >= 2) {
+#ifdef DYND_ISA_DISPATCH
+      if (n >= 64 + m && cpu_supports(cpu_feature_avx2)) {
+        string_search_avx2(s, n, p, m, handle_match);
+        return;
+      }
+#endif
+#ifdef __SSE2__
+      if (n >= 32 + m) {
+        string_search_sse2(s, n, p, m, handle_match);
+        return;
+      }
+#endif
+    }
+
+    string_search_scalar(s, n, p, m, handle_match);
+  }
+
   template <class StringType, class match_handler>
   void string_search_reverse(const StringType &haystack, const StringType &needle, match_handler &handle_match)
   {
@@ -285,12 +434,12 @@ namespace detail {
     bool finish() { return m_found; }
   };
 
-  template <class StringType>
+  template <class DstStringType, class StringType>
   struct string_inplace_replacer {
-    StringType &m_dst;
+    DstStringType &m_dst;
     const StringType &m_new_str;
 
-    string_inplace_replacer(StringType &dst, const StringType &new_str) : m_dst(dst), m_new_str(new_str) {}
+    string_inplace_replacer(DstStringType &dst, const StringType &new_str) : m_dst(dst), m_new_str(new_str) {}
 
     bool operator()(const size_t match)
     {
@@ -299,7 +448,7 @@ namespace detail {
     }
   };
 
-  template <class StringType>
+  template <class DstStringType, class StringType>
   struct string_copy_replacer {
     char *m_dst;
     const char *m_src;
@@ -309,7 +458,8 @@ namespace detail {
     const char *m_new_str;
     size_t m_new_str_size;
 
-    string_copy_replacer(StringType &dst, const StringType &src, const StringType &old_str, const StringType &new_str)
+    string_copy_replacer(DstStringType &dst, const StringType &src, const StringType &old_str,
+                         const StringType &new_str)
         : m_dst(dst.begin()), m_src(src.begin()), m_src_size(src.size()), m_last_src_start(0),
           m_old_str_size(old_str.size()), m_new_str(new_str.begin()), m_new_str_size(new_str.size())
     {
@@ -331,16 +481,16 @@ namespace detail {
     void finish() { DYND_MEMCPY(m_dst, m_src + m_last_src_start, m_src_size - m_last_src_start); }
   };
 
-  template <class StringType>
+  template <class DstStringType, class StringType>
   struct string_splitter {
-    StringType *m_dst;
+    DstStringType *m_dst;
     const char *m_src;
     size_t m_src_size;
     size_t m_i;
     size_t m_last_src_start;
     size_t m_split_size;
 
-    string_splitter(StringType *dst, const StringType &src, const StringType &split)
+    string_splitter(DstStringType *dst, const StringType &src, const StringType &split)
         : m_dst(dst), m_src(src.begin()), m_src_size(src.size()), m_i(0), m_last_src_start(0),
           m_split_size(split.size())
     {
@@ -365,5 +515,156 @@ namespace detail {
     }
   };
 
+  /*
+    Appends the pieces between the matches to a container of views of the
+    source, so splitting is a single pass that copies none of the data.
+  */
+  template <class StringType, class ContainerType>
+  struct string_view_splitter {
+    ContainerType &m_dst;
+    const char *m_src;
+    size_t m_src_size;
+    size_t m_last_src_start;
+    size_t m_split_size;
+
+    string_view_splitter(ContainerType &dst, const StringType &src, const StringType &split)
+        : m_dst(dst), m_src(src.begin()), m_src_size(src.size()), m_last_src_start(0), m_split_size(split.size())
+    {
+    }
+
+    bool operator()(const size_t match)
+    {
+      m_dst.emplace_back(m_src + m_last_src_start, match - m_last_src_start);
+      m_last_src_start = match + m_split_size;
+
+      return false;
+    }
+
+    void finish() { m_dst.emplace_back(m_src + m_last_src_start, m_src_size - m_last_src_start); }
+  };
+
+  /*
+    An Aho-Corasick automaton for a set of needles, which tells whether any
+    of them occurs in a string in a single pass over its bytes, however many
+    needles there are. Empty needles match nothing, as in `string_contains`.
+
+    The bytes that occur in the needles are numbered as classes from one,
+    with every other byte in class zero, so that the transition table has a
+    column per class rather than per byte, and stays small enough to be
+    cached for dozens of needles. Each transition is the offset of the row
+    of the next state, with the top bit set if that state ends a needle.
+  */
+  class multi_string_searcher {
+    static const uint32_t match_bit = 0x80000000u;
+
+    uint16_t m_classes[256];
+    uint32_t m_class_count;
+    std::vector<uint32_t> m_transitions;
+
+  public:
+    template <class ContainerType>
+    explicit multi_string_searcher(const ContainerType &needles) : m_class_count(1)
+    {
+      memset(m_classes, 0, sizeof(m_classes));
+      for (const auto &needle : needles) {
+        for (const char *c = needle.begin(); c != needle.end(); ++c) {
+          uint16_t &cls = m_classes[static_cast<unsigned char>(*c)];
+          if (cls == 0) {
+            cls = static_cast<uint16_t>(m_class_count++);
+          }
+        }
+      }
+
+      /* Build the trie of the needles, with zero for no child */
+      uint32_t k = m_class_count;
+      std::vector<uint32_t> goto_fn(k, 0);
+      std::vector<char> match(1, false);
+      for (const auto &needle : needles) {
+        if (needle.size() == 0) {
+          continue;
+        }
+
+        uint32_t state = 0;
+        for (const char *c = needle.begin(); c != needle.end(); ++c) {
+          uint32_t cls = m_classes[static_cast<unsigned char>(*c)];
+          uint32_t child = goto_fn[state * k + cls];
+          if (child == 0) {
+            child = static_cast<uint32_t>(match.size());
+            goto_fn[state * k + cls] = child;
+            goto_fn.resize(goto_fn.size() + k, 0);
+            match.push_back(false);
+          }
+          state = child;
+        }
+        match[state] = true;
+      }
+
+      /*
+        Visit the states breadth first, so that the failure state of each,
+        which is shallower, is done before it. A missing child becomes the
+        transition of the failure state, which turns the trie into a DFA.
+      */
+      size_t state_count = match.size();
+      if (state_count >= match_bit / k) {
+        throw std::runtime_error("too many needles for a dynd multi_string_searcher");
+      }
+      std::vector<uint32_t> fail(state_count, 0);
+      std::vector<uint32_t> queue;
+      queue.reserve(state_count);
+      for (uint32_t cls = 0; cls < k; ++cls) {
+        if (goto_fn[cls] != 0) {
+          queue.push_back(goto_fn[cls]);
+        }
+      }
+      for (size_t i = 0; i < queue.size(); ++i) {
+        uint32_t state = queue[i];
+        match[state] = match[state] || match[fail[state]];
+        for (uint32_t cls = 0; cls < k; ++cls) {
+          uint32_t child = goto_fn[state * k + cls];
+          uint32_t fail_child = goto_fn[fail[state] * k + cls];
+          if (child != 0) {
+            fail[child] = fail_child;
+            queue.push_back(child);
+          }
+          else {
+            goto_fn[state * k + cls] = fail_child;
+          }
+        }
+      }
+
+      m_transitions.resize(goto_fn.size());
+      for (size_t i = 0; i < goto_fn.size(); ++i) {
+        m_transitions[i] = goto_fn[i] * k | (match[goto_fn[i]] ? match_bit : 0);
+      }
+    }
+
+    bool contains(const char *begin, const char *end) const
+    {
+      const uint32_t *transitions = m_transitions.data();
+      uint32_t row = 0;
+      for (const char *c = begin; c != end;) {
+        if (row == 0) {
+          /*
+            In the start state, skip the bytes that begin no needle. Unlike
+            the steps of the automaton, these lookups don't depend on each
+            other, and in most text they are the majority of the bytes.
+          */
+          while (transitions[m_classes[static_cast<unsigned char>(*c)]] == 0) {
+            if (++c == end) {
+              return false;
+            }
+          }
+        }
+
+        row = transitions[row + m_classes[static_cast<unsigned char>(*c++)]];
+        if (row & match_bit) {
+          return true;
+        }
+      }
+
+      return false;
+    }
+  };
+
 } // namespace detail
 } // namespace nd
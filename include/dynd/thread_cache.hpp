@@ -0,0 +1,68 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <type_traits>
+
+namespace dynd {
+namespace detail {
+
+  /**
+   * Memory that each thread keeps for reuse, as a zero-initialized ``T``,
+   * which ``Release`` frees when the thread exits.
+   *
+   * The cache itself is trivially destructible, so it stays readable while
+   * the thread exits, e.g. from the destructors of static objects that run
+   * after it was released. Those see ``is_released()`` and must not keep
+   * anything more in it. The releaser is only registered with the thread
+   * once something is kept, by calling ``keep()``.
+   */
+  template <typename T, void (*Release)(T &)>
+  class thread_cache {
+    static_assert(std::is_trivially_destructible<T>::value, "a thread cache must be trivially destructible");
+
+    struct cache_type {
+      T value;
+      bool released;
+    };
+
+    struct releaser {
+      ~releaser() {
+        Release(s_cache.value);
+        s_cache.released = true;
+      }
+    };
+
+    static thread_local cache_type s_cache;
+    static thread_local releaser s_releaser;
+
+  public:
+    static bool is_released() { return s_cache.released; }
+
+    /**
+     * The cache of this thread, for looking up or taking what it holds.
+     */
+    static T &get() { return s_cache.value; }
+
+    /**
+     * The cache of this thread, for keeping something in it, which makes sure
+     * it is released when the thread exits. Must not be called once the cache
+     * has been released.
+     */
+    static T &keep() {
+      static_cast<void>(&s_releaser);
+      return s_cache.value;
+    }
+  };
+
+  template <typename T, void (*Release)(T &)>
+  thread_local typename thread_cache<T, Release>::cache_type thread_cache<T, Release>::s_cache;
+
+  template <typename T, void (*Release)(T &)>
+  thread_local typename thread_cache<T, Release>::releaser thread_cache<T, Release>::s_releaser;
+
+} // namespace dynd::detail
+} // namespace dynd
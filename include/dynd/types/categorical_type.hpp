@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include <dynd/array.hpp>
 #include <dynd/type.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
@@ -19,6 +21,11 @@ struct assign_to_same_category_type;
 
 namespace dynd {
 namespace ndt {
+  namespace detail {
+
+    class categorical_hash_index;
+
+  } // namespace dynd::ndt::detail
 
   class DYND_API categorical_type : public base_type {
     // The data type of the category
@@ -31,6 +38,8 @@ namespace ndt {
     nd::array m_category_index_to_value;
     // mapping from values to category indices
     nd::array m_value_to_category_index;
+    // hash table from category data to values
+    std::shared_ptr<const detail::categorical_hash_index> m_index;
 
   public:
     categorical_type(type_id_t new_id, const nd::array &categories, bool presorted = false);
@@ -59,6 +68,15 @@ namespace ndt {
     uint32_t get_value_from_category(const char *category_arrmeta, const char *category_data) const;
     uint32_t get_value_from_category(const nd::array &category) const;
 
+    /**
+     * Looks up the values of ``count`` categories of the category type, each
+     * ``src_stride`` apart, and writes them as the storage type ``dst_stride``
+     * apart. Every lookup is a probe of a hash table, with no dispatch per
+     * element.
+     */
+    void get_values_from_categories(char *dst, intptr_t dst_stride, const char *src_arrmeta, const char *src,
+                                    intptr_t src_stride, size_t count) const;
+
     const char *get_category_data_from_value(uint32_t value) const {
       if (value >= get_category_count()) {
         throw std::runtime_error("category value is out of bounds");
@@ -12,7 +12,10 @@
 #define DYND_INT8_NA (std::numeric_limits<int8_t>::min())
 #define DYND_INT16_NA (std::numeric_limits<int16_t>::min())
 #define DYND_INT32_NA (std::numeric_limits<int32_t>::min())
+#define DYND_UINT8_NA (std::numeric_limits<uint8_t>::max())
+#define DYND_UINT16_NA (std::numeric_limits<uint16_t>::max())
 #define DYND_UINT32_NA (std::numeric_limits<uint32_t>::max())
+#define DYND_UINT64_NA (std::numeric_limits<uint64_t>::max())
 #define DYND_INT64_NA (std::numeric_limits<int64_t>::min())
 #define DYND_INT128_NA (std::numeric_limits<int128>::min())
 #define DYND_FLOAT16_NA_AS_UINT (0x7e0au)
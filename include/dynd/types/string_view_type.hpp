@@ -0,0 +1,130 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+// The string_view type refers to UTF-8 bytes held by another memory block
+//
+
+#pragma once
+
+#include <dynd/buffer.hpp>
+#include <dynd/type.hpp>
+#include <dynd/types/base_string_type.hpp>
+#include <dynd/types/string_type.hpp>
+
+namespace dynd {
+
+/**
+ * A range of bytes that belongs to someone else, which is the data of the
+ * ``string_view`` type. Views are two words and are copied without touching
+ * the bytes, so slicing or splitting a string into views allocates nothing
+ * per piece.
+ */
+class string_view {
+  const char *m_begin;
+  size_t m_size;
+
+public:
+  string_view() : m_begin(NULL), m_size(0) {}
+
+  string_view(const char *begin, size_t size) : m_begin(begin), m_size(size) {}
+
+  string_view(const string &s) : m_begin(s.data()), m_size(s.size()) {}
+
+  const char *data() const { return m_begin; }
+  size_t size() const { return m_size; }
+
+  const char *begin() const { return m_begin; }
+  const char *end() const { return m_begin + m_size; }
+
+  bool empty() const { return m_size == 0; }
+
+  bool operator==(const string_view &rhs) const {
+    return m_size == rhs.m_size && memcmp(m_begin, rhs.m_begin, m_size) == 0;
+  }
+
+  bool operator!=(const string_view &rhs) const { return !operator==(rhs); }
+};
+
+struct DYNDT_API string_view_type_arrmeta {
+  /**
+   * A reference to the memory block which holds the bytes that the views
+   * point into, which may be the data of another array.
+   */
+  nd::memory_block blockref;
+};
+
+namespace ndt {
+
+  /**
+   * A UTF-8 string type whose values point into memory kept alive by the
+   * blockref in its arrmeta, like the elements of a var dimension. Assigning
+   * to it copies the bytes into that block, while functions like
+   * ``nd::string_split_view`` and ``nd::string_slice`` make views into the
+   * data of their source without copying.
+   */
+  class DYNDT_API string_view_type : public base_string_type {
+  public:
+    typedef string_view data_type;
+
+    string_view_type(type_id_t id)
+        : base_string_type(id, sizeof(string_view), alignof(string_view), type_flag_zeroinit | type_flag_blockref,
+                           sizeof(string_view_type_arrmeta)) {}
+
+    string_encoding_t get_encoding() const { return string_encoding_utf_8; }
+
+    void get_string_range(const char **out_begin, const char **out_end, const char *arrmeta, const char *data) const;
+    void set_from_utf8_string(const char *arrmeta, char *dst, const char *utf8_begin, const char *utf8_end,
+                              const eval::eval_context *ectx) const;
+
+    void print_data(std::ostream &o, const char *arrmeta, const char *data) const;
+
+    void print_type(std::ostream &o) const;
+
+    bool is_unique_data_owner(const char *arrmeta) const;
+    type get_canonical_type() const;
+
+    void get_shape(intptr_t ndim, intptr_t i, intptr_t *out_shape, const char *arrmeta, const char *data) const;
+
+    bool is_lossless_assignment(const type &dst_tp, const type &src_tp) const;
+
+    bool operator==(const base_type &rhs) const;
+
+    void arrmeta_default_construct(char *arrmeta, bool blockref_alloc) const;
+    void arrmeta_copy_construct(char *dst_arrmeta, const char *src_arrmeta,
+                                const nd::memory_block &embedded_reference) const;
+    void arrmeta_reset_buffers(char *arrmeta) const;
+    void arrmeta_finalize_buffers(char *arrmeta) const;
+    void arrmeta_destruct(char *arrmeta) const;
+    void arrmeta_debug_print(const char *arrmeta, std::ostream &o, const std::string &indent) const;
+
+    /**
+     * Copies ``size`` bytes into the memory block of the arrmeta, and points
+     * the view at ``dst`` to them.
+     */
+    static void assign(const char *arrmeta, char *dst, const char *data, size_t size);
+
+    /**
+     * Allocates ``size`` bytes in the memory block of the arrmeta and points
+     * the view at ``dst`` to them, returning them to be filled in.
+     */
+    static char *resize(const char *arrmeta, char *dst, size_t size);
+  };
+
+  template <>
+  struct id_of<string_view> : std::integral_constant<type_id_t, string_view_id> {};
+
+  template <>
+  struct id_of<string_view_type> : std::integral_constant<type_id_t, string_view_id> {};
+
+  template <>
+  struct traits<string_view> {
+    static const size_t ndim = 0;
+
+    static const bool is_same_layout = true;
+
+    static type equivalent() { return make_type<string_view_type>(); }
+  };
+
+} // namespace dynd::ndt
+} // namespace dynd
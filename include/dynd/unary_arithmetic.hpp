@@ -31,7 +31,9 @@ nd::callable make_unary_arithmetic() {
   dispatcher.insert(nd::get_elwise(ndt::type("(Fixed * Any) -> Any")));
   dispatcher.insert(nd::get_elwise(ndt::type("(var * Any) -> Any")));
 
-  return nd::make_callable<nd::multidispatch_callable<1>>(tp, dispatcher);
+  nd::callable f = nd::make_callable<nd::multidispatch_callable<1>>(tp, dispatcher);
+  f->set_thread_safe(true);
+  return f;
 }
 
 } // anonymous namespace
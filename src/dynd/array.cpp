@@ -133,8 +133,9 @@ nd::array nd::array::at_array(intptr_t nindices, const irange *indices, bool col
   } else {
     ndt::type this_dt = get_type();
     ndt::type dt = get_type()->apply_linear_index(nindices, indices, 0, this_dt, collapse_leading);
-    array result = make_array(dt, data(), get_owner() ? get_owner() : *this, get_flags());
-    char *data = result.data();
+    // Indexing does not write, so read-only arrays are indexed through their const data
+    array result = make_array(dt, const_cast<char *>(cdata()), get_owner() ? get_owner() : *this, get_flags());
+    char *data = const_cast<char *>(result.cdata());
     intptr_t offset =
         get_type()->apply_linear_index(nindices, indices, get()->metadata(), dt, result->metadata(), *this, 0, this_dt,
                                        collapse_leading, &data, const_cast<memory_block &>(result.get_owner()));
@@ -886,39 +887,90 @@ nd::array nd::reshape(const nd::array &a, const nd::array &shape) {
                                       NULL);
 }
 
-nd::array nd::memmap(const std::string &DYND_UNUSED(filename), intptr_t DYND_UNUSED(begin), intptr_t DYND_UNUSED(end),
-                     uint32_t DYND_UNUSED(access)) {
-  throw std::runtime_error("nd::memmap is not yet implemented");
+/**
+ * Makes an array of the data of a memory-mapped file, with the default
+ * arrmeta of its type.
+ */
+static nd::array make_memmap_array(const ndt::type &tp, char *data, const nd::memory_block &mm, uint32_t access) {
+  nd::array res = nd::make_array(tp, data, mm, access | nd::read_access_flag);
+  if (tp.get_arrmeta_size() > 0) {
+    tp.extended()->arrmeta_default_construct(res.get()->metadata(), true);
+  }
+
+  return res;
+}
+
+static nd::memmap_memory_block *get_memmap_memory_block(const nd::array &a) {
+  nd::memmap_memory_block *res = dynamic_cast<nd::memmap_memory_block *>(a.get_data_memblock().get());
+  if (res == NULL) {
+    throw invalid_argument("the array is not a memory-mapped file");
+  }
+
+  return res;
+}
+
+nd::array nd::memmap(const std::string &filename, intptr_t begin, intptr_t end, uint32_t access) {
+  if (access == 0) {
+    access = nd::read_access_flag;
+  }
+
+  char *mm_ptr = NULL;
+  intptr_t mm_size = 0;
+  memory_block mm = make_memory_block<memmap_memory_block>(filename, access, &mm_ptr, &mm_size, begin, end);
+  return make_memmap_array(ndt::make_fixed_dim(mm_size, ndt::make_type<uint8_t>()), mm_ptr, mm, access);
+}
+
+nd::array nd::memmap(const std::string &filename, const ndt::type &tp, intptr_t offset, uint32_t access,
+                     uint32_t flags) {
+  // A leading ``Fixed`` dimension is sized to fit the file
+  bool fit = tp.get_id() == fixed_dim_kind_id;
+  const ndt::type &data_tp = fit ? tp.extended<ndt::base_dim_type>()->get_element_type() : tp;
+  if (data_tp.is_symbolic() || data_tp.is_expression() ||
+      (data_tp.get_flags() & (type_flag_construct | type_flag_blockref | type_flag_destructor)) != 0) {
+    stringstream ss;
+    ss << "cannot memory map a file as type " << tp << ", only types with all of their data in place can be";
+    throw type_error(ss.str());
+  }
+  if (offset < 0 || offset % data_tp.get_data_alignment() != 0) {
+    stringstream ss;
+    ss << "cannot memory map a file as type " << tp << " from offset " << offset
+       << ", which is not a multiple of its alignment " << data_tp.get_data_alignment();
+    throw invalid_argument(ss.str());
+  }
+
+  if (access == 0) {
+    access = nd::read_access_flag;
+  }
 
-  /*
-    // ToDo: This was based on the variable-sized bytes type, which changed.
+  char *mm_ptr = NULL;
+  intptr_t mm_size = 0;
+  intptr_t data_size = data_tp.get_default_data_size();
+  intptr_t end = fit ? std::numeric_limits<intptr_t>::max() : offset + data_size;
+  memory_block mm = make_memory_block<memmap_memory_block>(filename, access, &mm_ptr, &mm_size, offset, end, flags);
 
-    if (access == 0) {
-      access = nd::default_access_flags;
+  if (fit) {
+    if (data_size == 0 || mm_size % data_size != 0) {
+      stringstream ss;
+      ss << "cannot memory map " << mm_size << " bytes of file \"" << filename << "\" as type " << tp
+         << ", which is not a whole number of elements";
+      throw invalid_argument(ss.str());
     }
+    return make_memmap_array(ndt::make_fixed_dim(mm_size / data_size, data_tp), mm_ptr, mm, access);
+  }
 
-    char *mm_ptr = NULL;
-    intptr_t mm_size = 0;
-    // Create a memory mapped memblock of the file
-    intrusive_ptr<memory_block_data> mm = make_memmap_memory_block(filename, access, &mm_ptr, &mm_size, begin, end);
-    // Create a bytes array referring to the data.
-    ndt::type dt = ndt::make_type<ndt::bytes_type>(1);
-    char *data_ptr = 0;
-    nd::array result(make_array(dt.extended()->get_arrmeta_size(), dt.get_data_size(),
-                                             dt.get_data_alignment(), &data_ptr));
-    // Set the bytes extents
-    reinterpret_cast<bytes *>(data_ptr)->assign(mm_ptr, mm_size);
-    // Set the array arrmeta
-    array_preamble *ndo = result.get();
-    ndo->set_type(dt);
-    ndo->flags = access;
-    // Set the bytes arrmeta, telling the system
-    // about the memmapped memblock
-    ndo_meta->blockref = mm.release();
-    return result;
-  */
+  if (mm_size < data_size) {
+    stringstream ss;
+    ss << "cannot memory map file \"" << filename << "\" as type " << tp << ", it has " << mm_size
+       << " bytes from offset " << offset << " but the type needs " << data_size;
+    throw invalid_argument(ss.str());
+  }
+  return make_memmap_array(data_tp, mm_ptr, mm, access);
 }
 
+void nd::memmap_flush(const array &a, bool wait) { get_memmap_memory_block(a)->flush(wait); }
+
+void nd::memmap_advise(const array &a, memmap_advice advice) { get_memmap_memory_block(a)->advise(advice); }
+
 nd::array nd::combine_into_tuple(size_t field_count, const array *field_values) {
   // Make the pointer types
   vector<ndt::type> field_types(field_count);
@@ -38,7 +38,24 @@ nd::callable make_assign() {
   auto dispatcher =
       nd::callable::make_all<_bind<assign_error_mode, nd::assign_callable>::type, numeric_types, numeric_types>(
           func_ptr);
+  dispatcher.insert({nd::make_callable<nd::categorical_assign_callable<ndt::bool_kind_type>>(),
+                     nd::make_callable<nd::categorical_assign_callable<ndt::int_kind_type>>(),
+                     nd::make_callable<nd::categorical_assign_callable<ndt::uint_kind_type>>(),
+                     nd::make_callable<nd::categorical_assign_callable<ndt::float_kind_type>>(),
+                     nd::make_callable<nd::categorical_assign_callable<ndt::string_kind_type>>(),
+                     nd::make_callable<nd::categorical_assign_callable<ndt::fixed_bytes_kind_type>>(),
+                     nd::make_callable<nd::categorical_assign_callable<ndt::fixed_string_kind_type>>(),
+                     nd::make_callable<nd::categorical_to_value_assign_callable<ndt::bool_kind_type>>(),
+                     nd::make_callable<nd::categorical_to_value_assign_callable<ndt::int_kind_type>>(),
+                     nd::make_callable<nd::categorical_to_value_assign_callable<ndt::uint_kind_type>>(),
+                     nd::make_callable<nd::categorical_to_value_assign_callable<ndt::float_kind_type>>(),
+                     nd::make_callable<nd::categorical_to_value_assign_callable<ndt::string_kind_type>>(),
+                     nd::make_callable<nd::categorical_to_value_assign_callable<ndt::fixed_bytes_kind_type>>(),
+                     nd::make_callable<nd::categorical_to_value_assign_callable<ndt::fixed_string_kind_type>>()});
   dispatcher.insert(nd::make_callable<nd::assign_callable<dynd::string, dynd::string>>());
+  dispatcher.insert(nd::make_callable<nd::assign_callable<dynd::string, dynd::string_view>>());
+  dispatcher.insert(nd::make_callable<nd::assign_callable<dynd::string_view, dynd::string>>());
+  dispatcher.insert(nd::make_callable<nd::assign_callable<dynd::string_view, dynd::string_view>>());
   dispatcher.insert(nd::make_callable<nd::assign_callable<dynd::bytes, dynd::bytes>>());
   dispatcher.insert(nd::make_callable<nd::assign_callable<ndt::fixed_bytes_type, ndt::fixed_bytes_type>>());
   dispatcher.insert(nd::make_callable<nd::assign_callable<ndt::fixed_string_type, ndt::fixed_string_type>>());
@@ -103,7 +120,9 @@ nd::callable make_assign() {
   dispatcher.insert({nd::get_elwise(ndt::type("(Dim) -> Scalar")), nd::get_elwise(ndt::type("(Scalar) -> Dim")),
                      nd::get_elwise(ndt::type("(Dim) -> Dim"))});
 
-  return nd::make_callable<nd::multidispatch_callable<2>>(self_tp, dispatcher);
+  nd::callable f = nd::make_callable<nd::multidispatch_callable<2>>(self_tp, dispatcher);
+  f->set_thread_safe(true);
+  return f;
 }
 
 } // anonymous namespace
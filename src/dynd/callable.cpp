@@ -13,6 +13,7 @@
 #include <dynd/pointer.hpp>
 #include <dynd/random.hpp>
 #include <dynd/range.hpp>
+#include <dynd/shortvector.hpp>
 #include <dynd/statistics.hpp>
 
 using namespace std;
@@ -71,63 +72,58 @@ void nd::detail::check_arg(const base_callable *self, intptr_t i, const ndt::typ
   }
 }
 
-nd::array nd::callable::call(size_t narg, const array *args, size_t nkwd,
-                             const pair<const char *, array> *unordered_kwds) const {
-  std::map<std::string, ndt::type> tp_vars;
-
-  if (!m_ptr->is_arg_variadic() && (narg < m_ptr->get_narg())) {
-    std::stringstream ss;
-    ss << "callable expected " << m_ptr->get_narg() << " positional arguments, but received " << narg;
-    throw std::invalid_argument(ss.str());
-  }
-
-  unique_ptr<ndt::type[]> args_tp(new ndt::type[narg]);
-  unique_ptr<const char *[]> args_arrmeta(new const char *[narg]);
-  unique_ptr<array[]> kwds(new array[narg + m_ptr->get_nkwd()]);
+namespace {
 
+/**
+ * Matches the positional and keyword arguments of a call against the signature
+ * of the callable. This fills in the argument types and arrmeta, the keyword
+ * arguments in signature order (with missing options set to NA), an explicitly
+ * requested destination, and the type variables bound by the match.
+ */
+void bind_args(const nd::base_callable *self, size_t &narg, const nd::array *args, size_t &nkwd,
+               const pair<const char *, nd::array> *unordered_kwds, ndt::type *args_tp, const char **args_arrmeta,
+               nd::array *kwds, nd::array &dst, std::map<std::string, ndt::type> &tp_vars) {
   size_t j = 0;
-  if (m_ptr->is_arg_variadic()) {
+  if (self->is_arg_variadic()) {
     for (size_t i = 0; i < narg; ++i) {
-      detail::check_arg(m_ptr, i, args[i].get_type(), args[i]->metadata(), tp_vars);
+      nd::detail::check_arg(self, i, args[i].get_type(), args[i]->metadata(), tp_vars);
 
       args_tp[i] = args[i].get_type();
       args_arrmeta[i] = args[i]->metadata();
     }
   } else {
     size_t i = 0;
-    for (; i < m_ptr->get_narg(); ++i) {
-      detail::check_arg(m_ptr, i, args[i].get_type(), args[i]->metadata(), tp_vars);
+    for (; i < self->get_narg(); ++i) {
+      nd::detail::check_arg(self, i, args[i].get_type(), args[i]->metadata(), tp_vars);
 
       args_tp[i] = args[i].get_type();
       args_arrmeta[i] = args[i]->metadata();
     }
 
     // ...
-    if (!m_ptr->is_kwd_variadic() && (narg - m_ptr->get_narg()) > m_ptr->get_nkwd()) {
+    if (!self->is_kwd_variadic() && (narg - self->get_narg()) > self->get_nkwd()) {
       throw std::invalid_argument("too many extra positional arguments");
     }
 
-    for (; narg > m_ptr->get_narg(); ++i, --narg, ++j, ++nkwd) {
+    for (; narg > self->get_narg(); ++i, --narg, ++j, ++nkwd) {
       kwds[j] = args[i];
     }
   }
 
-  array dst;
-
-  const std::vector<std::pair<ndt::type, std::string>> kwd_tp = m_ptr->get_kwd_types();
+  const std::vector<std::pair<ndt::type, std::string>> &kwd_tp = self->get_kwd_types();
   for (; j < nkwd; ++j, ++unordered_kwds) {
-    intptr_t k = m_ptr->get_kwd_index(unordered_kwds->first);
+    intptr_t k = self->get_kwd_index(unordered_kwds->first);
 
     if (k == -1) {
-      if (detail::is_special_kwd(dst, unordered_kwds->first, unordered_kwds->second)) {
+      if (nd::detail::is_special_kwd(dst, unordered_kwds->first, unordered_kwds->second)) {
       } else {
         std::stringstream ss;
         ss << "passed an unexpected keyword \"" << unordered_kwds->first << "\" to callable with type "
-           << m_ptr->get_type();
+           << self->get_type();
         throw std::invalid_argument(ss.str());
       }
     } else {
-      array &value = kwds[k];
+      nd::array &value = kwds[k];
       if (!value.is_null()) {
         std::stringstream ss;
         ss << "callable passed keyword \"" << unordered_kwds->first << "\" more than once";
@@ -152,35 +148,55 @@ nd::array nd::callable::call(size_t narg, const array *args, size_t nkwd,
 
   // Validate the destination type, if it was provided
   if (!dst.is_null()) {
-    if (!m_ptr->get_ret_type().match(dst.get_type(), tp_vars)) {
+    if (!self->get_ret_type().match(dst.get_type(), tp_vars)) {
       std::stringstream ss;
       ss << "provided \"dst\" type " << dst.get_type() << " does not match callable return type "
-         << m_ptr->get_ret_type();
+         << self->get_ret_type();
       throw std::invalid_argument(ss.str());
     }
   }
 
-  for (intptr_t j : m_ptr->get_option_kwd_indices()) {
+  for (intptr_t j : self->get_option_kwd_indices()) {
     if (kwds[j].is_null()) {
       ndt::type actual_tp = ndt::substitute(kwd_tp[j].first, tp_vars, false);
       if (actual_tp.is_symbolic()) {
         actual_tp = ndt::make_type<ndt::option_type>(ndt::make_type<void>());
       }
-      kwds[j] = assign_na({{"dst_tp", actual_tp}});
+      kwds[j] = nd::assign_na({{"dst_tp", actual_tp}});
       ++nkwd;
     }
   }
 
-  if (nkwd < m_ptr->get_nkwd()) {
+  if (nkwd < self->get_nkwd()) {
     std::stringstream ss;
     // TODO: Provide the missing keyword parameter names in this error
     //       message
     ss << "callable requires keyword parameters that were not provided. "
           "callable signature "
-       << m_ptr->get_type();
+       << self->get_type();
+    throw std::invalid_argument(ss.str());
+  }
+}
+
+} // anonymous namespace
+
+nd::array nd::callable::call(size_t narg, const array *args, size_t nkwd,
+                             const pair<const char *, array> *unordered_kwds) const {
+  std::map<std::string, ndt::type> tp_vars;
+
+  if (!m_ptr->is_arg_variadic() && (narg < m_ptr->get_narg())) {
+    std::stringstream ss;
+    ss << "callable expected " << m_ptr->get_narg() << " positional arguments, but received " << narg;
     throw std::invalid_argument(ss.str());
   }
 
+  shortvector<ndt::type, 4> args_tp(narg);
+  shortvector<const char *, 4> args_arrmeta(narg);
+  shortvector<array, 4> kwds(narg + m_ptr->get_nkwd());
+
+  array dst;
+  bind_args(m_ptr, narg, args, nkwd, unordered_kwds, args_tp.get(), args_arrmeta.get(), kwds.get(), dst, tp_vars);
+
   ndt::type dst_tp;
   if (dst.is_null()) {
     dst_tp = m_ptr->get_ret_type();
@@ -191,3 +207,47 @@ nd::array nd::callable::call(size_t narg, const array *args, size_t nkwd,
   m_ptr->call(dst_tp, dst->metadata(), &dst, narg, args_tp.get(), args_arrmeta.get(), args, nkwd, kwds.get(), tp_vars);
   return dst;
 }
+
+nd::prepared_callable nd::callable::prepare(size_t narg, const array *args, size_t nkwd,
+                                            const pair<const char *, array> *unordered_kwds) const {
+  std::map<std::string, ndt::type> tp_vars;
+
+  if (!m_ptr->is_arg_variadic() && (narg < m_ptr->get_narg())) {
+    std::stringstream ss;
+    ss << "callable expected " << m_ptr->get_narg() << " positional arguments, but received " << narg;
+    throw std::invalid_argument(ss.str());
+  }
+
+  shortvector<ndt::type, 4> args_tp(narg);
+  shortvector<const char *, 4> args_arrmeta(narg);
+  shortvector<array, 4> kwds(narg + m_ptr->get_nkwd());
+
+  array dst;
+  bind_args(m_ptr, narg, args, nkwd, unordered_kwds, args_tp.get(), args_arrmeta.get(), kwds.get(), dst, tp_vars);
+
+  std::shared_ptr<detail::resolved_call> resolved = m_ptr->resolve_cached(
+      dst.is_null() ? m_ptr->get_ret_type() : dst.get_type(), narg, args_tp.get(), nkwd, kwds.get(), tp_vars);
+  if (dst.is_null()) {
+    dst = empty(resolved->resolved_dst_tp);
+  }
+
+  return prepared_callable(*this, resolved, dst, narg, args);
+}
+
+nd::prepared_callable nd::callable::prepare(const std::initializer_list<array> &args,
+                                            const std::initializer_list<std::pair<const char *, array>> &kwds) const {
+  return prepare(args.size(), args.begin(), kwds.size(), kwds.begin());
+}
+
+nd::prepared_callable::prepared_callable(const callable &f, const std::shared_ptr<detail::resolved_call> &resolved,
+                                         const array &dst, size_t narg, const array *args)
+    : m_callable(f), m_resolved(resolved), m_dst(dst), m_args(args, args + narg),
+      m_kb(new kernel_builder(resolved->cg.get())) {
+  shortvector<const char *, 4> args_arrmeta(narg);
+  for (size_t i = 0; i < narg; ++i) {
+    args_arrmeta[i] = m_args[i]->metadata();
+  }
+
+  (*m_kb)(kernel_request_call, nullptr, m_dst->metadata(), narg, args_arrmeta.get());
+  m_fn = m_kb->get()->get_function<kernel_call_t>();
+}
@@ -9,19 +9,123 @@
 using namespace std;
 using namespace dynd;
 
+namespace {
+
+std::atomic<size_t> resolve_cache_generation(0);
+
+} // anonymous namespace
+
+std::shared_ptr<nd::detail::resolved_call> nd::detail::resolve_cache::find(const ndt::type &dst_tp, size_t nsrc,
+                                                                           const ndt::type *src_tp, size_t nkwd,
+                                                                           const array *kwds) {
+  size_t gen = generation();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (const std::shared_ptr<resolved_call> &entry : m_entries) {
+    if (entry->generation != gen || entry->src_tp.size() != nsrc || entry->kwds.size() != nkwd ||
+        entry->dst_tp != dst_tp) {
+      continue;
+    }
+
+    bool match = true;
+    for (size_t i = 0; match && i < nsrc; ++i) {
+      match = entry->src_tp[i] == src_tp[i];
+    }
+    for (size_t i = 0; match && i < nkwd; ++i) {
+      if (kwds[i].is_null()) {
+        match = entry->kwds[i].is_null();
+      } else {
+        match = !entry->kwds[i].is_null() && entry->kwds[i].get_type() == kwds[i].get_type();
+      }
+    }
+
+    if (match) {
+      return entry;
+    }
+  }
+
+  return nullptr;
+}
+
+void nd::detail::resolve_cache::insert(const std::shared_ptr<resolved_call> &entry) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_entries.size() < capacity) {
+    m_entries.push_back(entry);
+  } else {
+    // Replace the entries in the order they were inserted
+    m_entries[m_next] = entry;
+    m_next = (m_next + 1) % capacity;
+  }
+}
+
+void nd::detail::resolve_cache::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_entries.clear();
+  m_next = 0;
+}
+
+bool nd::detail::resolve_cache::is_cacheable(size_t nkwd, const array *kwds) {
+  for (size_t i = 0; i < nkwd; ++i) {
+    if (!kwds[i].is_null() && !kwds[i].is_na()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+size_t nd::detail::resolve_cache::generation() { return resolve_cache_generation.load(); }
+
+void nd::detail::resolve_cache::invalidate_all() { ++resolve_cache_generation; }
+
 nd::base_callable::~base_callable() {}
 
+std::shared_ptr<nd::detail::resolved_call>
+nd::base_callable::resolve_cached(const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp, size_t nkwd,
+                                  const array *kwds, const std::map<std::string, ndt::type> &tp_vars) {
+  // The keyword arguments are laid out in signature order, so only a callable
+  // with a fixed set of them has a key we can compare
+  bool cacheable = !is_kwd_variadic() && detail::resolve_cache::is_cacheable(get_nkwd(), kwds);
+  if (cacheable) {
+    std::shared_ptr<detail::resolved_call> entry = m_resolve_cache.find(dst_tp, nsrc, src_tp, get_nkwd(), kwds);
+    if (entry != nullptr) {
+      return entry;
+    }
+  }
+
+  std::shared_ptr<detail::resolved_call> entry = std::make_shared<detail::resolved_call>();
+  entry->dst_tp = dst_tp;
+  entry->src_tp.assign(src_tp, src_tp + nsrc);
+  entry->tp_vars = tp_vars;
+  entry->generation = detail::resolve_cache::generation();
+
+  if (cacheable) {
+    entry->kwds.assign(kwds, kwds + get_nkwd());
+
+    // Resolve against the copies owned by the entry, so that anything the
+    // call graph refers to outlives this call
+    entry->resolved_dst_tp = resolve(nullptr, nullptr, entry->cg, entry->dst_tp, nsrc, entry->src_tp.data(), nkwd,
+                                     entry->kwds.data(), entry->tp_vars);
+    m_resolve_cache.insert(entry);
+  } else {
+    entry->resolved_dst_tp =
+        resolve(nullptr, nullptr, entry->cg, entry->dst_tp, nsrc, entry->src_tp.data(), nkwd, kwds, entry->tp_vars);
+  }
+
+  return entry;
+}
+
 nd::array nd::base_callable::call(ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp,
                                   const char *const *src_arrmeta, char *const *src_data, size_t nkwd, const array *kwds,
                                   const std::map<std::string, ndt::type> &tp_vars) {
-  call_graph cg;
-  dst_tp = resolve(nullptr, nullptr, cg, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+  std::shared_ptr<detail::resolved_call> rc = resolve_cached(dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+  dst_tp = rc->resolved_dst_tp;
 
   // Allocate the destination array
   array dst = alloc(&dst_tp);
 
   // Generate and evaluate the ckernel
-  kernel_builder kb(cg.get());
+  kernel_builder kb(rc->cg.get());
   kb(kernel_request_single, nullptr, dst->metadata(), nsrc, src_arrmeta);
 
   kernel_single_t fn = kb.get()->get_function<kernel_single_t>();
@@ -33,14 +137,14 @@ nd::array nd::base_callable::call(ndt::type &dst_tp, size_t nsrc, const ndt::typ
 nd::array nd::base_callable::call(ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp,
                                   const char *const *src_arrmeta, const array *src_data, size_t nkwd, const array *kwds,
                                   const std::map<std::string, ndt::type> &tp_vars) {
-  call_graph cg;
-  dst_tp = resolve(nullptr, nullptr, cg, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+  std::shared_ptr<detail::resolved_call> rc = resolve_cached(dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+  dst_tp = rc->resolved_dst_tp;
 
   // Allocate the destination array
   array dst = empty(dst_tp);
 
   // Generate and evaluate the kernel
-  kernel_builder kb(cg.get());
+  kernel_builder kb(rc->cg.get());
   kb(kernel_request_call, nullptr, dst->metadata(), nsrc, src_arrmeta);
 
   kernel_call_t fn = kb.get()->get_function<kernel_call_t>();
@@ -52,11 +156,10 @@ nd::array nd::base_callable::call(ndt::type &dst_tp, size_t nsrc, const ndt::typ
 void nd::base_callable::call(const ndt::type &dst_tp, const char *dst_arrmeta, char *dst_data, size_t nsrc,
                              const ndt::type *src_tp, const char *const *src_arrmeta, char *const *src_data,
                              size_t nkwd, const array *kwds, const std::map<std::string, ndt::type> &tp_vars) {
-  call_graph cg;
-  resolve(nullptr, nullptr, cg, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+  std::shared_ptr<detail::resolved_call> rc = resolve_cached(dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
 
   // Generate and evaluate the ckernel
-  kernel_builder kb(cg.get());
+  kernel_builder kb(rc->cg.get());
   kb(kernel_request_single, nullptr, dst_arrmeta, nsrc, src_arrmeta);
 
   kernel_single_t fn = kb.get()->get_function<kernel_single_t>();
@@ -66,11 +169,10 @@ void nd::base_callable::call(const ndt::type &dst_tp, const char *dst_arrmeta, c
 void nd::base_callable::call(const ndt::type &dst_tp, const char *dst_arrmeta, array *dst, size_t nsrc,
                              const ndt::type *src_tp, const char *const *src_arrmeta, const array *src, size_t nkwd,
                              const array *kwds, const std::map<std::string, ndt::type> &tp_vars) {
-  call_graph cg;
-  resolve(nullptr, nullptr, cg, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+  std::shared_ptr<detail::resolved_call> rc = resolve_cached(dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
 
   // Generate and evaluate the ckernel
-  kernel_builder kb(cg.get());
+  kernel_builder kb(rc->cg.get());
   kb(kernel_request_call, nullptr, dst_arrmeta, nsrc, src_arrmeta);
 
   kernel_call_t fn = kb.get()->get_function<kernel_call_t>();
@@ -55,8 +55,10 @@ dispatcher<2, nd::callable> make_comparison_children() {
 
 template <template <typename...> class CallableType>
 nd::callable make_comparison_callable() {
-  return nd::make_callable<nd::multidispatch_callable<2>>(ndt::type("(Any, Any) -> Any"),
-                                                          make_comparison_children<func_ptr, CallableType>());
+  nd::callable f = nd::make_callable<nd::multidispatch_callable<2>>(ndt::type("(Any, Any) -> Any"),
+                                                                    make_comparison_children<func_ptr, CallableType>());
+  f->set_thread_safe(true);
+  return f;
 }
 
 nd::callable make_less() { return make_comparison_callable<nd::less_callable>(); }
@@ -72,7 +74,9 @@ nd::callable make_equal() {
   dispatcher.insert(nd::make_callable<nd::equal_callable<ndt::type, ndt::type>>());
   dispatcher.insert(nd::make_callable<nd::equal_callable<bytes, bytes>>());
 
-  return nd::make_callable<nd::multidispatch_callable<2>>(ndt::type("(Any, Any) -> Any"), dispatcher);
+  nd::callable f = nd::make_callable<nd::multidispatch_callable<2>>(ndt::type("(Any, Any) -> Any"), dispatcher);
+  f->set_thread_safe(true);
+  return f;
 }
 
 nd::callable make_not_equal() {
@@ -84,7 +88,9 @@ nd::callable make_not_equal() {
   dispatcher.insert(nd::make_callable<nd::not_equal_callable<ndt::type, ndt::type>>());
   dispatcher.insert(nd::make_callable<nd::not_equal_callable<bytes, bytes>>());
 
-  return nd::make_callable<nd::multidispatch_callable<2>>(ndt::type("(Any, Any) -> Any"), dispatcher);
+  nd::callable f = nd::make_callable<nd::multidispatch_callable<2>>(ndt::type("(Any, Any) -> Any"), dispatcher);
+  f->set_thread_safe(true);
+  return f;
 }
 
 nd::callable make_greater_equal() { return make_comparison_callable<nd::greater_equal_callable>(); }
@@ -95,6 +101,7 @@ nd::callable make_total_order() {
   return nd::make_callable<nd::multidispatch_callable<2>>(
       ndt::type("(Any, Any) -> Any"),
       dispatcher<2, nd::callable>(func_ptr, {nd::make_callable<nd::total_order_callable<dynd::string, dynd::string>>(),
+                                             nd::make_callable<nd::total_order_callable<string_view, string_view>>(),
                                              nd::make_callable<nd::total_order_callable<int32_t, int32_t>>(),
                                              nd::make_callable<nd::total_order_callable<bool, bool>>()}));
 }
@@ -0,0 +1,94 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <atomic>
+
+#include <dynd/callables/base_callable.hpp>
+#include <dynd/cpu_features.hpp>
+
+#ifdef DYND_ISA_DISPATCH
+#include <cpuid.h>
+#endif
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+std::atomic<uint32_t> cpu_features_mask(~0u);
+
+uint32_t detect_cpu_features() {
+  uint32_t res = cpu_feature_none;
+
+#ifdef DYND_ISA_DISPATCH
+  unsigned int eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+    return res;
+  }
+
+  if (edx & bit_SSE2) {
+    res |= cpu_feature_sse2;
+  }
+  if (ecx & bit_SSE3) {
+    res |= cpu_feature_sse3;
+  }
+  if (ecx & bit_SSSE3) {
+    res |= cpu_feature_ssse3;
+  }
+  if (ecx & bit_SSE4_1) {
+    res |= cpu_feature_sse4_1;
+  }
+  if (ecx & bit_SSE4_2) {
+    res |= cpu_feature_sse4_2;
+  }
+
+  // The AVX registers are only usable if the operating system saves them,
+  // which it reports through XCR0
+  bool os_avx = false;
+  bool os_avx512 = false;
+  if ((ecx & bit_OSXSAVE) && (ecx & bit_AVX)) {
+    unsigned int xcr0_lo, xcr0_hi;
+    __asm__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+    os_avx = (xcr0_lo & 0x06) == 0x06;
+    os_avx512 = os_avx && (xcr0_lo & 0xe0) == 0xe0;
+  }
+
+  if (os_avx) {
+    res |= cpu_feature_avx;
+    if (ecx & bit_FMA) {
+      res |= cpu_feature_fma;
+    }
+  }
+
+  if (__get_cpuid_max(0, NULL) >= 7) {
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    if (os_avx && (ebx & bit_AVX2)) {
+      res |= cpu_feature_avx2;
+    }
+    if (os_avx512 && (ebx & bit_AVX512F)) {
+      res |= cpu_feature_avx512f;
+      if (ebx & bit_AVX512BW) {
+        res |= cpu_feature_avx512bw;
+      }
+    }
+  }
+#endif
+
+  return res;
+}
+
+} // anonymous namespace
+
+uint32_t dynd::detected_cpu_features() {
+  static const uint32_t features = detect_cpu_features();
+  return features;
+}
+
+uint32_t dynd::cpu_features() { return detected_cpu_features() & cpu_features_mask.load(memory_order_relaxed); }
+
+void dynd::restrict_cpu_features(uint32_t mask) {
+  cpu_features_mask = mask;
+  nd::detail::resolve_cache::invalidate_all();
+}
@@ -8,6 +8,7 @@
 #include <dynd/callables/compound_callable.hpp>
 #include <dynd/callables/constant_callable.hpp>
 #include <dynd/callables/elwise_entry_callable.hpp>
+#include <dynd/callables/isa_dispatch_callable.hpp>
 #include <dynd/callables/neighborhood_callable.hpp>
 #include <dynd/callables/outer_callable.hpp>
 #include <dynd/callables/outer_entry_callable.hpp>
@@ -60,8 +61,12 @@ nd::callable nd::functional::compose(const nd::callable &first, const nd::callab
       ndt::substitute(second.get_type()->get_return_type(), tp_vars, false);
   */
 
-  return make_callable<compose_callable>(
+  callable f = make_callable<compose_callable>(
       ndt::make_type<ndt::callable_type>(second->get_ret_type(), first->get_arg_types()), first, second, buf_tp);
+  // Only a buffer on the stack is private to each call of the kernel
+  f->set_thread_safe(first->is_thread_safe() && second->is_thread_safe() &&
+                     compose_kernel::is_local_buffer(buf_tp));
+  return f;
 }
 
 nd::callable nd::functional::constant(const array &val) { return make_callable<constant_callable>(val); }
@@ -123,6 +128,7 @@ nd::callable nd::functional::elwise(const callable &child, bool res_ignore) {
   }
 
   nd::callable f = make_callable<elwise_entry_callable>(f_tp, child, res_ignore);
+  f->set_thread_safe(child->is_thread_safe());
 
   if (state) {
     ndt::type tp = ndt::make_type<ndt::callable_type>(f->get_ret_type(), arg_tp);
@@ -172,7 +178,7 @@ nd::callable nd::functional::neighborhood(const callable &neighborhood_op, const
       neighborhood_op, boundary_child);
 }
 
-nd::callable nd::functional::reduction(const callable &identity, const callable &child) {
+nd::callable nd::functional::reduction(const callable &identity, const callable &child, bool associative) {
   if (identity.is_null()) {
     throw invalid_argument("'identity' cannot be null");
   }
@@ -193,7 +199,15 @@ nd::callable nd::functional::reduction(const callable &identity, const callable
   return make_callable<reduction_dispatch_callable>(
       ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::ellipsis_dim_type>("Dims", child->get_ret_type()),
                                          arg_tp.size(), arg_tp.data(), kwds),
-      identity, child);
+      identity, child, associative);
 }
 
 nd::callable nd::functional::where(const callable &child) { return elwise(make_callable<where_callable>(child), true); }
+
+nd::callable nd::functional::isa_dispatch(const std::vector<std::pair<uint32_t, callable>> &variants) {
+  if (variants.empty()) {
+    throw invalid_argument("isa_dispatch requires at least one variant");
+  }
+
+  return make_callable<isa_dispatch_callable>(variants[0].second->get_type(), variants);
+}
@@ -26,3 +26,5 @@ DYND_API nd::callable nd::index = nd::make_callable<nd::multidispatch_callable<1
     nd::callable::make_all<nd::index_callable, type_sequence<int32_t, ndt::fixed_dim_kind_type>>(func_ptr));
 
 DYND_API nd::callable nd::take = nd::make_callable<nd::take_dispatch_callable>();
+
+DYND_API nd::callable nd::take_packed = nd::make_callable<nd::packed_take_callable>();
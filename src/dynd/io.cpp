@@ -3,12 +3,444 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <vector>
+
 #include <dynd/callables/serialize_callable.hpp>
 #include <dynd/functional.hpp>
 #include <dynd/io.hpp>
+#include <dynd/memblock/memmap_memory_block.hpp>
+#include <dynd/types/bytes_type.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
+#include <dynd/types/pointer_type.hpp>
+#include <dynd/types/string_type.hpp>
+#include <dynd/types/struct_type.hpp>
+#include <dynd/types/tuple_type.hpp>
+#include <dynd/types/var_dim_type.hpp>
 
 using namespace std;
 using namespace dynd;
 
 DYND_API nd::callable nd::serialize = nd::functional::reduction(
     [] { return bytes(); }, nd::make_callable<nd::serialize_callable<ndt::scalar_kind_type>>());
+
+namespace {
+
+/**
+ * The start of a binary array file, which is followed by its datashape, and
+ * then by its data at ``data_offset`` with the heap right after it.
+ */
+struct binary_array_header {
+  char magic[8];
+  uint32_t version;
+  // Written as 0x01020304 in the byte order of the data
+  uint32_t byte_order;
+  uint32_t pointer_size;
+  uint32_t reserved;
+  uint64_t datashape_size;
+  uint64_t data_offset;
+  uint64_t data_size;
+  uint64_t heap_size;
+};
+
+const char binary_array_magic[8] = {'D', 'Y', 'N', 'D', 'B', 'I', 'N', '\0'};
+const uint32_t binary_array_version = 1;
+const uint32_t binary_array_byte_order = 0x01020304;
+const size_t binary_array_alignment = 64;
+
+/**
+ * An out-of-line value in the file, which is where its data starts in the
+ * data section and how many bytes or elements it has. It takes the place of
+ * the value in the data, so its fields are pointer sized like the value's,
+ * as recorded by ``pointer_size`` in the header. A pointer is replaced by
+ * just an offset, of the same size.
+ */
+struct binary_array_ref {
+  intptr_t offset;
+  intptr_t size;
+};
+
+static_assert(sizeof(binary_array_ref) <= sizeof(ndt::var_dim_type::data_type) &&
+                  sizeof(binary_array_ref) <= sizeof(dynd::string) && sizeof(binary_array_ref) <= sizeof(bytes),
+              "an out-of-line value in a binary array file must fit in the place of the value");
+static_assert(sizeof(intptr_t) == sizeof(char *), "a pointer in a binary array file is replaced by an intptr_t");
+
+/**
+ * Converts a position or size in memory to a field of the file.
+ */
+intptr_t to_file_field(size_t value)
+{
+  if (value > static_cast<size_t>(std::numeric_limits<intptr_t>::max())) {
+    throw overflow_error("binary array file is too large for the pointer size of its fields");
+  }
+
+  return static_cast<intptr_t>(value);
+}
+
+/**
+ * Whether all of the data of a type is in place, so that it can be copied
+ * and mapped as bytes.
+ */
+bool is_inline_type(const ndt::type &tp)
+{
+  return !tp.is_symbolic() && !tp.is_expression() &&
+         (tp.get_flags() & (type_flag_construct | type_flag_blockref | type_flag_destructor)) == 0;
+}
+
+void throw_unsupported(const ndt::type &tp)
+{
+  stringstream ss;
+  ss << "cannot save or load dynd type " << tp << " in the binary array format";
+  throw type_error(ss.str());
+}
+
+/**
+ * The default arrmeta of a type, without memory blocks, which gives the
+ * layout of its data in the file.
+ */
+class default_arrmeta {
+  ndt::type m_tp;
+  std::vector<char> m_arrmeta;
+
+public:
+  default_arrmeta(const ndt::type &tp) : m_tp(tp), m_arrmeta(tp.get_arrmeta_size() + 1)
+  {
+    if (!m_tp.is_builtin()) {
+      m_tp.extended()->arrmeta_default_construct(m_arrmeta.data(), false);
+    }
+  }
+
+  ~default_arrmeta()
+  {
+    if (!m_tp.is_builtin()) {
+      m_tp.extended()->arrmeta_destruct(m_arrmeta.data());
+    }
+  }
+
+  const char *get() const { return m_arrmeta.data(); }
+};
+
+/**
+ * Lays out the data of an array in the default layout of its type, with
+ * the data of its var dimensions, strings, bytes and pointers appended as
+ * the heap. Positions are offsets into the output, which moves as it grows.
+ */
+class binary_array_writer {
+  std::vector<char> m_out;
+
+  template <typename StringType>
+  void write_string(const char *src_data, size_t pos)
+  {
+    const StringType *src = reinterpret_cast<const StringType *>(src_data);
+    size_t offset = alloc(src->size(), 1);
+    binary_array_ref ref = {to_file_field(offset), to_file_field(src->size())};
+    memcpy(m_out.data() + offset, src->data(), src->size());
+    memcpy(m_out.data() + pos, &ref, sizeof(ref));
+  }
+
+  template <typename TupleType>
+  void write_fields(const TupleType *td, const char *src_arrmeta, const char *src_data, const char *dst_arrmeta,
+                    size_t pos)
+  {
+    const uintptr_t *src_offsets = reinterpret_cast<const uintptr_t *>(src_arrmeta);
+    const uintptr_t *dst_offsets = reinterpret_cast<const uintptr_t *>(dst_arrmeta);
+    const uintptr_t *arrmeta_offsets = td->get_arrmeta_offsets_raw();
+    for (intptr_t i = 0; i < td->get_field_count(); ++i) {
+      write(td->get_field_type(i), src_arrmeta + arrmeta_offsets[i], src_data + src_offsets[i],
+            dst_arrmeta + arrmeta_offsets[i], pos + dst_offsets[i]);
+    }
+  }
+
+public:
+  const std::vector<char> &get() const { return m_out; }
+
+  /**
+   * Appends ``size`` zero bytes aligned to ``alignment``, and returns where
+   * they start.
+   */
+  size_t alloc(size_t size, size_t alignment)
+  {
+    size_t pos = inc_to_alignment(m_out.size(), alignment);
+    m_out.resize(pos + size);
+    return pos;
+  }
+
+  void write(const ndt::type &tp, const char *src_arrmeta, const char *src_data, const char *dst_arrmeta,
+             size_t pos)
+  {
+    // Data in the same layout as the file is copied whole
+    if (is_inline_type(tp) &&
+        (tp.is_builtin() || memcmp(src_arrmeta, dst_arrmeta, tp.get_arrmeta_size()) == 0)) {
+      memcpy(m_out.data() + pos, src_data, tp.get_default_data_size());
+      return;
+    }
+
+    switch (tp.get_id()) {
+    case fixed_dim_id: {
+      const fixed_dim_type_arrmeta *src_md = reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta);
+      const fixed_dim_type_arrmeta *dst_md = reinterpret_cast<const fixed_dim_type_arrmeta *>(dst_arrmeta);
+      const ndt::type &element_tp = tp.extended<ndt::fixed_dim_type>()->get_element_type();
+      for (intptr_t i = 0; i < src_md->dim_size; ++i) {
+        write(element_tp, src_arrmeta + sizeof(fixed_dim_type_arrmeta), src_data + i * src_md->stride,
+              dst_arrmeta + sizeof(fixed_dim_type_arrmeta), pos + i * dst_md->stride);
+      }
+      break;
+    }
+    case struct_id:
+      write_fields(tp.extended<ndt::struct_type>(), src_arrmeta, src_data, dst_arrmeta, pos);
+      break;
+    case tuple_id:
+      write_fields(tp.extended<ndt::tuple_type>(), src_arrmeta, src_data, dst_arrmeta, pos);
+      break;
+    case var_dim_id: {
+      typedef ndt::var_dim_type::metadata_type metadata_type;
+      const metadata_type *src_md = reinterpret_cast<const metadata_type *>(src_arrmeta);
+      const metadata_type *dst_md = reinterpret_cast<const metadata_type *>(dst_arrmeta);
+      const ndt::var_dim_type::data_type *src =
+          reinterpret_cast<const ndt::var_dim_type::data_type *>(src_data);
+      const ndt::type &element_tp = tp.extended<ndt::var_dim_type>()->get_element_type();
+
+      size_t offset = alloc(src->size * dst_md->stride, element_tp.get_data_alignment());
+      binary_array_ref ref = {to_file_field(offset), to_file_field(src->size)};
+      memcpy(m_out.data() + pos, &ref, sizeof(ref));
+      for (size_t i = 0; i < src->size; ++i) {
+        write(element_tp, src_arrmeta + sizeof(metadata_type), src->begin + src_md->offset + i * src_md->stride,
+              dst_arrmeta + sizeof(metadata_type), offset + i * dst_md->stride);
+      }
+      break;
+    }
+    case pointer_id: {
+      const pointer_type_arrmeta *src_md = reinterpret_cast<const pointer_type_arrmeta *>(src_arrmeta);
+      const ndt::type &target_tp = tp.extended<ndt::pointer_type>()->get_target_type();
+      if (!is_inline_type(target_tp)) {
+        throw_unsupported(tp);
+      }
+
+      size_t offset = alloc(target_tp.get_default_data_size(), target_tp.get_data_alignment());
+      intptr_t field = to_file_field(offset);
+      memcpy(m_out.data() + pos, &field, sizeof(field));
+      write(target_tp, src_arrmeta + sizeof(pointer_type_arrmeta),
+            *reinterpret_cast<char *const *>(src_data) + src_md->offset, dst_arrmeta + sizeof(pointer_type_arrmeta),
+            offset);
+      break;
+    }
+    case string_id:
+      write_string<dynd::string>(src_data, pos);
+      break;
+    case bytes_id:
+      write_string<bytes>(src_data, pos);
+      break;
+    default:
+      throw_unsupported(tp);
+    }
+  }
+};
+
+/**
+ * Fills an array of the type of a file from its data, which is in the same
+ * layout. Data in place is copied, var dimensions of types with all of their
+ * data in place point into the mapping, and the rest is copied out of it.
+ */
+class binary_array_reader {
+  nd::memory_block m_mm;
+  const char *m_begin;
+  size_t m_size;
+
+  binary_array_ref read_ref(const char *src, size_t element_size) const
+  {
+    binary_array_ref ref;
+    memcpy(&ref, src, sizeof(ref));
+    if (ref.offset < 0 || ref.size < 0 || static_cast<size_t>(ref.offset) > m_size ||
+        (element_size != 0 && static_cast<size_t>(ref.size) > (m_size - ref.offset) / element_size)) {
+      throw invalid_argument("corrupt binary array file, an out of line value is past its end");
+    }
+
+    return ref;
+  }
+
+  template <typename TupleType>
+  void read_fields(const TupleType *td, char *arrmeta, char *dst, const char *src)
+  {
+    const uintptr_t *offsets = reinterpret_cast<const uintptr_t *>(arrmeta);
+    const uintptr_t *arrmeta_offsets = td->get_arrmeta_offsets_raw();
+    for (intptr_t i = 0; i < td->get_field_count(); ++i) {
+      read(td->get_field_type(i), arrmeta + arrmeta_offsets[i], dst + offsets[i], src + offsets[i]);
+    }
+  }
+
+public:
+  binary_array_reader(const nd::memory_block &mm, const char *begin, size_t size)
+      : m_mm(mm), m_begin(begin), m_size(size)
+  {
+  }
+
+  void read(const ndt::type &tp, char *arrmeta, char *dst, const char *src)
+  {
+    if (is_inline_type(tp)) {
+      memcpy(dst, src, tp.get_default_data_size());
+      return;
+    }
+
+    switch (tp.get_id()) {
+    case fixed_dim_id: {
+      const fixed_dim_type_arrmeta *md = reinterpret_cast<const fixed_dim_type_arrmeta *>(arrmeta);
+      const ndt::type &element_tp = tp.extended<ndt::fixed_dim_type>()->get_element_type();
+      for (intptr_t i = 0; i < md->dim_size; ++i) {
+        read(element_tp, arrmeta + sizeof(fixed_dim_type_arrmeta), dst + i * md->stride, src + i * md->stride);
+      }
+      break;
+    }
+    case struct_id:
+      read_fields(tp.extended<ndt::struct_type>(), arrmeta, dst, src);
+      break;
+    case tuple_id:
+      read_fields(tp.extended<ndt::tuple_type>(), arrmeta, dst, src);
+      break;
+    case var_dim_id: {
+      typedef ndt::var_dim_type::metadata_type metadata_type;
+      metadata_type *md = reinterpret_cast<metadata_type *>(arrmeta);
+      ndt::var_dim_type::data_type *d = reinterpret_cast<ndt::var_dim_type::data_type *>(dst);
+      const ndt::type &element_tp = tp.extended<ndt::var_dim_type>()->get_element_type();
+      binary_array_ref ref = read_ref(src, md->stride);
+
+      if (is_inline_type(element_tp)) {
+        md->blockref = m_mm;
+        d->begin = const_cast<char *>(m_begin + ref.offset);
+        d->size = ref.size;
+        break;
+      }
+
+      d->begin = (ref.size == 0) ? NULL : md->blockref->alloc(ref.size);
+      d->size = ref.size;
+      for (intptr_t i = 0; i < ref.size; ++i) {
+        read(element_tp, arrmeta + sizeof(metadata_type), d->begin + i * md->stride,
+             m_begin + ref.offset + i * md->stride);
+      }
+      break;
+    }
+    case pointer_id: {
+      pointer_type_arrmeta *md = reinterpret_cast<pointer_type_arrmeta *>(arrmeta);
+      const ndt::type &target_tp = tp.extended<ndt::pointer_type>()->get_target_type();
+      if (!is_inline_type(target_tp)) {
+        throw_unsupported(tp);
+      }
+
+      intptr_t offset;
+      memcpy(&offset, src, sizeof(offset));
+      if (offset < 0 || static_cast<size_t>(offset) > m_size || target_tp.get_default_data_size() > m_size - offset) {
+        throw invalid_argument("corrupt binary array file, a pointer is past its end");
+      }
+      md->blockref = m_mm;
+      md->offset = 0;
+      *reinterpret_cast<char **>(dst) = const_cast<char *>(m_begin + offset);
+      break;
+    }
+    case string_id: {
+      binary_array_ref ref = read_ref(src, 1);
+      reinterpret_cast<dynd::string *>(dst)->assign(m_begin + ref.offset, ref.size);
+      break;
+    }
+    case bytes_id: {
+      binary_array_ref ref = read_ref(src, 1);
+      reinterpret_cast<bytes *>(dst)->assign(m_begin + ref.offset, ref.size);
+      break;
+    }
+    default:
+      throw_unsupported(tp);
+    }
+  }
+};
+
+} // anonymous namespace
+
+void nd::save(const std::string &filename, const array &a)
+{
+  const ndt::type &tp = a.get_type();
+  if (tp.is_symbolic() || tp.is_expression()) {
+    throw_unsupported(tp);
+  }
+
+  default_arrmeta dst_arrmeta(tp);
+  binary_array_writer writer;
+  writer.alloc(tp.get_default_data_size(), 1);
+  writer.write(tp, a.get()->metadata(), a.cdata(), dst_arrmeta.get(), 0);
+
+  std::stringstream datashape;
+  datashape << tp;
+  std::string datashape_str = datashape.str();
+
+  binary_array_header header;
+  memcpy(header.magic, binary_array_magic, sizeof(header.magic));
+  header.version = binary_array_version;
+  header.byte_order = binary_array_byte_order;
+  header.pointer_size = sizeof(void *);
+  header.reserved = 0;
+  header.datashape_size = datashape_str.size();
+  header.data_offset = inc_to_alignment(sizeof(header) + datashape_str.size(), binary_array_alignment);
+  header.data_size = tp.get_default_data_size();
+  header.heap_size = writer.get().size() - header.data_size;
+
+  std::ofstream out(filename.c_str(), std::ios::binary | std::ios::trunc);
+  std::vector<char> padding(header.data_offset - sizeof(header) - datashape_str.size());
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.write(datashape_str.data(), datashape_str.size());
+  out.write(padding.data(), padding.size());
+  out.write(writer.get().data(), writer.get().size());
+  out.close();
+  if (!out) {
+    stringstream ss;
+    ss << "failed to save a dynd array to file \"" << filename << "\"";
+    throw runtime_error(ss.str());
+  }
+}
+
+nd::array nd::load(const std::string &filename)
+{
+  char *begin = NULL;
+  intptr_t size = 0;
+  memory_block mm = make_memory_block<memmap_memory_block>(filename, read_access_flag, &begin, &size);
+
+  binary_array_header header;
+  if (static_cast<size_t>(size) < sizeof(header)) {
+    throw invalid_argument("file \"" + filename + "\" is too small to be a binary array file");
+  }
+  memcpy(&header, begin, sizeof(header));
+  if (memcmp(header.magic, binary_array_magic, sizeof(header.magic)) != 0) {
+    throw invalid_argument("file \"" + filename + "\" is not a binary array file");
+  }
+  if (header.version != binary_array_version || header.byte_order != binary_array_byte_order ||
+      header.pointer_size != sizeof(void *)) {
+    stringstream ss;
+    ss << "cannot load binary array file \"" << filename << "\" of version " << header.version
+       << ", saved with another byte order or pointer size";
+    throw invalid_argument(ss.str());
+  }
+  uint64_t file_size = static_cast<uint64_t>(size);
+  if (header.datashape_size > file_size - sizeof(header) || header.data_offset > file_size ||
+      header.data_offset % binary_array_alignment != 0 || header.data_size > file_size - header.data_offset ||
+      header.heap_size != file_size - header.data_offset - header.data_size) {
+    throw invalid_argument("corrupt binary array file \"" + filename + "\", its sections do not fit the file");
+  }
+
+  ndt::type tp(std::string(begin + sizeof(header), header.datashape_size));
+  if (tp.is_symbolic() || tp.get_default_data_size() != header.data_size) {
+    throw invalid_argument("corrupt binary array file \"" + filename + "\", its data does not fit its type");
+  }
+
+  const char *data = begin + header.data_offset;
+  if (is_inline_type(tp)) {
+    array res = make_array(tp, const_cast<char *>(data), mm, read_access_flag);
+    if (!tp.is_builtin()) {
+      tp.extended()->arrmeta_default_construct(res.get()->metadata(), true);
+    }
+    return res;
+  }
+
+  array res = empty(tp, read_access_flag);
+  binary_array_reader reader(mm, data, header.data_size + header.heap_size);
+  reader.read(tp, res.get()->metadata(), const_cast<char *>(res.cdata()), data);
+  return res;
+}
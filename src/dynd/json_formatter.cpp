@@ -291,6 +291,7 @@ static void format_json(output_data &out, const ndt::type &dt, const char *arrme
     break;
   case fixed_string_id:
   case string_id:
+  case string_view_id:
     format_json_string(out, dt, arrmeta, data);
     break;
   case type_id:
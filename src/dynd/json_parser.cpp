@@ -3,16 +3,38 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
 #include <dynd/json_parser.hpp>
+#include <dynd/assignment.hpp>
 #include <dynd/callable.hpp>
+#include <dynd/cpu_features.hpp>
+#include <dynd/parallel.hpp>
+#include <dynd/type_promotion.hpp>
 #include <dynd/types/base_bytes_type.hpp>
 #include <dynd/types/string_type.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
 #include <dynd/types/var_dim_type.hpp>
 #include <dynd/types/option_type.hpp>
+#include <dynd/types/struct_type.hpp>
+#include <dynd/types/tuple_type.hpp>
 #include <dynd/parse.hpp>
 #include <dynd/kernels/parse_kernel.hpp>
 
+#ifdef DYND_ISA_DISPATCH
+#include <immintrin.h>
+#endif
+
 using namespace std;
 using namespace dynd;
 
@@ -641,6 +663,7 @@ static void parse_json(const ndt::type &tp, const char *arrmeta, char *out_data,
     return;
   case fixed_string_id:
   case string_id:
+  case string_view_id:
     parse_string_json(tp, arrmeta, out_data, begin, end, ectx);
     return;
   case type_id:
@@ -658,6 +681,698 @@ static void parse_json(const ndt::type &tp, const char *arrmeta, char *out_data,
   throw runtime_error(ss.str());
 }
 
+namespace {
+
+/**
+ * The bit masks of one 64 byte block of JSON, with bit i set when byte i is
+ * a backslash, a quote, one of the structural characters {}[],: , or JSON
+ * whitespace.
+ */
+struct json_block_masks {
+  uint64_t backslash;
+  uint64_t quote;
+  uint64_t structural;
+  uint64_t whitespace;
+};
+
+/**
+ * What carries over from one block to the next, which is whether the first
+ * character is escaped by a backslash at the end of the previous block,
+ * whether it is inside a string, as a mask of all zeros or all ones, and
+ * whether it continues a scalar.
+ */
+struct json_index_state {
+  uint64_t prev_escaped;
+  uint64_t prev_in_string;
+  uint64_t prev_scalar;
+};
+
+inline void classify_json_block(const char *block, json_block_masks &res)
+{
+  res.backslash = 0;
+  res.quote = 0;
+  res.structural = 0;
+  res.whitespace = 0;
+  for (int i = 0; i < 64; ++i) {
+    unsigned char c = static_cast<unsigned char>(block[i]);
+    uint64_t bit = static_cast<uint64_t>(1) << i;
+    res.backslash |= (c == '\\') ? bit : 0;
+    res.quote |= (c == '"') ? bit : 0;
+    // Setting 0x20 maps '[' and ']' onto '{' and '}'
+    res.structural |= ((c | 0x20) == '{' || (c | 0x20) == '}' || c == ',' || c == ':') ? bit : 0;
+    res.whitespace |= (c == ' ' || c == '\n' || c == '\r' || c == '\t') ? bit : 0;
+  }
+}
+
+#ifdef DYND_ISA_DISPATCH
+DYND_TARGET("avx2") inline uint64_t json_avx2_eq(__m256i lo, __m256i hi, char c)
+{
+  __m256i v = _mm256_set1_epi8(c);
+  uint32_t lo_bits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, v)));
+  uint32_t hi_bits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, v)));
+  return lo_bits | (static_cast<uint64_t>(hi_bits) << 32);
+}
+
+DYND_TARGET("avx2") inline void classify_json_block_avx2(const char *block, json_block_masks &res)
+{
+  __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+  __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32));
+  __m256i lo_folded = _mm256_or_si256(lo, _mm256_set1_epi8(0x20));
+  __m256i hi_folded = _mm256_or_si256(hi, _mm256_set1_epi8(0x20));
+
+  res.backslash = json_avx2_eq(lo, hi, '\\');
+  res.quote = json_avx2_eq(lo, hi, '"');
+  res.structural = json_avx2_eq(lo_folded, hi_folded, '{') | json_avx2_eq(lo_folded, hi_folded, '}') |
+                   json_avx2_eq(lo, hi, ',') | json_avx2_eq(lo, hi, ':');
+  res.whitespace = json_avx2_eq(lo, hi, ' ') | json_avx2_eq(lo, hi, '\n') | json_avx2_eq(lo, hi, '\r') |
+                   json_avx2_eq(lo, hi, '\t');
+}
+#endif
+
+/**
+ * Sets bit i to the xor of bits 0 through i, which turns a mask of the quotes
+ * into one of the characters from an opening quote up to its closing quote.
+ */
+inline uint64_t prefix_xor(uint64_t bits)
+{
+  bits ^= bits << 1;
+  bits ^= bits << 2;
+  bits ^= bits << 4;
+  bits ^= bits << 8;
+  bits ^= bits << 16;
+  bits ^= bits << 32;
+  return bits;
+}
+
+/**
+ * Finds the characters escaped by a backslash, which are the ones after an
+ * odd length run of backslashes. Adding the starts of the runs that begin on
+ * an odd bit to the backslashes carries through each such run and leaves a
+ * bit past its end, which tells the runs of odd length apart by where they
+ * end. The carry out of the top bit is a run continuing into the next block.
+ */
+inline uint64_t find_escaped(uint64_t backslash, uint64_t &prev_escaped)
+{
+  const uint64_t even_bits = 0x5555555555555555ULL;
+
+  backslash &= ~prev_escaped;
+  uint64_t follows_escape = (backslash << 1) | prev_escaped;
+  uint64_t odd_starts = backslash & ~even_bits & ~follows_escape;
+  uint64_t even_starts = odd_starts + backslash;
+  prev_escaped = (even_starts < odd_starts) ? 1 : 0;
+
+  return (even_bits ^ (even_starts << 1)) & follows_escape;
+}
+
+/**
+ * Appends the offsets of the structural characters and the starts of the
+ * scalars of one block, and returns the new end of ``out``, which needs room
+ * for 64 of them.
+ */
+inline uint32_t *index_json_block(const json_block_masks &masks, json_index_state &state, uint32_t offset,
+                                  uint32_t *out)
+{
+  uint64_t quote = masks.quote & ~find_escaped(masks.backslash, state.prev_escaped);
+  uint64_t in_string = prefix_xor(quote) ^ state.prev_in_string;
+  state.prev_in_string = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+
+  // Anything else outside of strings is part of a number, a literal, or
+  // something invalid, and is indexed where it starts
+  uint64_t scalar = ~(masks.structural | masks.whitespace | quote | in_string);
+  uint64_t scalar_start = scalar & ~((scalar << 1) | state.prev_scalar);
+  state.prev_scalar = scalar >> 63;
+
+  // Writes the offsets four at a time, which can go past the last one by up
+  // to three, so that how many there are is only branched on once in four.
+  // Setting the top bit keeps ``ctz64`` defined once the bits run out.
+  const uint64_t top_bit = static_cast<uint64_t>(1) << 63;
+  uint64_t bits = (masks.structural & ~in_string) | quote | scalar_start;
+  int count = popcount64(bits);
+  for (int i = 0; i < count; i += 4) {
+    out[i] = offset + static_cast<uint32_t>(ctz64(bits | top_bit));
+    bits &= bits - 1;
+    out[i + 1] = offset + static_cast<uint32_t>(ctz64(bits | top_bit));
+    bits &= bits - 1;
+    out[i + 2] = offset + static_cast<uint32_t>(ctz64(bits | top_bit));
+    bits &= bits - 1;
+    out[i + 3] = offset + static_cast<uint32_t>(ctz64(bits | top_bit));
+    bits &= bits - 1;
+  }
+
+  return out + count;
+}
+
+/**
+ * Indexes the whole 64 byte blocks of a buffer, growing ``out`` as needed, and
+ * returns the offset of the partial block at the end.
+ */
+size_t index_json_blocks(const char *begin, size_t size, json_index_state &state, std::vector<uint32_t> &out,
+                         size_t &count)
+{
+  size_t offset = 0;
+  for (; offset + 64 <= size; offset += 64) {
+    if (count + 64 > out.size()) {
+      out.resize(2 * out.size() + 64);
+    }
+
+    json_block_masks masks;
+    classify_json_block(begin + offset, masks);
+    count = index_json_block(masks, state, static_cast<uint32_t>(offset), out.data() + count) - out.data();
+  }
+
+  return offset;
+}
+
+#ifdef DYND_ISA_DISPATCH
+DYND_TARGET("avx2,popcnt,bmi")
+size_t index_json_blocks_avx2(const char *begin, size_t size, json_index_state &state, std::vector<uint32_t> &out,
+                              size_t &count)
+{
+  size_t offset = 0;
+  for (; offset + 64 <= size; offset += 64) {
+    if (count + 64 > out.size()) {
+      out.resize(2 * out.size() + 64);
+    }
+
+    json_block_masks masks;
+    classify_json_block_avx2(begin + offset, masks);
+    count = index_json_block(masks, state, static_cast<uint32_t>(offset), out.data() + count) - out.data();
+  }
+
+  return offset;
+}
+#endif
+
+} // anonymous namespace
+
+bool dynd::json::structural_index(const char *begin, const char *end, std::vector<uint32_t> &out)
+{
+  size_t size = end - begin;
+  if (size >= std::numeric_limits<uint32_t>::max()) {
+    return false;
+  }
+
+  json_index_state state = {0, 0, 0};
+  // Record-like JSON has about one structural character every four bytes
+  size_t count = out.size();
+  out.resize(count + size / 4 + 64);
+
+  size_t offset;
+#ifdef DYND_ISA_DISPATCH
+  if (cpu_supports(cpu_feature_avx2)) {
+    offset = index_json_blocks_avx2(begin, size, state, out, count);
+  }
+  else {
+    offset = index_json_blocks(begin, size, state, out, count);
+  }
+#else
+  offset = index_json_blocks(begin, size, state, out, count);
+#endif
+
+  // The last partial block is padded with spaces, which are not structural
+  if (offset < size) {
+    char block[64];
+    memset(block, ' ', sizeof(block));
+    memcpy(block, begin + offset, size - offset);
+
+    if (count + 64 > out.size()) {
+      out.resize(count + 64);
+    }
+    json_block_masks masks;
+    classify_json_block(block, masks);
+    count = index_json_block(masks, state, static_cast<uint32_t>(offset), out.data() + count) - out.data();
+  }
+
+  out.resize(count);
+  return state.prev_in_string == 0;
+}
+
+namespace {
+
+/**
+ * Thrown by ``indexed_json_parser`` on anything it does not accept, after
+ * which the character parser goes over the same JSON to either give the
+ * error with its position or parse what the indexed one turned down.
+ */
+struct json_index_fallback {
+};
+
+/**
+ * Parses JSON into a dynd array like the character parser above, but moves
+ * from one token to the next with the offsets of ``json::structural_index``,
+ * so whitespace is never looked at. Strings are their two quotes, so their
+ * characters are never looked at one by one either.
+ *
+ * Scalars are converted by the functions of the character parser, given
+ * just their text.
+ */
+class indexed_json_parser {
+  const char *m_begin;
+  const char *m_end;
+  const uint32_t *m_index;
+  size_t m_index_size;
+  // The position in the index of the next token
+  size_t m_k;
+  const eval::eval_context *m_ectx;
+
+  static void fail() { throw json_index_fallback(); }
+
+  static bool is_structural(char c) { return c == '{' || c == '}' || c == '[' || c == ']' || c == ',' || c == ':'; }
+
+  const char *token(size_t k) const { return m_begin + m_index[k]; }
+
+  static bool is_ascii(const char *begin, const char *end)
+  {
+    uint64_t bits = 0;
+    for (; end - begin >= 8; begin += 8) {
+      uint64_t word;
+      memcpy(&word, begin, 8);
+      bits |= word;
+    }
+    for (; begin != end; ++begin) {
+      bits |= static_cast<unsigned char>(*begin);
+    }
+
+    return (bits & 0x8080808080808080ULL) == 0;
+  }
+
+  /**
+   * The index of the field with a name, or -1 if there is none. Objects
+   * usually list their fields in the same order, so the field ``next`` after
+   * the previous one is tried first.
+   */
+  static intptr_t find_field(const ndt::struct_type *fsd, const char *begin, const char *end, intptr_t next)
+  {
+    const std::vector<std::string> &names = fsd->get_field_names();
+    size_t size = end - begin;
+    if (next < fsd->get_field_count() && names[next].size() == size && !memcmp(names[next].data(), begin, size)) {
+      return next;
+    }
+
+    for (size_t i = 0; i < names.size(); ++i) {
+      if (names[i].size() == size && !memcmp(names[i].data(), begin, size)) {
+        return static_cast<intptr_t>(i);
+      }
+    }
+
+    return -1;
+  }
+
+  /**
+   * The first character of the next token, or 0 if there are none left.
+   */
+  char peek() const { return (m_k == m_index_size) ? 0 : *token(m_k); }
+
+  void consume() { ++m_k; }
+
+  bool accept(char c)
+  {
+    if (peek() != c) {
+      return false;
+    }
+
+    consume();
+    return true;
+  }
+
+  void expect(char c)
+  {
+    if (!accept(c)) {
+      fail();
+    }
+  }
+
+  /**
+   * Consumes a string, which ends at the next quote since quotes are the
+   * only structural characters indexed inside one. Escapes are checked the
+   * same way as the character parser does.
+   */
+  void parse_string(const char *&strbegin, const char *&strend, bool &escaped)
+  {
+    if (peek() != '"') {
+      fail();
+    }
+
+    const char *quote_begin = token(m_k);
+    const char *quote_end = token(m_k + 1) + 1;
+    m_k += 2;
+
+    strbegin = quote_begin + 1;
+    strend = quote_end - 1;
+    escaped = memchr(strbegin, '\\', strend - strbegin) != NULL;
+    if (escaped) {
+      const char *begin = quote_begin;
+      parse_doublequote_string_no_ws(begin, quote_end, strbegin, strend, escaped);
+    }
+  }
+
+  /**
+   * Consumes a scalar, returning the range of its text without the
+   * surrounding whitespace. A quoted scalar includes its quotes.
+   */
+  void parse_scalar(const char *&begin, const char *&end)
+  {
+    char c = peek();
+    if (c == '"') {
+      begin = token(m_k);
+      end = token(m_k + 1) + 1;
+      m_k += 2;
+      return;
+    }
+    if (c == 0 || is_structural(c)) {
+      fail();
+    }
+
+    // Only whitespace comes between a scalar and the next token
+    begin = token(m_k);
+    end = (m_k + 1 == m_index_size) ? m_end : token(m_k + 1);
+    while (DYND_ISSPACE(end[-1])) {
+      --end;
+    }
+    ++m_k;
+  }
+
+  /**
+   * Converts a scalar with one of the functions of the character parser,
+   * which has to use up all of its text.
+   */
+  template <typename ParseType>
+  void parse_scalar(ParseType parse)
+  {
+    const char *begin, *end;
+    parse_scalar(begin, end);
+    parse(begin, end);
+    if (begin != end) {
+      fail();
+    }
+  }
+
+  /**
+   * Skips a value, checking it the same way as ``skip_json_value``.
+   */
+  void skip()
+  {
+    const char *strbegin, *strend;
+    bool escaped;
+    switch (peek()) {
+    case '{':
+      consume();
+      if (!accept('}')) {
+        for (;;) {
+          parse_string(strbegin, strend, escaped);
+          expect(':');
+          skip();
+          if (!accept(',')) {
+            break;
+          }
+        }
+        expect('}');
+      }
+      break;
+    case '[':
+      consume();
+      if (!accept(']')) {
+        for (;;) {
+          skip();
+          if (!accept(',')) {
+            break;
+          }
+        }
+        expect(']');
+      }
+      break;
+    case '"':
+      parse_string(strbegin, strend, escaped);
+      break;
+    default: {
+      const char *begin, *end;
+      parse_scalar(begin, end);
+      if (!compare_range_to_literal(begin, end, "true") && !compare_range_to_literal(begin, end, "false") &&
+          !compare_range_to_literal(begin, end, "null") &&
+          !(json::parse_number(begin, end, strbegin, strend) && begin == end)) {
+        fail();
+      }
+    }
+    }
+  }
+
+  void parse_strided_dim(const ndt::type &tp, const char *arrmeta, char *out_data)
+  {
+    intptr_t dim_size, stride;
+    ndt::type el_tp;
+    const char *el_arrmeta;
+    if (!tp.get_as_strided(arrmeta, &dim_size, &stride, &el_tp, &el_arrmeta)) {
+      fail();
+    }
+
+    expect('[');
+    for (intptr_t i = 0; i < dim_size; ++i) {
+      parse(el_tp, el_arrmeta, out_data + i * stride);
+      if (i < dim_size - 1) {
+        expect(',');
+      }
+    }
+    expect(']');
+  }
+
+  void parse_var_dim(const ndt::type &tp, const char *arrmeta, char *out_data)
+  {
+    const ndt::var_dim_type::metadata_type *md = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(arrmeta);
+    const ndt::type &element_tp = tp.extended<ndt::var_dim_type>()->get_element_type();
+    ndt::var_dim_type::data_type *out = reinterpret_cast<ndt::var_dim_type::data_type *>(out_data);
+
+    intptr_t size = 0, allocated_size = 8;
+    out->begin = md->blockref->alloc(allocated_size);
+
+    expect('[');
+    if (!accept(']')) {
+      for (;;) {
+        if (size == allocated_size) {
+          allocated_size *= 2;
+          out->begin = md->blockref->resize(out->begin, allocated_size);
+        }
+        ++size;
+        out->size = size;
+        parse(element_tp, arrmeta + sizeof(ndt::var_dim_type::metadata_type), out->begin + (size - 1) * md->stride);
+        if (!accept(',')) {
+          break;
+        }
+      }
+      expect(']');
+    }
+
+    out->begin = md->blockref->resize(out->begin, size);
+    out->size = size;
+  }
+
+  void parse_tuple_from_list(const ndt::type &tp, const char *arrmeta, char *out_data)
+  {
+    auto fsd = tp.extended<ndt::tuple_type>();
+    intptr_t field_count = fsd->get_field_count();
+    const uintptr_t *data_offsets = reinterpret_cast<const uintptr_t *>(arrmeta);
+    const std::vector<uintptr_t> &arrmeta_offsets = fsd->get_arrmeta_offsets();
+
+    for (intptr_t i = 0; i != field_count; ++i) {
+      parse(fsd->get_field_type(i), arrmeta + arrmeta_offsets[i], out_data + data_offsets[i]);
+      if (i != field_count - 1) {
+        expect(',');
+      }
+    }
+    expect(']');
+  }
+
+  void parse_struct_from_object(const ndt::type &tp, const char *arrmeta, char *out_data)
+  {
+    const ndt::struct_type *fsd = tp.extended<ndt::struct_type>();
+    intptr_t field_count = fsd->get_field_count();
+    const uintptr_t *data_offsets = reinterpret_cast<const uintptr_t *>(arrmeta);
+    const std::vector<uintptr_t> &arrmeta_offsets = fsd->get_arrmeta_offsets();
+
+    shortvector<bool, 64> populated_fields(field_count);
+    memset(populated_fields.get(), 0, sizeof(bool) * field_count);
+
+    if (!accept('}')) {
+      intptr_t i = -1;
+      for (;;) {
+        const char *strbegin, *strend;
+        bool escaped;
+        parse_string(strbegin, strend, escaped);
+        expect(':');
+        if (escaped) {
+          std::string name;
+          unescape_string(strbegin, strend, name);
+          i = find_field(fsd, name.data(), name.data() + name.size(), i + 1);
+        }
+        else {
+          i = find_field(fsd, strbegin, strend, i + 1);
+        }
+        if (i == -1) {
+          skip();
+        }
+        else {
+          parse(fsd->get_field_type(i), arrmeta + arrmeta_offsets[i], out_data + data_offsets[i]);
+          populated_fields[i] = true;
+        }
+        if (!accept(',')) {
+          break;
+        }
+      }
+      expect('}');
+    }
+
+    for (intptr_t i = 0; i < field_count; ++i) {
+      if (!populated_fields[i]) {
+        const ndt::type &field_tp = fsd->get_field_type(i);
+        if (field_tp.get_id() != option_id) {
+          fail();
+        }
+        nd::old_assign_na(field_tp, arrmeta + arrmeta_offsets[i], out_data + data_offsets[i]);
+      }
+    }
+  }
+
+  void parse_string_value(const ndt::type &tp, const char *arrmeta, char *out_data)
+  {
+    const char *strbegin, *strend;
+    bool escaped;
+    parse_string(strbegin, strend, escaped);
+
+    std::string val;
+    if (escaped) {
+      unescape_string(strbegin, strend, val);
+      strbegin = val.data();
+      strend = val.data() + val.size();
+    }
+
+    // ASCII is valid UTF-8 that every error mode keeps as it is
+    if (tp.get_id() == string_id && is_ascii(strbegin, strend)) {
+      reinterpret_cast<dynd::string *>(out_data)->assign(strbegin, strend - strbegin);
+    }
+    else {
+      tp.extended<ndt::base_string_type>()->set_from_utf8_string(arrmeta, out_data, strbegin, strend, m_ectx);
+    }
+  }
+
+public:
+  indexed_json_parser(const char *begin, const char *end, const std::vector<uint32_t> &index,
+                      const eval::eval_context *ectx)
+      : m_begin(begin), m_end(end), m_index(index.data()), m_index_size(index.size()), m_k(0), m_ectx(ectx)
+  {
+  }
+
+  void parse(const ndt::type &tp, const char *arrmeta, char *out_data)
+  {
+    switch (tp.get_id()) {
+    case fixed_dim_id:
+      parse_strided_dim(tp, arrmeta, out_data);
+      return;
+    case var_dim_id:
+      parse_var_dim(tp, arrmeta, out_data);
+      return;
+    case struct_id:
+      if (accept('{')) {
+        parse_struct_from_object(tp, arrmeta, out_data);
+      }
+      else {
+        expect('[');
+        parse_tuple_from_list(tp, arrmeta, out_data);
+      }
+      return;
+    case tuple_id:
+      expect('[');
+      parse_tuple_from_list(tp, arrmeta, out_data);
+      return;
+    case bool_id:
+      parse_scalar([&](const char *&begin, const char *end) {
+        parse_bool_json(tp, arrmeta, out_data, begin, end, false, m_ectx);
+      });
+      return;
+    case int8_id:
+    case int16_id:
+    case int32_id:
+    case int64_id:
+    case int128_id:
+    case uint8_id:
+    case uint16_id:
+    case uint32_id:
+    case uint64_id:
+    case uint128_id:
+    case float16_id:
+    case float32_id:
+    case float64_id:
+    case float128_id:
+    case complex_float32_id:
+    case complex_float64_id:
+      parse_scalar([&](const char *&begin, const char *end) {
+        parse_number_json(tp, out_data, begin, end, false, m_ectx);
+      });
+      return;
+    case fixed_string_id:
+    case string_id:
+    case string_view_id:
+      parse_string_value(tp, arrmeta, out_data);
+      return;
+    case type_id:
+      parse_scalar([&](const char *&begin, const char *end) {
+        parse_type(tp, arrmeta, out_data, begin, end, false, m_ectx);
+      });
+      return;
+    case option_id:
+      if (!tp.is_scalar()) {
+        fail();
+      }
+      parse_scalar([&](const char *&begin, const char *end) {
+        parse_option_json(tp, arrmeta, out_data, begin, end, m_ectx);
+      });
+      return;
+    default:
+      fail();
+    }
+  }
+
+  /**
+   * Parses the whole JSON as one value of the type.
+   */
+  void parse_all(const ndt::type &tp, const char *arrmeta, char *out_data)
+  {
+    parse(tp, arrmeta, out_data);
+    if (m_k != m_index_size) {
+      fail();
+    }
+  }
+};
+
+/**
+ * Parses with ``indexed_json_parser``, returning false if it turned the
+ * JSON down and the character parser has to go over it. The index is built
+ * in ``index``, which callers parsing many values reuse.
+ */
+bool parse_indexed_json(const ndt::type &tp, const char *arrmeta, char *out_data, const char *json_begin,
+                        const char *json_end, std::vector<uint32_t> &index, const eval::eval_context *ectx)
+{
+  index.clear();
+  if (!json::structural_index(json_begin, json_end, index)) {
+    return false;
+  }
+
+  try {
+    indexed_json_parser(json_begin, json_end, index, ectx).parse_all(tp, arrmeta, out_data);
+  }
+  catch (const json_index_fallback &) {
+    return false;
+  }
+  catch (const std::exception &) {
+    return false;
+  }
+  catch (const dynd::dynd_exception &) {
+    return false;
+  }
+
+  return true;
+}
+
+} // anonymous namespace
+
 /**
  * Returns the row/column where the error occured, as well as the current and
  * previous
@@ -749,12 +1464,16 @@ void dynd::validate_json(const char *json_begin, const char *json_end)
   }
 }
 
-void dynd::parse_json(nd::array &out, const char *json_begin, const char *json_end, const eval::eval_context *ectx)
+/**
+ * Parses JSON as one value of a type with the character parser, with the
+ * line numbers of errors counted from ``first_line``.
+ */
+static void parse_json_chars(const ndt::type &tp, const char *arrmeta, char *out_data, const char *json_begin,
+                             const char *json_end, intptr_t first_line, const eval::eval_context *ectx)
 {
   try {
     const char *begin = json_begin, *end = json_end;
-    ndt::type tp = out.get_type();
-    ::parse_json(tp, out.get()->metadata(), out.data(), begin, end, ectx);
+    ::parse_json(tp, arrmeta, out_data, begin, end, ectx);
     skip_whitespace(begin, end);
     if (begin != end) {
       throw json_parse_error(begin, "unexpected trailing JSON text", tp);
@@ -765,7 +1484,7 @@ void dynd::parse_json(nd::array &out, const char *json_begin, const char *json_e
     std::string line_prev, line_cur;
     int line, column;
     get_error_line_column(json_begin, json_end, e.get_position(), line_prev, line_cur, line, column);
-    ss << "Error parsing JSON at line " << line << ", column " << column << "\n";
+    ss << "Error parsing JSON at line " << (first_line + line - 1) << ", column " << column << "\n";
     ss << "DyND Type: " << e.get_type() << "\n";
     ss << "Message: " << e.what() << "\n";
     print_json_parse_error_marker(ss, line_prev, line_cur, line, column);
@@ -776,28 +1495,510 @@ void dynd::parse_json(nd::array &out, const char *json_begin, const char *json_e
     std::string line_prev, line_cur;
     int line, column;
     get_error_line_column(json_begin, json_end, e.get_position(), line_prev, line_cur, line, column);
-    ss << "Error parsing JSON at line " << line << ", column " << column << "\n";
+    ss << "Error parsing JSON at line " << (first_line + line - 1) << ", column " << column << "\n";
     ss << "Message: " << e.what() << "\n";
     print_json_parse_error_marker(ss, line_prev, line_cur, line, column);
     throw invalid_argument(ss.str());
   }
 }
 
-nd::array dynd::parse_json(const ndt::type &tp, const char *json_begin, const char *json_end,
-                           const eval::eval_context *ectx)
+/**
+ * Parses JSON as one value of a type, the way ``parse_json`` does, with the
+ * line numbers of errors counted from ``first_line``.
+ *
+ * The memory blocks of var dimensions can not give back what the structural
+ * parser allocated before turning the JSON down, and they may be shared with
+ * other values, so a type with any is first parsed into a value of its own
+ * that is only copied over when it succeeds.
+ */
+static void parse_json_value(const ndt::type &tp, const char *arrmeta, char *out_data, const char *json_begin,
+                             const char *json_end, std::vector<uint32_t> &index, intptr_t first_line,
+                             const eval::eval_context *ectx)
 {
-  nd::array result;
-  result = nd::empty(tp);
-  parse_json(result, json_begin, json_end, ectx);
-  if (!tp.is_builtin()) {
-    tp.extended()->arrmeta_finalize_buffers(result.get()->metadata());
+  if ((tp.get_flags() & type_flag_blockref) == 0) {
+    if (parse_indexed_json(tp, arrmeta, out_data, json_begin, json_end, index, ectx)) {
+      return;
+    }
   }
-  return result;
-}
-
-/*
-static ndt::type discover_type(const char *&begin, const char *end)
-{
+  else {
+    nd::array value = nd::empty(tp);
+    if (parse_indexed_json(tp, value.get()->metadata(), value.data(), json_begin, json_end, index, ectx)) {
+      // Parsing replaces the old value, so its var dims are emptied first,
+      // rather than broadcast into by the assignment
+      if (tp.get_flags() & type_flag_destructor) {
+        tp.extended()->data_destruct(arrmeta, out_data);
+      }
+      if (tp.get_flags() & type_flag_zeroinit) {
+        memset(out_data, 0, tp.get_data_size());
+      }
+      if (tp.get_flags() & type_flag_construct) {
+        tp.extended()->data_construct(arrmeta, out_data);
+      }
+
+      const char *value_arrmeta = value.get()->metadata();
+      char *value_data = value.data();
+      nd::array error_mode = ectx->errmode;
+      nd::assign->call(tp, arrmeta, out_data, 1, &tp, &value_arrmeta, &value_data, 1, &error_mode,
+                       std::map<std::string, ndt::type>());
+      return;
+    }
+  }
+
+  parse_json_chars(tp, arrmeta, out_data, json_begin, json_end, first_line, ectx);
+}
+
+void dynd::parse_json(nd::array &out, const char *json_begin, const char *json_end, const eval::eval_context *ectx)
+{
+  std::vector<uint32_t> index;
+  parse_json_value(out.get_type(), out.get()->metadata(), out.data(), json_begin, json_end, index, 1, ectx);
+}
+
+nd::array dynd::parse_json(const ndt::type &tp, const char *json_begin, const char *json_end,
+                           const eval::eval_context *ectx)
+{
+  // The result is not shared yet, so when the structural parser turns the
+  // JSON down, whatever it allocated goes away with it, and the character
+  // parser starts over from a fresh one
+  std::vector<uint32_t> index;
+  nd::array result = nd::empty(tp);
+  if (!parse_indexed_json(tp, result.get()->metadata(), result.data(), json_begin, json_end, index, ectx)) {
+    result = nd::empty(tp);
+    parse_json_chars(tp, result.get()->metadata(), result.data(), json_begin, json_end, 1, ectx);
+  }
+  if (!tp.is_builtin()) {
+    tp.extended()->arrmeta_finalize_buffers(result.get()->metadata());
+  }
+  return result;
+}
+
+namespace {
+
+/**
+ * A run of whole lines of newline-delimited JSON, with the line number of its
+ * first line and the index of its first value among those of the chunk.
+ */
+struct ndjson_piece {
+  const char *begin;
+  const char *end;
+  intptr_t first_line;
+  intptr_t first_value;
+};
+
+const char *ndjson_line_end(const char *begin, const char *end)
+{
+  const char *res = static_cast<const char *>(memchr(begin, '\n', end - begin));
+  return (res == NULL) ? end : res;
+}
+
+bool is_blank_line(const char *begin, const char *end)
+{
+  for (; begin != end; ++begin) {
+    if (!DYND_ISSPACE(*begin)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Splits whole lines of newline-delimited JSON at newlines into about
+ * ``npieces`` pieces of the same size, and returns how many values they hold.
+ */
+intptr_t split_ndjson(const char *begin, const char *end, intptr_t first_line, size_t npieces,
+                      std::vector<ndjson_piece> &out)
+{
+  intptr_t value_count = 0;
+  const char *piece_begin = begin;
+  for (size_t i = 0; i < npieces && piece_begin != end; ++i) {
+    const char *piece_end = end;
+    if (i < npieces - 1) {
+      piece_end = begin + (end - begin) * (i + 1) / npieces;
+      piece_end = (piece_end < piece_begin) ? piece_begin : piece_end;
+      piece_end = (piece_end == end) ? end : ndjson_line_end(piece_end, end);
+      piece_end = (piece_end == end) ? end : piece_end + 1;
+    }
+
+    ndjson_piece piece = {piece_begin, piece_end, first_line, value_count};
+    for (const char *line = piece_begin; line != piece_end; ++first_line) {
+      const char *line_end = ndjson_line_end(line, piece_end);
+      if (!is_blank_line(line, line_end)) {
+        ++value_count;
+      }
+      line = (line_end == piece_end) ? piece_end : line_end + 1;
+    }
+    out.push_back(piece);
+    piece_begin = piece_end;
+  }
+
+  return value_count;
+}
+
+/**
+ * The number of pieces to split a chunk of newline-delimited JSON into, which
+ * is one unless its values can be parsed on the thread pool. Values with a
+ * var dimension allocate from the one memory block of the array, which is
+ * not safe to share between threads.
+ */
+size_t ndjson_piece_count(const ndt::type &tp, const eval::eval_context *ectx)
+{
+  if (ectx->nthreads <= 1 || detail::in_parallel_region() || (tp.get_flags() & type_flag_blockref) != 0) {
+    return 1;
+  }
+
+  return static_cast<size_t>(4 * ectx->nthreads);
+}
+
+/**
+ * Parses the values of one piece into consecutive elements ``stride`` apart.
+ */
+void parse_ndjson_piece(const ndt::type &tp, const char *arrmeta, char *out_data, intptr_t stride,
+                        const ndjson_piece &piece, const eval::eval_context *ectx)
+{
+  std::vector<uint32_t> index;
+  out_data += piece.first_value * stride;
+  intptr_t line = piece.first_line;
+  for (const char *begin = piece.begin; begin != piece.end; ++line) {
+    const char *line_end = ndjson_line_end(begin, piece.end);
+    if (!is_blank_line(begin, line_end)) {
+      parse_json_value(tp, arrmeta, out_data, begin, line_end, index, line, ectx);
+      out_data += stride;
+    }
+    begin = (line_end == piece.end) ? piece.end : line_end + 1;
+  }
+}
+
+/**
+ * Parses the values of the pieces of a chunk into elements ``stride`` apart,
+ * on the thread pool when there are enough of them.
+ */
+void parse_ndjson_pieces(const ndt::type &tp, const char *arrmeta, char *out_data, intptr_t stride,
+                         const std::vector<ndjson_piece> &pieces, intptr_t value_count, const eval::eval_context *ectx)
+{
+  if (pieces.size() > 1 && runs_in_parallel(value_count, ectx)) {
+    detail::parallel_run(pieces.size(),
+                         [&](size_t i) { parse_ndjson_piece(tp, arrmeta, out_data, stride, pieces[i], ectx); },
+                         ectx->nthreads);
+  }
+  else {
+    for (const ndjson_piece &piece : pieces) {
+      parse_ndjson_piece(tp, arrmeta, out_data, stride, piece, ectx);
+    }
+  }
+}
+
+/**
+ * Appends the values of whole lines of newline-delimited JSON to a
+ * ``var * T`` array, whose allocation grows geometrically.
+ */
+void append_ndjson(nd::array &res, intptr_t &allocated_size, const char *begin, const char *end, intptr_t first_line,
+                   const eval::eval_context *ectx)
+{
+  const ndt::type &element_tp = res.get_type().extended<ndt::var_dim_type>()->get_element_type();
+  const ndt::var_dim_type::metadata_type *md =
+      reinterpret_cast<const ndt::var_dim_type::metadata_type *>(res.get()->metadata());
+  ndt::var_dim_type::data_type *out = reinterpret_cast<ndt::var_dim_type::data_type *>(res.data());
+
+  std::vector<ndjson_piece> pieces;
+  intptr_t value_count = split_ndjson(begin, end, first_line, ndjson_piece_count(element_tp, ectx), pieces);
+  if (value_count == 0) {
+    return;
+  }
+
+  intptr_t size = static_cast<intptr_t>(out->size);
+  if (out->begin == NULL) {
+    allocated_size = std::max(value_count, static_cast<intptr_t>(8));
+    out->begin = md->blockref->alloc(allocated_size);
+  }
+  else if (size + value_count > allocated_size) {
+    allocated_size = std::max(size + value_count, 2 * allocated_size);
+    out->begin = md->blockref->resize(out->begin, allocated_size);
+  }
+  out->size = size + value_count;
+
+  parse_ndjson_pieces(element_tp, res.get()->metadata() + sizeof(ndt::var_dim_type::metadata_type),
+                      out->begin + size * md->stride, md->stride, pieces, value_count, ectx);
+}
+
+/**
+ * Shrinks the allocation of a ``var * T`` array made by ``append_ndjson`` to
+ * fit its values.
+ */
+void finish_ndjson(nd::array &res)
+{
+  const ndt::var_dim_type::metadata_type *md =
+      reinterpret_cast<const ndt::var_dim_type::metadata_type *>(res.get()->metadata());
+  ndt::var_dim_type::data_type *out = reinterpret_cast<ndt::var_dim_type::data_type *>(res.data());
+  if (out->begin != NULL) {
+    out->begin = md->blockref->resize(out->begin, out->size);
+  }
+  res.get_type().extended()->arrmeta_finalize_buffers(res.get()->metadata());
+}
+
+intptr_t count_lines(const char *begin, const char *end)
+{
+  intptr_t res = 0;
+  for (; (begin = static_cast<const char *>(memchr(begin, '\n', end - begin))) != NULL; ++begin) {
+    ++res;
+  }
+
+  return res;
+}
+
+size_t read_fd(int fd, char *buffer, size_t size)
+{
+  for (;;) {
+#ifdef _WIN32
+    int res = _read(fd, buffer, static_cast<unsigned int>(std::min(size, static_cast<size_t>(INT_MAX))));
+#else
+    ssize_t res = ::read(fd, buffer, size);
+#endif
+    if (res >= 0) {
+      return static_cast<size_t>(res);
+    }
+    if (errno != EINTR) {
+      throw std::runtime_error(std::string("error reading NDJSON: ") + strerror(errno));
+    }
+  }
+}
+
+} // anonymous namespace
+
+nd::json::ndjson_reader::ndjson_reader(const ndt::type &tp, const source_type &source, size_t chunk_size,
+                                       const eval::eval_context *ectx)
+    : m_tp(tp), m_source(source), m_ectx(ectx), m_buffer(std::max(chunk_size, static_cast<size_t>(1))), m_begin(0),
+      m_end(0), m_eof(false), m_line(1)
+{
+}
+
+nd::json::ndjson_reader::ndjson_reader(const ndt::type &tp, int fd, size_t chunk_size,
+                                       const eval::eval_context *ectx)
+    : ndjson_reader(tp, [fd](char *buffer, size_t size) { return read_fd(fd, buffer, size); }, chunk_size, ectx)
+{
+}
+
+bool nd::json::ndjson_reader::read_chunk(const char *&begin, const char *&end)
+{
+  // Moves the start of a line cut off by the previous chunk to the front
+  if (m_begin != 0) {
+    memmove(m_buffer.data(), m_buffer.data() + m_begin, m_end - m_begin);
+    m_end -= m_begin;
+    m_begin = 0;
+  }
+
+  for (;;) {
+    while (!m_eof && m_end < m_buffer.size()) {
+      size_t size = m_source(m_buffer.data() + m_end, m_buffer.size() - m_end);
+      if (size == 0) {
+        m_eof = true;
+      }
+      m_end += size;
+    }
+    if (m_end == 0) {
+      return false;
+    }
+
+    // The chunk ends after its last newline, or at the end of the input
+    size_t chunk_end = m_end;
+    if (!m_eof) {
+      while (chunk_end != 0 && m_buffer[chunk_end - 1] != '\n') {
+        --chunk_end;
+      }
+    }
+    if (chunk_end != 0) {
+      begin = m_buffer.data();
+      end = m_buffer.data() + chunk_end;
+      return true;
+    }
+
+    // No line ends in the buffer, so it has to grow to fit one
+    m_buffer.resize(2 * m_buffer.size());
+  }
+}
+
+bool nd::json::ndjson_reader::next(array &out)
+{
+  const char *begin, *end;
+  while (read_chunk(begin, end)) {
+    std::vector<ndjson_piece> pieces;
+    intptr_t value_count = split_ndjson(begin, end, m_line, ndjson_piece_count(m_tp, m_ectx), pieces);
+    if (value_count != 0) {
+      array res = empty(value_count, m_tp);
+      const fixed_dim_type_arrmeta *md = reinterpret_cast<const fixed_dim_type_arrmeta *>(res.get()->metadata());
+      parse_ndjson_pieces(m_tp, res.get()->metadata() + sizeof(fixed_dim_type_arrmeta), res.data(), md->stride,
+                          pieces, value_count, m_ectx);
+      res.get_type().extended()->arrmeta_finalize_buffers(res.get()->metadata());
+      out = res;
+    }
+
+    m_begin = end - m_buffer.data();
+    m_line += count_lines(begin, end);
+    if (value_count != 0) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+nd::array nd::json::ndjson_reader::read_all()
+{
+  array res = empty(ndt::make_type<ndt::var_dim_type>(m_tp));
+  intptr_t allocated_size = 0;
+  const char *begin, *end;
+  while (read_chunk(begin, end)) {
+    append_ndjson(res, allocated_size, begin, end, m_line, m_ectx);
+    m_begin = end - m_buffer.data();
+    m_line += count_lines(begin, end);
+  }
+
+  finish_ndjson(res);
+  return res;
+}
+
+nd::array nd::json::parse_ndjson(const ndt::type &tp, const char *begin, const char *end,
+                                 const eval::eval_context *ectx)
+{
+  array res = empty(ndt::make_type<ndt::var_dim_type>(tp));
+  intptr_t allocated_size = 0;
+  append_ndjson(res, allocated_size, begin, end, 1, ectx);
+  finish_ndjson(res);
+  return res;
+}
+
+namespace {
+
+/**
+ * The type discovered for a null, which unifies with any other type by
+ * making it optional.
+ */
+bool is_null_type(const ndt::type &tp)
+{
+  return tp.get_id() == option_id && tp.extended<ndt::option_type>()->get_value_type().get_id() == any_kind_id;
+}
+
+bool is_empty_tuple(const ndt::type &tp)
+{
+  return tp.get_id() == tuple_id && tp.extended<ndt::tuple_type>()->get_field_count() == 0;
+}
+
+bool is_dim(const ndt::type &tp) { return tp.get_id() == fixed_dim_id || tp.get_id() == var_dim_id; }
+
+ndt::type make_optional(const ndt::type &tp)
+{
+  return (tp.get_id() == option_id) ? tp : ndt::make_type<ndt::option_type>(tp);
+}
+
+const ndt::type &without_option(const ndt::type &tp)
+{
+  return (tp.get_id() == option_id) ? tp.extended<ndt::option_type>()->get_value_type() : tp;
+}
+
+const ndt::type &dim_element_type(const ndt::type &tp)
+{
+  return tp.extended<ndt::base_dim_type>()->get_element_type();
+}
+
+ndt::type unify_discovered(const ndt::type &tp0, const ndt::type &tp1);
+
+/**
+ * The struct of the fields of two structs, with the fields of the first in
+ * their order followed by those only the second has, which are optional
+ * like those only the first has.
+ */
+ndt::type unify_discovered_structs(const ndt::struct_type *sd0, const ndt::struct_type *sd1)
+{
+  std::vector<std::string> names = sd0->get_field_names();
+  std::vector<ndt::type> types;
+  for (intptr_t i = 0; i < sd0->get_field_count(); ++i) {
+    intptr_t j = sd1->get_field_index(names[i]);
+    ndt::type tp = (j < 0) ? make_optional(sd0->get_field_type(i))
+                           : unify_discovered(sd0->get_field_type(i), sd1->get_field_type(j));
+    if (tp.is_null()) {
+      return tp;
+    }
+    types.push_back(tp);
+  }
+
+  for (intptr_t j = 0; j < sd1->get_field_count(); ++j) {
+    if (sd0->get_field_index(sd1->get_field_name(j)) < 0) {
+      names.push_back(sd1->get_field_name(j));
+      types.push_back(make_optional(sd1->get_field_type(j)));
+    }
+  }
+
+  return ndt::make_type<ndt::struct_type>(names, types);
+}
+
+/**
+ * The type that values of two discovered types can both be parsed as, or
+ * the null type if there is none.
+ */
+ndt::type unify_discovered(const ndt::type &tp0, const ndt::type &tp1)
+{
+  if (tp0 == tp1) {
+    return tp0;
+  }
+  if (is_null_type(tp0)) {
+    return make_optional(tp1);
+  }
+  if (is_null_type(tp1)) {
+    return make_optional(tp0);
+  }
+  if (tp0.get_id() == option_id || tp1.get_id() == option_id) {
+    ndt::type res = unify_discovered(without_option(tp0), without_option(tp1));
+    return res.is_null() ? res : make_optional(res);
+  }
+
+  type_id_t id0 = tp0.get_id(), id1 = tp1.get_id();
+  if ((id0 == int64_id || id0 == float64_id) && (id1 == int64_id || id1 == float64_id)) {
+    return promote_types_arithmetic(tp0, tp1);
+  }
+
+  // An empty array is discovered as the empty tuple, which fits a dimension
+  // of any size
+  if (is_dim(tp0) && is_empty_tuple(tp1)) {
+    return ndt::make_type<ndt::var_dim_type>(dim_element_type(tp0));
+  }
+  if (is_empty_tuple(tp0) && is_dim(tp1)) {
+    return ndt::make_type<ndt::var_dim_type>(dim_element_type(tp1));
+  }
+  if (is_dim(tp0) && is_dim(tp1)) {
+    ndt::type element_tp = unify_discovered(dim_element_type(tp0), dim_element_type(tp1));
+    if (element_tp.is_null()) {
+      return element_tp;
+    }
+    if (id0 == fixed_dim_id && id1 == fixed_dim_id &&
+        tp0.extended<ndt::fixed_dim_type>()->get_fixed_dim_size() ==
+            tp1.extended<ndt::fixed_dim_type>()->get_fixed_dim_size()) {
+      return ndt::make_fixed_dim(tp0.extended<ndt::fixed_dim_type>()->get_fixed_dim_size(), element_tp);
+    }
+    return ndt::make_type<ndt::var_dim_type>(element_tp);
+  }
+
+  if (id0 == struct_id && id1 == struct_id) {
+    return unify_discovered_structs(tp0.extended<ndt::struct_type>(), tp1.extended<ndt::struct_type>());
+  }
+  if (id0 == tuple_id && id1 == tuple_id) {
+    const ndt::tuple_type *td0 = tp0.extended<ndt::tuple_type>(), *td1 = tp1.extended<ndt::tuple_type>();
+    if (td0->get_field_count() != td1->get_field_count()) {
+      return ndt::type();
+    }
+    std::vector<ndt::type> types;
+    for (intptr_t i = 0; i < td0->get_field_count(); ++i) {
+      types.push_back(unify_discovered(td0->get_field_type(i), td1->get_field_type(i)));
+      if (types.back().is_null()) {
+        return ndt::type();
+      }
+    }
+    return ndt::make_type<ndt::tuple_type>(types.size(), types.data());
+  }
+
+  return ndt::type();
+}
+
+ndt::type discover_type(const char *&begin, const char *end)
+{
   skip_whitespace(begin, end);
   if (begin == end) {
     throw parse_error(begin, "malformed JSON, expecting an element");
@@ -808,7 +2009,7 @@ static ndt::type discover_type(const char *&begin, const char *end)
   case '{': {
     ++begin;
     if (parse_token(begin, end, "}")) {
-      return ndt::struct_type::make();
+      return ndt::make_type<ndt::struct_type>();
     }
     std::vector<std::string> names;
     std::vector<ndt::type> types;
@@ -831,32 +2032,28 @@ static ndt::type discover_type(const char *&begin, const char *end)
     if (!parse_token(begin, end, "}")) {
       throw parse_error(begin, "expected object separator ',' or terminator '}'");
     }
-    return ndt::struct_type::make(names, types);
+    return ndt::make_type<ndt::struct_type>(names, types);
   }
   // Array
   case '[': {
     ++begin;
     if (parse_token(begin, end, "]")) {
-      return ndt::tuple_type::make();
+      return ndt::make_type<ndt::tuple_type>();
     }
     std::vector<ndt::type> types;
     ndt::type common_tp = discover_type(begin, end);
     types.push_back(common_tp);
-    for (;;) {
-      if (!parse_token(begin, end, ",")) {
-        break;
-      }
-      const ndt::type &tp = discover_type(begin, end);
+    while (parse_token(begin, end, ",")) {
+      types.push_back(discover_type(begin, end));
       if (!common_tp.is_null()) {
-        common_tp = ndt::common_type(common_tp, tp);
+        common_tp = unify_discovered(common_tp, types.back());
       }
-      types.push_back(tp);
     }
     if (!parse_token(begin, end, "]")) {
       throw parse_error(begin, "expected array separator ',' or terminator ']'");
     }
     if (common_tp.is_null()) {
-      return ndt::tuple_type::make(types);
+      return ndt::make_type<ndt::tuple_type>(types.size(), types.data());
     }
     return ndt::make_fixed_dim(types.size(), common_tp);
   }
@@ -866,7 +2063,7 @@ static ndt::type discover_type(const char *&begin, const char *end)
     if (!parse_doublequote_string_no_ws(begin, end, strbegin, strend, escaped)) {
       throw parse_error(begin, "invalid string");
     }
-    return ndt::type(string_id);
+    return ndt::make_type<dynd::string>();
   }
   case 'T':
   case 't':
@@ -893,48 +2090,291 @@ static ndt::type discover_type(const char *&begin, const char *end)
       if (!json::parse_number(begin, end, nbegin, nend)) {
         throw parse_error(begin, "invalid number");
       }
-      int64_t int_val;
+      for (const char *p = nbegin; p != nend; ++p) {
+        if (*p == '.' || *p == 'e' || *p == 'E') {
+          return ndt::make_type<double>();
+        }
+      }
+      // Integers too large for int64 are float64
       try {
-        parse_int64(int_val, nbegin, nend);
+        parse<int64_t>(nbegin, nend);
         return ndt::make_type<int64>();
       }
-      catch (...) {
-      }
-      double float_val;
-      if (!parse_double(float_val, nbegin, nend)) {
+      catch (const std::exception &) {
         return ndt::make_type<double>();
       }
-      throw parse_error(begin, "invalid json value");
     }
     else {
       throw parse_error(begin, "invalid json value");
     }
   }
+}
+
+/**
+ * Discovers the type of one whole JSON value, with nothing but whitespace
+ * after it.
+ */
+ndt::type discover_value(const char *begin, const char *end)
+{
+  ndt::type res = discover_type(begin, end);
+  skip_whitespace(begin, end);
+  if (begin != end) {
+    throw parse_error(begin, "unexpected trailing JSON text");
+  }
+
+  return res;
+}
+
+void throw_discover_error(const char *json_begin, const char *json_end, const parse_error &e)
+{
+  stringstream ss;
+  std::string line_prev, line_cur;
+  int line, column;
+  get_error_line_column(json_begin, json_end, e.get_position(), line_prev, line_cur, line, column);
+  ss << "Error discovering the type of JSON at line " << line << ", column " << column << "\n";
+  ss << "Message: " << e.what() << "\n";
+  print_json_parse_error_marker(ss, line_prev, line_cur, line, column);
+  throw invalid_argument(ss.str());
+}
+
+typedef std::pair<const char *, const char *> json_range;
+
+/**
+ * Whether the value at position ``i`` is one that ``opts`` picks, and
+ * whether no value from ``i`` on is.
+ */
+bool is_sampled(intptr_t i, const ndt::json::discover_options &opts) { return i % opts.stride == 0; }
+
+bool is_past_sample(intptr_t i, const ndt::json::discover_options &opts)
+{
+  return opts.max_values > 0 && i >= opts.max_values * opts.stride;
+}
+
+/**
+ * Finds the elements of a document that is an array with the offsets of
+ * ``json::structural_index``, following only the brackets and commas outside
+ * of the elements, and appends those picked by ``opts``. Returns false if
+ * the document is not an array, or if the index can not be made.
+ */
+bool sample_array_elements(const char *begin, const char *end, const ndt::json::discover_options &opts,
+                           std::vector<json_range> &out, intptr_t &size)
+{
+  std::vector<uint32_t> index;
+  if (!json::structural_index(begin, end, index) || index.empty() || begin[index[0]] != '[') {
+    return false;
+  }
+
+  size = 0;
+  intptr_t depth = 0;
+  const char *element_begin = begin + index[0] + 1;
+  for (size_t k = 1; k < index.size(); ++k) {
+    char c = begin[index[k]];
+    if (c == '[' || c == '{') {
+      ++depth;
+    }
+    else if ((c == ']' || c == '}') && depth > 0) {
+      --depth;
+    }
+    else if (depth == 0 && (c == ',' || c == ']')) {
+      const char *element_end = begin + index[k];
+      if (c == ']' && size == 0 && is_blank_line(element_begin, element_end)) {
+        return k + 1 == index.size();
+      }
+      if (is_sampled(size, opts) && !is_past_sample(size, opts)) {
+        out.push_back(json_range(element_begin, element_end));
+      }
+      ++size;
+      element_begin = element_end + 1;
+      if (c == ']') {
+        // Anything after the closing bracket is an error
+        return k + 1 == index.size();
+      }
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Appends the lines of newline-delimited JSON that are not blank and are
+ * picked by ``opts``.
+ */
+void sample_ndjson_lines(const char *begin, const char *end, const ndt::json::discover_options &opts,
+                         std::vector<json_range> &out)
+{
+  intptr_t i = 0;
+  for (const char *line = begin; line != end && !is_past_sample(i, opts);) {
+    const char *line_end = ndjson_line_end(line, end);
+    if (!is_blank_line(line, line_end)) {
+      if (is_sampled(i, opts)) {
+        out.push_back(json_range(line, line_end));
+      }
+      ++i;
+    }
+    line = (line_end == end) ? end : line_end + 1;
+  }
+}
 
-  throw runtime_error("json parsing error");
+/**
+ * The common type of some JSON values, or the null type if they have none.
+ * When there are enough of them, they are split into consecutive chunks
+ * whose common types are found on the thread pool, and then unified in
+ * order, so the fields of structs come out in the same order either way.
+ */
+ndt::type discover_common_type(const std::vector<json_range> &values, const eval::eval_context *ectx)
+{
+  size_t nchunks = 1;
+  if (values.size() > 1 && runs_in_parallel(values.size(), ectx)) {
+    nchunks = std::min(values.size(), static_cast<size_t>(4 * ectx->nthreads));
+  }
+
+  std::vector<ndt::type> types(nchunks);
+  auto discover_chunk = [&](size_t i) {
+    size_t first = values.size() * i / nchunks, last = values.size() * (i + 1) / nchunks;
+    ndt::type res = discover_value(values[first].first, values[first].second);
+    for (size_t j = first + 1; j < last && !res.is_null(); ++j) {
+      res = unify_discovered(res, discover_value(values[j].first, values[j].second));
+    }
+    types[i] = res;
+  };
+  if (nchunks > 1) {
+    detail::parallel_run(nchunks, discover_chunk, ectx->nthreads);
+  }
+  else {
+    discover_chunk(0);
+  }
+
+  ndt::type res = types[0];
+  for (size_t i = 1; i < nchunks && !res.is_null(); ++i) {
+    res = types[i].is_null() ? types[i] : unify_discovered(res, types[i]);
+  }
+
+  return res;
 }
-*/
 
-/*
+/**
+ * The types discovered for named sources, with the names prefixed by what
+ * kind of input they were discovered from.
+ */
+struct discover_cache {
+  std::mutex mutex;
+  std::unordered_map<std::string, ndt::type> types;
+};
+
+discover_cache &get_discover_cache()
+{
+  static discover_cache cache;
+  return cache;
+}
+
+bool find_discovered(const std::string &key, ndt::type &res)
+{
+  discover_cache &cache = get_discover_cache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  auto it = cache.types.find(key);
+  if (it == cache.types.end()) {
+    return false;
+  }
+
+  res = it->second;
+  return true;
+}
+
+void add_discovered(const std::string &key, const ndt::type &tp)
+{
+  discover_cache &cache = get_discover_cache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  cache.types[key] = tp;
+}
+
+void check_discover_options(const ndt::json::discover_options &opts)
+{
+  if (opts.max_values < 0 || opts.stride < 1) {
+    stringstream ss;
+    ss << "invalid JSON discovery sample of at most " << opts.max_values << " values with stride " << opts.stride;
+    throw invalid_argument(ss.str());
+  }
+}
+
+} // anonymous namespace
+
 void ndt::json::discover(ndt::type &res, const char *json_begin, const char *json_end)
 {
   try {
-    const char *begin = json_begin, *end = json_end;
-    res = ::discover_type(begin, end);
-    skip_whitespace(begin, end);
-    if (begin != end) {
-      throw parse_error(begin, "unexpected trailing JSON text");
+    res = discover_value(json_begin, json_end);
+  }
+  catch (const parse_error &e) {
+    throw_discover_error(json_begin, json_end, e);
+  }
+}
+
+void ndt::json::discover(ndt::type &res, const char *json_begin, const char *json_end, const discover_options &opts,
+                         const eval::eval_context *ectx)
+{
+  check_discover_options(opts);
+  std::string key = "json:" + opts.cache_key;
+  if (!opts.cache_key.empty() && find_discovered(key, res)) {
+    return;
+  }
+
+  try {
+    std::vector<json_range> elements;
+    intptr_t size = 0;
+    // Without a sample or threads, one pass over the document does it
+    bool whole = opts.max_values == 0 && opts.stride == 1 && ectx->nthreads <= 1;
+    if (whole || !sample_array_elements(json_begin, json_end, opts, elements, size) || elements.empty()) {
+      res = discover_value(json_begin, json_end);
+    }
+    else {
+      ndt::type element_tp = discover_common_type(elements, ectx);
+      // Elements with no common type make a tuple, which needs all of them
+      res = element_tp.is_null() ? discover_value(json_begin, json_end) : ndt::make_fixed_dim(size, element_tp);
     }
   }
   catch (const parse_error &e) {
-    stringstream ss;
-    std::string line_prev, line_cur;
-    int line, column;
-    get_error_line_column(json_begin, json_end, e.get_position(), line_prev, line_cur, line, column);
-    ss << "Error validating JSON at line " << line << ", column " << column << "\n";
-    ss << "Message: " << e.what() << "\n";
-    print_json_parse_error_marker(ss, line_prev, line_cur, line, column);
-    throw invalid_argument(ss.str());
+    throw_discover_error(json_begin, json_end, e);
+  }
+
+  if (!opts.cache_key.empty()) {
+    add_discovered(key, res);
+  }
+}
+
+ndt::type ndt::json::discover_ndjson(const char *begin, const char *end, const discover_options &opts,
+                                     const eval::eval_context *ectx)
+{
+  check_discover_options(opts);
+  std::string key = "ndjson:" + opts.cache_key;
+  ndt::type res;
+  if (!opts.cache_key.empty() && find_discovered(key, res)) {
+    return res;
+  }
+
+  std::vector<json_range> lines;
+  sample_ndjson_lines(begin, end, opts, lines);
+  if (lines.empty()) {
+    throw invalid_argument("cannot discover the type of newline-delimited JSON with no values");
+  }
+
+  try {
+    res = discover_common_type(lines, ectx);
+  }
+  catch (const parse_error &e) {
+    throw_discover_error(begin, end, e);
+  }
+  if (res.is_null()) {
+    throw invalid_argument("the values of the newline-delimited JSON have no common type");
   }
+
+  if (!opts.cache_key.empty()) {
+    add_discovered(key, res);
+  }
+  return res;
+}
+
+void ndt::json::clear_discover_cache()
+{
+  discover_cache &cache = get_discover_cache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  cache.types.clear();
 }
-*/
@@ -10,4 +10,14 @@
 using namespace std;
 using namespace dynd;
 
-DYND_API nd::callable nd::all = nd::functional::reduction([] { return true; }, nd::make_callable<nd::all_callable>());
+namespace {
+
+nd::callable make_all_child() {
+  nd::callable f = nd::make_callable<nd::all_callable>();
+  f->set_thread_safe(true);
+  return f;
+}
+
+} // unnamed namespace
+
+DYND_API nd::callable nd::all = nd::functional::reduction([] { return true; }, make_all_child(), true);
@@ -21,27 +21,36 @@ double mysin(double x) { return sin(x); }
 double mytan(double x) { return tan(x); }
 double myexp(double x) { return exp(x); }
 
+nd::callable thread_safe(nd::callable f) {
+  f->set_thread_safe(true);
+  return f;
+}
+
 } // anonymous namespace
 
-DYND_API nd::callable nd::cos = nd::functional::elwise(nd::functional::apply<double (*)(double), &mycos>());
-DYND_API nd::callable nd::sin = nd::functional::elwise(nd::functional::apply<double (*)(double), &mysin>());
-DYND_API nd::callable nd::tan = nd::functional::elwise(nd::functional::apply<double (*)(double), &mytan>());
-DYND_API nd::callable nd::exp = nd::functional::elwise(nd::functional::apply<double (*)(double), &myexp>());
+DYND_API nd::callable nd::cos =
+    nd::functional::elwise(thread_safe(nd::functional::apply<double (*)(double), &mycos>()));
+DYND_API nd::callable nd::sin =
+    nd::functional::elwise(thread_safe(nd::functional::apply<double (*)(double), &mysin>()));
+DYND_API nd::callable nd::tan =
+    nd::functional::elwise(thread_safe(nd::functional::apply<double (*)(double), &mytan>()));
+DYND_API nd::callable nd::exp =
+    nd::functional::elwise(thread_safe(nd::functional::apply<double (*)(double), &myexp>()));
 
-DYND_API nd::callable nd::real = nd::functional::elwise(nd::make_callable<nd::multidispatch_callable<1>>(
+DYND_API nd::callable nd::real = nd::functional::elwise(thread_safe(nd::make_callable<nd::multidispatch_callable<1>>(
     ndt::type("(Scalar) -> Scalar"),
     nd::callable::make_all<nd::real_callable, type_sequence<dynd::complex<float>, dynd::complex<double>>>(
         [](const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc),
-           const ndt::type *src_tp) -> std::vector<ndt::type> { return {src_tp[0]}; })));
+           const ndt::type *src_tp) -> std::vector<ndt::type> { return {src_tp[0]}; }))));
 
-DYND_API nd::callable nd::imag = nd::functional::elwise(nd::make_callable<nd::multidispatch_callable<1>>(
+DYND_API nd::callable nd::imag = nd::functional::elwise(thread_safe(nd::make_callable<nd::multidispatch_callable<1>>(
     ndt::type("(Scalar) -> Scalar"),
     nd::callable::make_all<nd::imag_callable, type_sequence<dynd::complex<float>, dynd::complex<double>>>(
         [](const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc),
-           const ndt::type *src_tp) -> std::vector<ndt::type> { return {src_tp[0]}; })));
+           const ndt::type *src_tp) -> std::vector<ndt::type> { return {src_tp[0]}; }))));
 
-DYND_API nd::callable nd::conj = nd::functional::elwise(nd::make_callable<nd::multidispatch_callable<1>>(
+DYND_API nd::callable nd::conj = nd::functional::elwise(thread_safe(nd::make_callable<nd::multidispatch_callable<1>>(
     ndt::type("(Scalar) -> Scalar"),
     nd::callable::make_all<nd::conj_callable, type_sequence<dynd::complex<float>, dynd::complex<double>>>(
         [](const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc),
-           const ndt::type *src_tp) -> std::vector<ndt::type> { return {src_tp[0]}; })));
+           const ndt::type *src_tp) -> std::vector<ndt::type> { return {src_tp[0]}; }))));
@@ -0,0 +1,126 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <dynd/memblock/memory_allocator.hpp>
+#include <dynd/thread_cache.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+class malloc_allocator : public nd::base_memory_allocator {
+public:
+  char *allocate(intptr_t &size) {
+    char *ptr = reinterpret_cast<char *>(malloc(size));
+    if (ptr == NULL) {
+      throw bad_alloc();
+    }
+
+    return ptr;
+  }
+
+  void deallocate(char *ptr, intptr_t DYND_UNUSED(size)) { free(ptr); }
+};
+
+// The pooled sizes are the powers of two from 1 KiB to 1 MiB
+const int min_pool_shift = 10;
+const int max_pool_shift = 20;
+const int pool_class_count = max_pool_shift - min_pool_shift + 1;
+
+// The most chunks of a size that a thread keeps
+const size_t max_pool_chunk_count = 8;
+
+/**
+ * The chunks a thread keeps for reuse.
+ */
+struct pool_chunks {
+  char *chunks[pool_class_count][max_pool_chunk_count];
+  size_t count[pool_class_count];
+};
+
+void release_pool_chunks(pool_chunks &pool) {
+  for (int i = 0; i < pool_class_count; ++i) {
+    for (size_t j = 0; j < pool.count[i]; ++j) {
+      free(pool.chunks[i][j]);
+    }
+    pool.count[i] = 0;
+  }
+}
+
+typedef detail::thread_cache<pool_chunks, &release_pool_chunks> pool_cache;
+
+/**
+ * Returns the pooled size class that holds ``size`` bytes, or -1 if it is
+ * larger than all of them.
+ */
+int pool_class(intptr_t size) {
+  int res = 0;
+  while ((static_cast<intptr_t>(1) << (min_pool_shift + res)) < size) {
+    if (++res == pool_class_count) {
+      return -1;
+    }
+  }
+
+  return res;
+}
+
+class pool_allocator : public nd::base_memory_allocator {
+public:
+  char *allocate(intptr_t &size) {
+    int i = pool_class(size);
+    if (i == -1) {
+      return nd::malloc_memory_allocator().allocate(size);
+    }
+
+    size = static_cast<intptr_t>(1) << (min_pool_shift + i);
+    pool_chunks &pool = pool_cache::get();
+    if (pool.count[i] != 0) {
+      return pool.chunks[i][--pool.count[i]];
+    }
+
+    return nd::malloc_memory_allocator().allocate(size);
+  }
+
+  void deallocate(char *ptr, intptr_t size) {
+    int i = pool_class(size);
+    if (i != -1 && !pool_cache::is_released() && pool_cache::get().count[i] != max_pool_chunk_count) {
+      pool_chunks &pool = pool_cache::keep();
+      pool.chunks[i][pool.count[i]++] = ptr;
+      return;
+    }
+
+    free(ptr);
+  }
+};
+
+// Null until set, so that it is constant initialized and memory blocks created
+// during static initialization see the pool allocator
+atomic<nd::base_memory_allocator *> default_allocator(nullptr);
+
+} // anonymous namespace
+
+nd::base_memory_allocator::~base_memory_allocator() {}
+
+nd::base_memory_allocator &nd::malloc_memory_allocator() {
+  static malloc_allocator allocator;
+  return allocator;
+}
+
+nd::base_memory_allocator &nd::pool_memory_allocator() {
+  static pool_allocator allocator;
+  return allocator;
+}
+
+nd::base_memory_allocator &nd::default_memory_allocator() {
+  base_memory_allocator *allocator = default_allocator.load();
+  return allocator == nullptr ? pool_memory_allocator() : *allocator;
+}
+
+void nd::set_default_memory_allocator(base_memory_allocator &allocator) { default_allocator = &allocator; }
@@ -27,9 +27,9 @@ static std::vector<ndt::type> is_na_func_ptr(const ndt::type &DYND_UNUSED(dst_tp
 nd::callable make_assign_na() {
   auto children = nd::callable::make_all<
       nd::assign_na_callable,
-      type_sequence<bool, int8_t, int16_t, int32_t, int64_t, int128, uint32_t, float, double, dynd::complex<float>,
-                    dynd::complex<double>, void, dynd::bytes, dynd::string, ndt::fixed_dim_kind_type>>(
-      assign_na_func_ptr);
+      type_sequence<bool, int8_t, int16_t, int32_t, int64_t, int128, uint8_t, uint16_t, uint32_t, uint64_t, float,
+                    double, dynd::complex<float>, dynd::complex<double>, void, dynd::bytes, dynd::string,
+                    ndt::fixed_dim_kind_type>>(assign_na_func_ptr);
   children.insert(nd::get_elwise(ndt::type("() -> Fixed * Any")));
   children.insert(nd::get_elwise(ndt::type("() -> var * Any")));
 
@@ -39,8 +39,9 @@ nd::callable make_assign_na() {
 nd::callable make_is_na() {
   dispatcher<1, nd::callable> dispatcher = nd::callable::make_all<
       nd::is_na_callable,
-      type_sequence<bool, int8_t, int16_t, int32_t, int64_t, int128, uint32_t, float, double, dynd::complex<float>,
-                    dynd::complex<double>, void, dynd::bytes, dynd::string, ndt::fixed_dim_kind_type>>(is_na_func_ptr);
+      type_sequence<bool, int8_t, int16_t, int32_t, int64_t, int128, uint8_t, uint16_t, uint32_t, uint64_t, float,
+                    double, dynd::complex<float>, dynd::complex<double>, void, dynd::bytes, dynd::string,
+                    ndt::fixed_dim_kind_type>>(is_na_func_ptr);
   dispatcher.insert(nd::get_elwise(ndt::type("(Fixed * Any) -> Fixed * Any")));
   dispatcher.insert(nd::get_elwise(ndt::type("(var * Any) -> var * Any")));
 
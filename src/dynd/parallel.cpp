@@ -0,0 +1,179 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include <dynd/parallel.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+thread_local bool t_in_parallel_region = false;
+
+/**
+ * Marks the current thread as being inside a parallel region for its lifetime.
+ */
+struct parallel_region_guard {
+  bool m_saved;
+
+  parallel_region_guard() : m_saved(t_in_parallel_region) { t_in_parallel_region = true; }
+
+  ~parallel_region_guard() { t_in_parallel_region = m_saved; }
+};
+
+/**
+ * The state of a single parallel_run. It lives on the stack of the calling
+ * thread, which does not return until every worker has let go of it.
+ */
+struct parallel_job {
+  const std::function<void(size_t)> *task;
+  size_t ntasks;
+  std::atomic<size_t> next;
+  size_t nactive;
+  std::mutex error_mutex;
+  std::exception_ptr error;
+
+  parallel_job(const std::function<void(size_t)> &task, size_t ntasks)
+      : task(&task), ntasks(ntasks), next(0), nactive(0) {}
+
+  void work() {
+    for (size_t i = next++; i < ntasks; i = next++) {
+      try {
+        (*task)(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+        // Skip whatever has not been started yet
+        next = ntasks;
+      }
+    }
+  }
+};
+
+class thread_pool {
+  std::mutex m_run_mutex;
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_done;
+  std::vector<std::thread> m_threads;
+  parallel_job *m_job;
+  // Counts the jobs posted so far. Jobs live on the stack of run(), so a new
+  // one may well have the same address as the last, and workers tell them
+  // apart by this instead.
+  size_t m_generation;
+  bool m_stop;
+
+  void worker() {
+    t_in_parallel_region = true;
+
+    size_t generation = 0;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+      m_wake.wait(lock, [this, generation] { return m_stop || (m_job != nullptr && m_generation != generation); });
+      if (m_stop) {
+        return;
+      }
+
+      generation = m_generation;
+      parallel_job *job = m_job;
+      ++job->nactive;
+      lock.unlock();
+      job->work();
+      lock.lock();
+      if (--job->nactive == 0) {
+        m_done.notify_all();
+      }
+    }
+  }
+
+  void stop() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_wake.notify_all();
+    for (std::thread &t : m_threads) {
+      t.join();
+    }
+    m_threads.clear();
+    m_stop = false;
+  }
+
+public:
+  thread_pool() : m_job(nullptr), m_generation(0), m_stop(false) {}
+
+  ~thread_pool() { stop(); }
+
+  void run(size_t ntasks, const std::function<void(size_t)> &task, size_t nthreads) {
+    std::unique_lock<std::mutex> run_lock(m_run_mutex, std::try_to_lock);
+    if (!run_lock.owns_lock()) {
+      // Another thread is using the pool, so do the work here instead of waiting
+      parallel_region_guard guard;
+      for (size_t i = 0; i < ntasks; ++i) {
+        task(i);
+      }
+      return;
+    }
+
+    // The calling thread takes part, so it needs one fewer worker
+    if (m_threads.size() != nthreads - 1) {
+      stop();
+      for (size_t i = 1; i < nthreads; ++i) {
+        m_threads.emplace_back(&thread_pool::worker, this);
+      }
+    }
+
+    parallel_job job(task, ntasks);
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_job = &job;
+      ++m_generation;
+    }
+    m_wake.notify_all();
+
+    {
+      parallel_region_guard guard;
+      job.work();
+    }
+
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_job = nullptr;
+      m_done.wait(lock, [&job] { return job.nactive == 0; });
+    }
+
+    if (job.error) {
+      std::rethrow_exception(job.error);
+    }
+  }
+};
+
+thread_pool &get_thread_pool() {
+  static thread_pool pool;
+  return pool;
+}
+
+} // anonymous namespace
+
+bool dynd::detail::in_parallel_region() { return t_in_parallel_region; }
+
+void dynd::detail::parallel_run(size_t ntasks, const std::function<void(size_t)> &task, intptr_t nthreads) {
+  if (nthreads <= 1 || ntasks <= 1) {
+    for (size_t i = 0; i < ntasks; ++i) {
+      task(i);
+    }
+    return;
+  }
+
+  get_thread_pool().run(ntasks, task, static_cast<size_t>(nthreads));
+}
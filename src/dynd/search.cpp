@@ -4,9 +4,15 @@
 //
 
 #include <dynd/callables/binary_search_callable.hpp>
+#include <dynd/callables/eytzinger_callable.hpp>
+#include <dynd/callables/searchsorted_callable.hpp>
 #include <dynd/search.hpp>
 
 using namespace std;
 using namespace dynd;
 
 DYND_API nd::callable nd::binary_search = nd::make_callable<nd::binary_search_callable>();
+
+DYND_API nd::callable nd::searchsorted = nd::make_callable<nd::searchsorted_callable>();
+
+DYND_API nd::callable nd::eytzinger = nd::make_callable<nd::eytzinger_callable>();
@@ -3,6 +3,7 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <dynd/callables/argsort_callable.hpp>
 #include <dynd/callables/sort_callable.hpp>
 #include <dynd/callables/unique_callable.hpp>
 #include <dynd/sort.hpp>
@@ -10,6 +11,8 @@
 using namespace std;
 using namespace dynd;
 
+DYND_API nd::callable nd::argsort = nd::make_callable<nd::argsort_callable>();
+
 DYND_API nd::callable nd::sort = nd::make_callable<nd::sort_callable>();
 
 DYND_API nd::callable nd::unique = nd::make_callable<nd::unique_callable>();
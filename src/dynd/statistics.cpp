@@ -22,18 +22,22 @@ static std::vector<ndt::type> func_ptr(const ndt::type &DYND_UNUSED(dst_tp), siz
   return {src_tp[0]};
 }
 
+template <template <typename> class CallableType>
+nd::callable make_statistic_child() {
+  nd::callable f = nd::make_callable<nd::multidispatch_callable<1>>(
+      ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::scalar_kind_type>(),
+                                         {ndt::make_type<ndt::scalar_kind_type>()}),
+      nd::callable::make_all<CallableType, arithmetic_types>(func_ptr));
+  f->set_thread_safe(true);
+  return f;
+}
+
 } // unnnamed namespace
 
-DYND_API nd::callable nd::max = nd::functional::reduction(
-    nd::limits::min, nd::make_callable<nd::multidispatch_callable<1>>(
-                         ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::scalar_kind_type>(),
-                                                            {ndt::make_type<ndt::scalar_kind_type>()}),
-                         nd::callable::make_all<nd::max_callable, arithmetic_types>(func_ptr)));
+DYND_API nd::callable nd::max =
+    nd::functional::reduction(nd::limits::min, make_statistic_child<nd::max_callable>(), true);
 
 DYND_API nd::callable nd::mean = nd::make_callable<nd::mean_callable>(ndt::make_type<int64_t>());
 
-DYND_API nd::callable nd::min = nd::functional::reduction(
-    nd::limits::max, nd::make_callable<nd::multidispatch_callable<1>>(
-                         ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::scalar_kind_type>(),
-                                                            {ndt::make_type<ndt::scalar_kind_type>()}),
-                         nd::callable::make_all<nd::min_callable, arithmetic_types>(func_ptr)));
+DYND_API nd::callable nd::min =
+    nd::functional::reduction(nd::limits::max, make_statistic_child<nd::min_callable>(), true);
@@ -0,0 +1,59 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstdlib>
+
+#include <dynd/storagebuf.hpp>
+#include <dynd/thread_cache.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+/**
+ * The heap block a thread kept from the last storagebuf it destroyed.
+ */
+struct storagebuf_scratch {
+  void *data;
+  intptr_t capacity;
+};
+
+void release_storagebuf_scratch(storagebuf_scratch &scratch) {
+  std::free(scratch.data);
+  scratch.data = NULL;
+  scratch.capacity = 0;
+}
+
+typedef detail::thread_cache<storagebuf_scratch, &release_storagebuf_scratch> storagebuf_scratch_cache;
+
+} // anonymous namespace
+
+void *dynd::detail::take_storagebuf_scratch(intptr_t &capacity) {
+  storagebuf_scratch &scratch = storagebuf_scratch_cache::get();
+  if (scratch.data == NULL || scratch.capacity < capacity) {
+    return NULL;
+  }
+
+  void *data = scratch.data;
+  capacity = scratch.capacity;
+  scratch.data = NULL;
+  scratch.capacity = 0;
+
+  return data;
+}
+
+void dynd::detail::give_storagebuf_scratch(void *data, intptr_t capacity) {
+  // Keep the larger of the two blocks, as long as it is not too large to sit
+  // around unused
+  if (!storagebuf_scratch_cache::is_released() && capacity > storagebuf_scratch_cache::get().capacity &&
+      capacity <= max_storagebuf_scratch_capacity) {
+    storagebuf_scratch &scratch = storagebuf_scratch_cache::keep();
+    std::swap(data, scratch.data);
+    scratch.capacity = capacity;
+  }
+
+  std::free(data);
+}
@@ -4,35 +4,91 @@
 //
 
 #include <dynd/functional.hpp>
+#include <dynd/callables/multidispatch_callable.hpp>
 #include <dynd/callables/string_concat_callable.hpp>
 #include <dynd/callables/string_count_callable.hpp>
 #include <dynd/callables/string_find_callable.hpp>
 #include <dynd/callables/string_rfind_callable.hpp>
+#include <dynd/callables/string_pack_callable.hpp>
 #include <dynd/callables/string_replace_callable.hpp>
+#include <dynd/callables/string_slice_callable.hpp>
 #include <dynd/callables/string_split_callable.hpp>
+#include <dynd/callables/string_split_view_callable.hpp>
 #include <dynd/callables/string_startswith_callable.hpp>
 #include <dynd/callables/string_endswith_callable.hpp>
 #include <dynd/callables/string_contains_callable.hpp>
+#include <dynd/callables/string_contains_any_callable.hpp>
 #include <dynd/string.hpp>
 
 using namespace std;
 using namespace dynd;
 
-DYND_API nd::callable nd::string_concatenation =
-    nd::functional::elwise(nd::make_callable<nd::string_concat_callable>());
+namespace {
 
-DYND_API nd::callable nd::string_count = nd::functional::elwise(nd::make_callable<nd::string_count_callable>());
+typedef type_sequence<dynd::string, string_view> string_types;
 
-DYND_API nd::callable nd::string_find = nd::functional::elwise(nd::make_callable<nd::string_find_callable>());
+std::vector<ndt::type> func_ptr(const ndt::type &DYND_UNUSED(dst_tp), size_t nsrc, const ndt::type *src_tp) {
+  return std::vector<ndt::type>(src_tp, src_tp + nsrc);
+}
 
-DYND_API nd::callable nd::string_rfind = nd::functional::elwise(nd::make_callable<nd::string_rfind_callable>());
+/**
+ * Makes an elementwise string function of two arguments, each of which may be
+ * a string or a string_view.
+ */
+template <template <typename...> class CallableType>
+nd::callable make_string_callable() {
+  return nd::functional::elwise(
+      nd::make_callable<nd::multidispatch_callable<2>>(ndt::type("(Scalar, Scalar) -> Scalar"),
+                                                       nd::callable::make_all<CallableType, string_types, string_types>(
+                                                           func_ptr)));
+}
 
-DYND_API nd::callable nd::string_replace = nd::functional::elwise(nd::make_callable<nd::string_replace_callable>());
+/**
+ * Makes ``nd::string_replace``, each of whose three arguments may be a string
+ * or a string_view.
+ */
+nd::callable make_string_replace() {
+  return nd::functional::elwise(nd::make_callable<nd::multidispatch_callable<3>>(
+      ndt::type("(Scalar, Scalar, Scalar) -> Scalar"),
+      nd::callable::make_all<nd::string_replace_callable, string_types, string_types, string_types>(func_ptr)));
+}
 
-DYND_API nd::callable nd::string_split = nd::functional::elwise(nd::make_callable<nd::string_split_callable>());
+nd::callable make_string_pack() {
+  return nd::make_callable<nd::multidispatch_callable<1>>(
+      ndt::type("(Fixed * Scalar) -> Fixed * string_view"),
+      nd::callable::make_all<nd::string_pack_callable, string_types>(func_ptr));
+}
 
-DYND_API nd::callable nd::string_startswith = nd::functional::elwise(nd::make_callable<nd::string_startswith_callable>());
+nd::callable make_string_contains_any() {
+  return nd::make_callable<nd::multidispatch_callable<2>>(
+      ndt::type("(Fixed * Scalar, Fixed * Scalar) -> Fixed * bool"),
+      nd::callable::make_all<nd::string_contains_any_callable, string_types, string_types>(func_ptr));
+}
 
-DYND_API nd::callable nd::string_endswith = nd::functional::elwise(nd::make_callable<nd::string_endswith_callable>());
+} // unnamed namespace
 
-DYND_API nd::callable nd::string_contains = nd::functional::elwise(nd::make_callable<nd::string_contains_callable>());
+DYND_API nd::callable nd::string_concatenation = make_string_callable<nd::string_concat_callable>();
+
+DYND_API nd::callable nd::string_count = make_string_callable<nd::string_count_callable>();
+
+DYND_API nd::callable nd::string_find = make_string_callable<nd::string_find_callable>();
+
+DYND_API nd::callable nd::string_rfind = make_string_callable<nd::string_rfind_callable>();
+
+DYND_API nd::callable nd::string_replace = make_string_replace();
+
+DYND_API nd::callable nd::string_split = make_string_callable<nd::string_split_callable>();
+
+DYND_API nd::callable nd::string_split_view = nd::make_callable<nd::string_split_view_callable>();
+
+DYND_API nd::callable nd::string_slice = nd::make_callable<nd::string_slice_callable>();
+
+DYND_API nd::callable nd::string_pack = make_string_pack();
+
+DYND_API nd::callable nd::string_startswith = make_string_callable<nd::string_startswith_callable>();
+
+DYND_API nd::callable nd::string_endswith = make_string_callable<nd::string_endswith_callable>();
+
+DYND_API nd::callable nd::string_contains = make_string_callable<nd::string_contains_callable>();
+
+DYND_API nd::callable nd::string_contains_any = make_string_contains_any();
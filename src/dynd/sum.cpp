@@ -19,14 +19,18 @@ static std::vector<ndt::type> func_ptr(const ndt::type &DYND_UNUSED(dst_tp), siz
   return {src_tp[0].get_dtype()};
 }
 
+nd::callable make_sum_child() {
+  nd::callable f = nd::make_callable<nd::multidispatch_callable<1>>(
+      ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::scalar_kind_type>(),
+                                         {ndt::make_type<ndt::scalar_kind_type>()}),
+      nd::callable::make_all<nd::sum_callable,
+                             type_sequence<int8_t, int16_t, int32_t, int64_t, uint8_t, uint16_t, uint32_t, uint64_t,
+                                           float16, float, double, dynd::complex<float>, dynd::complex<double>>>(
+          func_ptr));
+  f->set_thread_safe(true);
+  return f;
+}
+
 } // unnamed namespace
 
-DYND_API nd::callable nd::sum = nd::functional::reduction(
-    [] { return 0; },
-    nd::make_callable<nd::multidispatch_callable<1>>(
-        ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::scalar_kind_type>(),
-                                           {ndt::make_type<ndt::scalar_kind_type>()}),
-        nd::callable::make_all<nd::sum_callable,
-                               type_sequence<int8_t, int16_t, int32_t, int64_t, uint8_t, uint16_t, uint32_t, uint64_t,
-                                             float16, float, double, dynd::complex<float>, dynd::complex<double>>>(
-            func_ptr)));
+DYND_API nd::callable nd::sum = nd::functional::reduction([] { return 0; }, make_sum_child(), true);
@@ -56,6 +56,7 @@ DYNDT_API vector<id_info> &detail::infos() {
                                {"fixed_string", fixed_string_kind_id},
                                {"char", string_kind_id},
                                {"string", string_kind_id},
+                               {"string_view", string_kind_id},
                                {"tuple", scalar_kind_id},
                                {"struct", scalar_kind_id},
                                {"Fixed", dim_kind_id},
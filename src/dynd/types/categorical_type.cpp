@@ -5,55 +5,171 @@
 
 #include <cstring>
 #include <map>
-#include <set>
+#include <vector>
 
 #include <dynd/array_range.hpp>
 #include <dynd/assignment.hpp>
 #include <dynd/callable.hpp>
-#include <dynd/search.hpp>
+#include <dynd/index.hpp>
+#include <dynd/kernels/unique_kernel.hpp>
+#include <dynd/sort.hpp>
 #include <dynd/types/categorical_type.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
 
 using namespace dynd;
 using namespace std;
 
+/**
+ * An open addressing hash table from the data of the categories to their
+ * values, which are their positions in ``values``.
+ */
+class ndt::detail::categorical_hash_index {
+public:
+  virtual ~categorical_hash_index() {}
+
+  /**
+   * The value of the category at ``data``, or -1 if there is none.
+   */
+  virtual intptr_t find(const char *data) const = 0;
+
+  /**
+   * Writes the values of ``count`` categories as unsigned integers of
+   * ``dst_size`` bytes, returning the position of the first one that is not
+   * a category or -1.
+   */
+  virtual intptr_t find_all(char *dst, intptr_t dst_stride, size_t dst_size, const char *src, intptr_t src_stride,
+                            size_t count) const = 0;
+};
+
 namespace {
 
-class sorter {
-  char *m_originptr;
+template <typename TraitsType>
+class typed_categorical_hash_index : public ndt::detail::categorical_hash_index {
+  nd::array m_values;
+  const char *m_data;
   intptr_t m_stride;
-  const kernel_single_t m_less;
-  nd::kernel_prefix *m_less_self;
-
-public:
-  sorter(const char *originptr, intptr_t stride, const kernel_single_t less, nd::kernel_prefix *less_self)
-      : m_originptr(const_cast<char *>(originptr)), m_stride(stride), m_less(less), m_less_self(less_self) {}
-
-  bool operator()(intptr_t i, intptr_t j) const {
-    int dst;
-    char *s[2] = {m_originptr + i * m_stride, m_originptr + j * m_stride};
-    m_less(m_less_self, reinterpret_cast<char *>(&dst), s);
+  TraitsType m_traits;
+  std::vector<intptr_t> m_slots;
+  std::vector<uint64_t> m_hashes;
+  size_t m_mask;
+
+  template <typename DstType>
+  intptr_t find_all(DstType *dst, intptr_t dst_stride, const char *src, intptr_t src_stride, size_t count) const {
+    for (size_t i = 0; i < count; ++i) {
+      intptr_t value = find(src + i * src_stride);
+      if (value < 0) {
+        return static_cast<intptr_t>(i);
+      }
+      *reinterpret_cast<DstType *>(reinterpret_cast<char *>(dst) + i * dst_stride) = static_cast<DstType>(value);
+    }
 
-    return dst != 0;
+    return -1;
   }
-};
-
-class cmp {
-  const kernel_single_t m_less;
-  nd::kernel_prefix *m_less_self;
 
 public:
-  cmp(const kernel_single_t less, nd::kernel_prefix *less_self) : m_less(less), m_less_self(less_self) {}
+  /**
+   * Hashes the one-dimensional array ``values`` in one pass, setting
+   * ``duplicate`` to the position of the first value that is equal to an
+   * earlier one, or -1 if they are unique.
+   */
+  typed_categorical_hash_index(const nd::array &values, const ndt::type &element_tp, intptr_t &duplicate)
+      : m_values(values), m_data(values.cdata()),
+        m_stride(reinterpret_cast<const fixed_dim_type_arrmeta *>(values.get()->metadata())->stride),
+        m_traits(element_tp) {
+    size_t size = values.get_dim_size();
+    size_t nslots = 16;
+    while (nslots < 2 * size) {
+      nslots *= 2;
+    }
+    m_slots.assign(nslots, -1);
+    m_hashes.resize(nslots);
+    m_mask = nslots - 1;
+
+    duplicate = -1;
+    for (size_t i = 0; i < size; ++i) {
+      const char *data = m_data + i * m_stride;
+      uint64_t h = m_traits.hash(data);
+      size_t slot = static_cast<size_t>(h) & m_mask;
+      for (; m_slots[slot] != -1; slot = (slot + 1) & m_mask) {
+        if (m_hashes[slot] == h && m_traits.equal(data, m_data + m_slots[slot] * m_stride)) {
+          duplicate = static_cast<intptr_t>(i);
+          return;
+        }
+      }
+      m_slots[slot] = static_cast<intptr_t>(i);
+      m_hashes[slot] = h;
+    }
+  }
 
-  bool operator()(const char *a, const char *b) const {
-    int dst;
-    char *s[2] = {const_cast<char *>(a), const_cast<char *>(b)};
+  intptr_t find(const char *data) const {
+    uint64_t h = m_traits.hash(data);
+    for (size_t slot = static_cast<size_t>(h) & m_mask; m_slots[slot] != -1; slot = (slot + 1) & m_mask) {
+      if (m_hashes[slot] == h && m_traits.equal(data, m_data + m_slots[slot] * m_stride)) {
+        return m_slots[slot];
+      }
+    }
 
-    m_less(m_less_self, reinterpret_cast<char *>(&dst), s);
-    return dst != 0;
+    return -1;
+  }
+
+  intptr_t find_all(char *dst, intptr_t dst_stride, size_t dst_size, const char *src, intptr_t src_stride,
+                    size_t count) const {
+    switch (dst_size) {
+    case 1:
+      return find_all(reinterpret_cast<uint8_t *>(dst), dst_stride, src, src_stride, count);
+    case 2:
+      return find_all(reinterpret_cast<uint16_t *>(dst), dst_stride, src, src_stride, count);
+    default:
+      return find_all(reinterpret_cast<uint32_t *>(dst), dst_stride, src, src_stride, count);
+    }
   }
 };
 
+/**
+ * Makes the hash index over the one-dimensional array ``values``, for the
+ * category types that can be hashed.
+ */
+std::shared_ptr<const ndt::detail::categorical_hash_index>
+make_categorical_hash_index(const nd::array &values, const ndt::type &element_tp, intptr_t &duplicate) {
+  switch (element_tp.get_id()) {
+  case bool_id:
+  case int8_id:
+  case uint8_id:
+    return std::make_shared<typed_categorical_hash_index<nd::detail::unique_traits<uint8_t>>>(values, element_tp,
+                                                                                              duplicate);
+  case int16_id:
+  case uint16_id:
+    return std::make_shared<typed_categorical_hash_index<nd::detail::unique_traits<uint16_t>>>(values, element_tp,
+                                                                                               duplicate);
+  case int32_id:
+  case uint32_id:
+    return std::make_shared<typed_categorical_hash_index<nd::detail::unique_traits<uint32_t>>>(values, element_tp,
+                                                                                               duplicate);
+  case int64_id:
+  case uint64_id:
+    return std::make_shared<typed_categorical_hash_index<nd::detail::unique_traits<uint64_t>>>(values, element_tp,
+                                                                                               duplicate);
+  case float32_id:
+    return std::make_shared<typed_categorical_hash_index<nd::detail::unique_traits<float>>>(values, element_tp,
+                                                                                            duplicate);
+  case float64_id:
+    return std::make_shared<typed_categorical_hash_index<nd::detail::unique_traits<double>>>(values, element_tp,
+                                                                                             duplicate);
+  case string_id:
+    return std::make_shared<typed_categorical_hash_index<nd::detail::unique_traits<dynd::string>>>(values, element_tp,
+                                                                                                   duplicate);
+  case fixed_bytes_id:
+  case fixed_string_id:
+    return std::make_shared<typed_categorical_hash_index<nd::detail::unique_bytes_traits>>(values, element_tp,
+                                                                                           duplicate);
+  default: {
+    stringstream ss;
+    ss << "categorical_type does not support the category type " << element_tp;
+    throw dynd::type_error(ss.str());
+  }
+  }
+}
+
 // struct assign_from_commensurate_category {
 //     static void general_kernel(char *dst, intptr_t dst_stride, const char
 //     *src, intptr_t src_stride,
@@ -104,31 +220,10 @@ public:
 
 } // anoymous namespace
 
-/** This function converts the set of char* pointers into a strided immutable
- * nd::array of the categories */
-static nd::array make_sorted_categories(const set<const char *, cmp> &uniques, const ndt::type &element_tp,
-                                        const char *DYND_UNUSED(arrmeta)) {
-  nd::array categories = nd::empty(uniques.size(), element_tp);
-  nd::kernel_builder k;
-  //  make_assignment_kernel(&k, element_tp, categories.get()->metadata() + sizeof(fixed_dim_type_arrmeta), element_tp,
-  //                       arrmeta, kernel_request_single, &eval::default_eval_context);
-  kernel_single_t fn = k.get()->get_function<kernel_single_t>();
-
-  intptr_t stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(categories.get()->metadata())->stride;
-  char *dst_ptr = categories.data();
-  for (set<const char *, cmp>::const_iterator it = uniques.begin(); it != uniques.end(); ++it) {
-    char *src = const_cast<char *>(*it);
-    fn(k.get(), dst_ptr, &src);
-    dst_ptr += stride;
-  }
-  categories.get_type().extended()->arrmeta_finalize_buffers(categories.get()->metadata());
-
-  return categories;
-}
-
 ndt::categorical_type::categorical_type(type_id_t id, const nd::array &categories, bool presorted)
     : base_type(id, 4, 4, type_flag_none, 0, 0, 0) {
   intptr_t category_count;
+  intptr_t duplicate;
   if (presorted) {
     // This is construction shortcut, for the case when the categories are
     // already
@@ -140,6 +235,7 @@ ndt::categorical_type::categorical_type(type_id_t id, const nd::array &categorie
     category_count = categories.get_dim_size();
     m_value_to_category_index = nd::old_range(category_count);
     m_category_index_to_value = m_value_to_category_index;
+    m_index = make_categorical_hash_index(m_categories, m_category_tp, duplicate);
   } else {
     // Process the categories array to make sure it's valid
     const type &cdt = categories.get_type();
@@ -154,48 +250,33 @@ ndt::categorical_type::categorical_type(type_id_t id, const nd::array &categorie
     }
 
     category_count = categories.get_dim_size();
-    intptr_t categories_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(categories.get()->metadata())->stride;
-
-    const char *categories_element_arrmeta = categories.get()->metadata() + sizeof(fixed_dim_type_arrmeta);
-    nd::kernel_builder k;
-    kernel_single_t fn = k.get()->get_function<kernel_single_t>();
 
-    cmp less(fn, k.get());
-    set<const char *, cmp> uniques(less);
+    // The values are the positions of the categories as given, so the hash
+    // index is over a copy of them in that order, and building it is the one
+    // pass that checks they are unique
+    nd::array values = nd::empty(categories.get_type());
+    values.assign(categories);
+    m_index = make_categorical_hash_index(values, m_category_tp, duplicate);
+    if (duplicate != -1) {
+      stringstream ss;
+      ss << "categories must be unique: category value ";
+      m_category_tp.print_data(ss, values.get()->metadata() + sizeof(fixed_dim_type_arrmeta),
+                               values.cdata() + duplicate * reinterpret_cast<const fixed_dim_type_arrmeta *>(
+                                                                values.get()->metadata())->stride);
+      ss << " appears more than once";
+      throw std::runtime_error(ss.str());
+    }
 
+    // Sort the categories once, and invert the permutation from the sorted
+    // category indices to the values
+    m_category_index_to_value = nd::argsort(values);
     m_value_to_category_index = nd::empty(category_count, make_type<intptr_t>());
-    m_category_index_to_value = nd::empty(category_count, make_type<intptr_t>());
-
-    // create the mapping from indices of (to be lexicographically sorted)
-    // categories to values
-    for (size_t i = 0; i != (size_t)category_count; ++i) {
-      unchecked_fixed_dim_get_rw<intptr_t>(m_category_index_to_value, i) = i;
-      const char *category_value = categories.cdata() + i * categories_stride;
-
-      if (uniques.find(category_value) == uniques.end()) {
-        uniques.insert(category_value);
-      } else {
-        stringstream ss;
-        ss << "categories must be unique: category value ";
-        m_category_tp.print_data(ss, categories_element_arrmeta, category_value);
-        ss << " appears more than once";
-        throw std::runtime_error(ss.str());
-      }
-    }
-    // TODO: Putting everything in a set already caused a sort operation to
-    // occur,
-    //       there's no reason we should need a second sort.
-    std::sort(&unchecked_fixed_dim_get_rw<intptr_t>(m_category_index_to_value, 0),
-              &unchecked_fixed_dim_get_rw<intptr_t>(m_category_index_to_value, category_count),
-              sorter(categories.cdata(), categories_stride, fn, k.get()));
-
-    // invert the m_category_index_to_value permutation
     for (intptr_t i = 0; i < category_count; ++i) {
       unchecked_fixed_dim_get_rw<intptr_t>(m_value_to_category_index,
                                            unchecked_fixed_dim_get<intptr_t>(m_category_index_to_value, i)) = i;
     }
 
-    m_categories = make_sorted_categories(uniques, m_category_tp, categories_element_arrmeta);
+    m_categories = nd::take(values, m_category_index_to_value).eval();
   }
 
   // Use the number of categories to set which underlying integer storage to use
@@ -260,22 +341,16 @@ void ndt::categorical_type::get_shape(intptr_t ndim, intptr_t i, intptr_t *out_s
 }
 
 uint32_t ndt::categorical_type::get_value_from_category(const char *category_arrmeta, const char *category_data) const {
-  type dst_tp = make_type<intptr_t>();
-  type src_tp[2] = {m_categories.get_type(), m_category_tp};
-  const char *src_arrmeta[2] = {m_categories.get()->metadata(), category_arrmeta};
-  char *src_data[2] = {const_cast<char *>(m_categories.cdata()), const_cast<char *>(category_data)};
-  intptr_t i =
-      nd::binary_search->call(dst_tp, 2, src_tp, src_arrmeta, src_data, 0, NULL, std::map<std::string, ndt::type>())
-          .as<intptr_t>();
-  if (i < 0) {
+  intptr_t value = m_index->find(category_data);
+  if (value < 0) {
     stringstream ss;
     ss << "Unrecognized category value ";
     m_category_tp.print_data(ss, category_arrmeta, category_data);
     ss << " assigning to dynd type " << type(this, true);
     throw std::runtime_error(ss.str());
-  } else {
-    return (uint32_t)unchecked_fixed_dim_get<intptr_t>(m_category_index_to_value, i);
   }
+
+  return static_cast<uint32_t>(value);
 }
 
 uint32_t ndt::categorical_type::get_value_from_category(const nd::array &category) const {
@@ -289,15 +364,15 @@ uint32_t ndt::categorical_type::get_value_from_category(const nd::array &categor
     c.assign(category);
   }
 
-  intptr_t i = nd::binary_search(m_categories, c).as<intptr_t>();
-  if (i < 0) {
-    stringstream ss;
-    ss << "Unrecognized category value ";
-    m_category_tp.print_data(ss, c.get()->metadata(), c.data());
-    ss << " assigning to dynd type " << type(this, true);
-    throw std::runtime_error(ss.str());
-  } else {
-    return (uint32_t)unchecked_fixed_dim_get<intptr_t>(m_category_index_to_value, i);
+  return get_value_from_category(c.get()->metadata(), c.cdata());
+}
+
+void ndt::categorical_type::get_values_from_categories(char *dst, intptr_t dst_stride, const char *src_arrmeta,
+                                                       const char *src, intptr_t src_stride, size_t count) const {
+  intptr_t i = m_index->find_all(dst, dst_stride, m_storage_type.get_data_size(), src, src_stride, count);
+  if (i >= 0) {
+    // Report the category that was not found
+    get_value_from_category(src_arrmeta, src + i * src_stride);
   }
 }
 
@@ -310,20 +385,7 @@ const char *ndt::categorical_type::get_category_arrmeta() const {
 nd::array ndt::categorical_type::get_categories() const {
   // TODO: store categories in their original order
   //       so this is simply "return m_categories".
-  nd::array categories = nd::empty(get_category_count(), m_category_tp);
-  intptr_t dim_size, stride;
-  type el_tp;
-  const char *el_arrmeta;
-  categories.get_type().get_as_strided(categories.get()->metadata(), &dim_size, &stride, &el_tp, &el_arrmeta);
-  nd::kernel_builder k;
-  //  ::make_assignment_kernel(&k, m_category_tp, el_arrmeta, el_tp, get_category_arrmeta(), kernel_request_single,
-  //                         &eval::default_eval_context);
-  kernel_single_t fn = k.get()->get_function<kernel_single_t>();
-  for (intptr_t i = 0; i < dim_size; ++i) {
-    char *src = const_cast<char *>(get_category_data_from_value((uint32_t)i));
-    fn(k.get(), categories.data() + i * stride, &src);
-  }
-  return categories;
+  return nd::take(m_categories, m_value_to_category_index).eval();
 }
 
 bool ndt::categorical_type::is_lossless_assignment(const type &dst_tp, const type &src_tp) const {
@@ -344,13 +406,18 @@ bool ndt::categorical_type::operator==(const base_type &rhs) const {
     return true;
   if (rhs.get_id() != categorical_id)
     return false;
-  if (!m_categories.equals_exact(static_cast<const categorical_type &>(rhs).m_categories))
-    return false;
-  if (!m_category_index_to_value.equals_exact(static_cast<const categorical_type &>(rhs).m_category_index_to_value))
-    return false;
-  if (!m_value_to_category_index.equals_exact(static_cast<const categorical_type &>(rhs).m_value_to_category_index))
+  const categorical_type &other = static_cast<const categorical_type &>(rhs);
+  if (m_category_tp != other.m_category_tp || get_category_count() != other.get_category_count())
     return false;
 
+  // The categories are the same if each of the other ones has the same value
+  // here, which is a lookup in the hash index rather than a comparison kernel
+  // that not every category type has
+  for (uint32_t value = 0; value < get_category_count(); ++value) {
+    if (m_index->find(other.get_category_data_from_value(value)) != static_cast<intptr_t>(value))
+      return false;
+  }
+
   return true;
 }
 
@@ -378,26 +445,9 @@ ndt::type ndt::factor_categorical(const nd::array &values) {
   // TODO: Some cases where we don't want to do this?
   nd::array values_eval = values.eval();
 
-  intptr_t dim_size, stride;
-  type el_tp;
-  const char *el_arrmeta;
-  values_eval.get_type().get_as_strided(values_eval.get()->metadata(), &dim_size, &stride, &el_tp, &el_arrmeta);
-
-  nd::kernel_builder k;
-  kernel_single_t fn = k.get()->get_function<kernel_single_t>();
-
-  cmp less(fn, k.get());
-  set<const char *, cmp> uniques(less);
-
-  for (intptr_t i = 0; i < dim_size; ++i) {
-    const char *data = values_eval.cdata() + i * stride;
-    if (uniques.find(data) == uniques.end()) {
-      uniques.insert(data);
-    }
-  }
-
-  // Copy the values (now sorted and unique) into a new nd::array
-  nd::array categories = make_sorted_categories(uniques, el_tp, el_arrmeta);
+  // Hash the distinct values out in one pass, then sort only those
+  nd::array categories = nd::unique(values_eval);
+  nd::sort(categories);
 
   return make_type<categorical_type>(categories, true);
 }
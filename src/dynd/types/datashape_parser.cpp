@@ -33,6 +33,7 @@
 #include <dynd/types/scalar_kind_type.hpp>
 #include <dynd/types/state_type.hpp>
 #include <dynd/types/string_type.hpp>
+#include <dynd/types/string_view_type.hpp>
 #include <dynd/types/struct_type.hpp>
 #include <dynd/types/tuple_type.hpp>
 #include <dynd/types/type_type.hpp>
@@ -1146,6 +1147,8 @@ static ndt::type parse_datashape_nooption(const char *&rbegin, const char *end,
       }
     } else if (compare_range_to_literal(nbegin, nend, "string")) {
       result = parse_string_parameters(begin, end);
+    } else if (compare_range_to_literal(nbegin, nend, "string_view")) {
+      result = ndt::make_type<ndt::string_view_type>();
     } else if (compare_range_to_literal(nbegin, nend, "fixed_string")) {
       result = parse_fixed_string_parameters(begin, end);
     } else if (compare_range_to_literal(nbegin, nend, "complex")) {
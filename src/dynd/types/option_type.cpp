@@ -26,6 +26,18 @@ void dynd::assign_na_builtin(type_id_t value_id, char *data) {
   case int64_id:
     *reinterpret_cast<int64_t *>(data) = DYND_INT64_NA;
     return;
+  case uint8_id:
+    *reinterpret_cast<uint8_t *>(data) = DYND_UINT8_NA;
+    return;
+  case uint16_id:
+    *reinterpret_cast<uint16_t *>(data) = DYND_UINT16_NA;
+    return;
+  case uint32_id:
+    *reinterpret_cast<uint32_t *>(data) = DYND_UINT32_NA;
+    return;
+  case uint64_id:
+    *reinterpret_cast<uint64_t *>(data) = DYND_UINT64_NA;
+    return;
   case int128_id:
     *reinterpret_cast<int128 *>(data) = DYND_INT128_NA;
     return;
@@ -59,10 +71,16 @@ bool dynd::is_avail_builtin(type_id_t value_id, const char *data) {
     return *reinterpret_cast<const int16_t *>(data) != DYND_INT16_NA;
   case int32_id:
     return *reinterpret_cast<const int32_t *>(data) != DYND_INT32_NA;
-  case uint32_id:
-    return *reinterpret_cast<const uint32_t *>(data) != DYND_UINT32_NA;
   case int64_id:
     return *reinterpret_cast<const int64_t *>(data) != DYND_INT64_NA;
+  case uint8_id:
+    return *reinterpret_cast<const uint8_t *>(data) != DYND_UINT8_NA;
+  case uint16_id:
+    return *reinterpret_cast<const uint16_t *>(data) != DYND_UINT16_NA;
+  case uint32_id:
+    return *reinterpret_cast<const uint32_t *>(data) != DYND_UINT32_NA;
+  case uint64_id:
+    return *reinterpret_cast<const uint64_t *>(data) != DYND_UINT64_NA;
   case int128_id:
     return *reinterpret_cast<const int128 *>(data) != DYND_INT128_NA;
   case float32_id:
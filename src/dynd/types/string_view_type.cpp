@@ -0,0 +1,143 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <dynd/exceptions.hpp>
+#include <dynd/memblock/pod_memory_block.hpp>
+#include <dynd/types/string_view_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+void ndt::string_view_type::get_string_range(const char **out_begin, const char **out_end,
+                                             const char *DYND_UNUSED(arrmeta), const char *data) const
+{
+  *out_begin = reinterpret_cast<const string_view *>(data)->begin();
+  *out_end = reinterpret_cast<const string_view *>(data)->end();
+}
+
+void ndt::string_view_type::set_from_utf8_string(const char *arrmeta, char *dst, const char *utf8_begin,
+                                                 const char *utf8_end, const eval::eval_context *ectx) const
+{
+  // Validate the input, which is already in the encoding of this type
+  next_unicode_codepoint_t next_fn = get_next_unicode_codepoint_function(string_encoding_utf_8, ectx->errmode);
+  for (const char *src = utf8_begin; src < utf8_end;) {
+    next_fn(src, utf8_end);
+  }
+
+  assign(arrmeta, dst, utf8_begin, utf8_end - utf8_begin);
+}
+
+void ndt::string_view_type::assign(const char *arrmeta, char *dst, const char *data, size_t size)
+{
+  char *begin = resize(arrmeta, dst, size);
+  if (size > 0) {
+    DYND_MEMCPY(begin, data, size);
+  }
+}
+
+char *ndt::string_view_type::resize(const char *arrmeta, char *dst, size_t size)
+{
+  const string_view_type_arrmeta *md = reinterpret_cast<const string_view_type_arrmeta *>(arrmeta);
+  if (!md->blockref) {
+    throw runtime_error("cannot assign to a dynd string_view without a memory block to hold its data");
+  }
+
+  char *begin = size > 0 ? md->blockref->alloc(size) : NULL;
+  *reinterpret_cast<string_view *>(dst) = string_view(begin, size);
+
+  return begin;
+}
+
+void ndt::string_view_type::print_data(std::ostream &o, const char *DYND_UNUSED(arrmeta), const char *data) const
+{
+  next_unicode_codepoint_t next_fn = get_next_unicode_codepoint_function(string_encoding_utf_8, assign_error_nocheck);
+  const char *begin = reinterpret_cast<const string_view *>(data)->begin();
+  const char *end = reinterpret_cast<const string_view *>(data)->end();
+
+  // Print as an escaped string
+  o << "\"";
+  while (begin < end) {
+    print_escaped_unicode_codepoint(o, next_fn(begin, end), false);
+  }
+  o << "\"";
+}
+
+void ndt::string_view_type::print_type(std::ostream &o) const { o << "string_view"; }
+
+bool ndt::string_view_type::is_unique_data_owner(const char *arrmeta) const
+{
+  const string_view_type_arrmeta *md = reinterpret_cast<const string_view_type_arrmeta *>(arrmeta);
+  return !md->blockref || md->blockref->get_use_count() == 1;
+}
+
+ndt::type ndt::string_view_type::get_canonical_type() const { return type(this, true); }
+
+void ndt::string_view_type::get_shape(intptr_t ndim, intptr_t i, intptr_t *out_shape,
+                                      const char *DYND_UNUSED(arrmeta), const char *DYND_UNUSED(data)) const
+{
+  out_shape[i] = -1;
+  if (i + 1 < ndim) {
+    stringstream ss;
+    ss << "requested too many dimensions from type " << type(this, true);
+    throw runtime_error(ss.str());
+  }
+}
+
+bool ndt::string_view_type::is_lossless_assignment(const type &DYND_UNUSED(dst_tp),
+                                                   const type &DYND_UNUSED(src_tp)) const
+{
+  return false;
+}
+
+bool ndt::string_view_type::operator==(const base_type &rhs) const
+{
+  return this == &rhs || rhs.get_id() == string_view_id;
+}
+
+void ndt::string_view_type::arrmeta_default_construct(char *arrmeta, bool blockref_alloc) const
+{
+  if (blockref_alloc) {
+    string_view_type_arrmeta *md = reinterpret_cast<string_view_type_arrmeta *>(arrmeta);
+    md->blockref = nd::make_memory_block<nd::pod_memory_block>(1, 1);
+  }
+}
+
+void ndt::string_view_type::arrmeta_copy_construct(char *dst_arrmeta, const char *src_arrmeta,
+                                                   const nd::memory_block &embedded_reference) const
+{
+  const string_view_type_arrmeta *src_md = reinterpret_cast<const string_view_type_arrmeta *>(src_arrmeta);
+  string_view_type_arrmeta *dst_md = reinterpret_cast<string_view_type_arrmeta *>(dst_arrmeta);
+  dst_md->blockref = src_md->blockref ? src_md->blockref : embedded_reference;
+}
+
+void ndt::string_view_type::arrmeta_reset_buffers(char *arrmeta) const
+{
+  string_view_type_arrmeta *md = reinterpret_cast<string_view_type_arrmeta *>(arrmeta);
+  if (md->blockref) {
+    md->blockref->reset();
+  }
+}
+
+void ndt::string_view_type::arrmeta_finalize_buffers(char *arrmeta) const
+{
+  string_view_type_arrmeta *md = reinterpret_cast<string_view_type_arrmeta *>(arrmeta);
+  if (md->blockref) {
+    md->blockref->finalize();
+  }
+}
+
+void ndt::string_view_type::arrmeta_destruct(char *arrmeta) const
+{
+  reinterpret_cast<string_view_type_arrmeta *>(arrmeta)->~string_view_type_arrmeta();
+}
+
+void ndt::string_view_type::arrmeta_debug_print(const char *arrmeta, std::ostream &o, const std::string &indent) const
+{
+  const string_view_type_arrmeta *md = reinterpret_cast<const string_view_type_arrmeta *>(arrmeta);
+  o << indent << "string_view arrmeta\n";
+  if (md->blockref) {
+    md->blockref->debug_print(o, indent + " ");
+  }
+}
@@ -68,6 +68,8 @@ ostream &dynd::operator<<(ostream &o, type_id_t id)
     return o << "fixed_bytes";
   case string_id:
     return o << "string";
+  case string_view_id:
+    return o << "string_view";
   case fixed_string_id:
     return o << "fixed_string";
   case categorical_id:
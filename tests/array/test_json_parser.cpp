@@ -14,6 +14,7 @@
 #include <dynd/view.hpp>
 #include <dynd/json_parser.hpp>
 #include <dynd/callable.hpp>
+#include <dynd/cpu_features.hpp>
 #include <dynd/types/var_dim_type.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
 #include <dynd/types/struct_type.hpp>
@@ -224,7 +225,266 @@ TEST(JSON, ParserWithMissingValue) {
   EXPECT_TRUE(a.p("y").is_na());
 }
 
-/*
+namespace {
+
+/**
+ * The structural characters and the starts of the scalars found one
+ * character at a time, for inputs whose backslashes are all inside strings.
+ */
+std::vector<uint32_t> reference_structural_index(const std::string &json) {
+  std::vector<uint32_t> res;
+  bool in_string = false;
+  for (size_t i = 0; i < json.size(); ++i) {
+    char c = json[i];
+    if (in_string) {
+      if (c == '\\') {
+        ++i;
+      } else if (c == '"') {
+        res.push_back(static_cast<uint32_t>(i));
+        in_string = false;
+      }
+    } else if (c == '"') {
+      res.push_back(static_cast<uint32_t>(i));
+      in_string = true;
+    } else if (strchr("{}[],:", c) != NULL && c != '\0') {
+      res.push_back(static_cast<uint32_t>(i));
+    } else if (strchr(" \t\n\r", c) == NULL && (i == 0 || strchr("{}[],:\" \t\n\r", json[i - 1]) != NULL)) {
+      res.push_back(static_cast<uint32_t>(i));
+    }
+  }
+
+  return res;
+}
+
+} // anonymous namespace
+
+TEST(JSONParser, StructuralIndex) {
+  // Strings with runs of backslashes of every length up to 70, placed so that
+  // they straddle the 64 byte blocks at different offsets
+  std::vector<std::string> inputs;
+  for (int pad = 0; pad < 66; pad += 5) {
+    std::string json = "[" + std::string(pad, ' ');
+    for (int run = 0; run < 70; ++run) {
+      json += "\"a" + std::string(2 * (run / 2), '\\') + ((run % 2) ? "\\\"" : "") + "{,}\", ";
+    }
+    inputs.push_back(json + "{\"x\": [1, 2]}]");
+  }
+  inputs.push_back("");
+  inputs.push_back("  ");
+  inputs.push_back("[\"\\\\\", \"]\", \"\\\\\\\"\"]");
+  inputs.push_back("[true,false , null,-1.5e3 ,\"x\"1 2]");
+
+  for (uint32_t features : {~0u, 0u}) {
+    restrict_cpu_features(features);
+    for (const std::string &json : inputs) {
+      std::vector<uint32_t> index;
+      EXPECT_TRUE(json::structural_index(json.data(), json.data() + json.size(), index));
+      EXPECT_EQ(reference_structural_index(json), index);
+    }
+
+    std::vector<uint32_t> index;
+    std::string unclosed = "[\"abc\", \"" + std::string(100, 'x') + "\\\"]";
+    EXPECT_FALSE(json::structural_index(unclosed.data(), unclosed.data() + unclosed.size(), index));
+  }
+  restrict_cpu_features(~0u);
+}
+
+TEST(JSONParser, LongStrings) {
+  std::string json = "[";
+  std::vector<std::string> expected;
+  for (int i = 0; i < 200; ++i) {
+    std::string value = std::string(i % 90, 'a' + i % 26) + "[\\\"" + std::to_string(i) + "\\\\]";
+    json += (i == 0 ? "\"" : ",\n  \"") + value + "\"";
+    expected.push_back(std::string(i % 90, 'a' + i % 26) + "[\"" + std::to_string(i) + "\\]");
+  }
+  json += "]";
+
+  nd::array a = parse_json(ndt::type("var * string"), json.c_str());
+  ASSERT_EQ(200, a.get_dim_size());
+  for (int i = 0; i < 200; ++i) {
+    EXPECT_EQ(expected[i], a(i).as<std::string>());
+  }
+}
+
+TEST(JSONParser, NestedVarDim) {
+  nd::array a = parse_json("var * var * int32", "[[1, 2, 3], [], [4], [5, 6]]");
+  EXPECT_EQ(4, a.get_dim_size());
+  EXPECT_EQ(3, a(0).get_dim_size());
+  EXPECT_EQ(0, a(1).get_dim_size());
+  EXPECT_EQ(4, a(2, 0).as<int>());
+  EXPECT_EQ(6, a(3, 1).as<int>());
+
+  // Fields that are not in the type are skipped over, whatever they hold
+  a = parse_json("var * {id: int32, tags: var * string}",
+                 "[{\"id\": 1, \"extra\": {\"a\": [1, {\"b\": \"]\"}], \"c\": null}, \"tags\": [\"x\", \"y\"]},\n"
+                 " {\"tags\": [], \"id\": 2, \"extra\": [true, false, -1.5e3]}]");
+  EXPECT_EQ(2, a.get_dim_size());
+  EXPECT_EQ(1, a(0, 0).as<int>());
+  EXPECT_EQ(2, a(0, 1).get_dim_size());
+  EXPECT_EQ("y", a(0, 1, 1).as<std::string>());
+  EXPECT_EQ(2, a(1, 0).as<int>());
+  EXPECT_EQ(0, a(1, 1).get_dim_size());
+}
+
+TEST(JSONParser, ErrorPosition) {
+  try {
+    parse_json("var * int32", "[1, 2,\n 3 4]");
+    FAIL() << "expected an error";
+  } catch (const invalid_argument &e) {
+    EXPECT_NE(std::string::npos, std::string(e.what()).find("line 2, column 3"));
+    EXPECT_NE(std::string::npos, std::string(e.what()).find("expected array separator ',' or terminator ']'"));
+  }
+
+  try {
+    parse_json("var * {x: int32}", "[{\"x\": 1}, {\"x\": [1, 2 }]");
+    FAIL() << "expected an error";
+  } catch (const invalid_argument &e) {
+    EXPECT_NE(std::string::npos, std::string(e.what()).find("line 1, column 18"));
+    EXPECT_NE(std::string::npos, std::string(e.what()).find("expected a number"));
+  }
+
+  try {
+    parse_json("3 * string", "[\"a\", \"b\", \"c]");
+    FAIL() << "expected an error";
+  } catch (const invalid_argument &e) {
+    EXPECT_NE(std::string::npos, std::string(e.what()).find("line 1, column 12"));
+    EXPECT_NE(std::string::npos, std::string(e.what()).find("string has no ending quote"));
+  }
+
+  EXPECT_THROW(parse_json("var * int32", "[1, 2] 3"), invalid_argument);
+  EXPECT_THROW(parse_json("var * int32", "[1, \\2]"), invalid_argument);
+}
+
+namespace {
+
+std::string make_ndjson(int count) {
+  std::string res;
+  for (int i = 0; i < count; ++i) {
+    res += "{\"id\": " + std::to_string(i) + ", \"name\": \"r" + std::to_string(i) + "\"}" + ((i % 7 == 0) ? "\r\n\n" : "\n");
+  }
+
+  return res;
+}
+
+/**
+ * A byte source which hands out a string a few bytes at a time.
+ */
+nd::json::ndjson_reader::source_type string_source(const std::string &str, size_t step) {
+  std::shared_ptr<size_t> pos = std::make_shared<size_t>(0);
+  return [str, step, pos](char *buffer, size_t size) {
+    size = std::min(std::min(size, step), str.size() - *pos);
+    memcpy(buffer, str.data() + *pos, size);
+    *pos += size;
+    return size;
+  };
+}
+
+void expect_ndjson_records(const nd::array &a, int first, int count) {
+  ASSERT_EQ(count, a.get_dim_size());
+  for (int i = 0; i < count; ++i) {
+    EXPECT_EQ(first + i, a(i, 0).as<int>());
+    EXPECT_EQ("r" + std::to_string(first + i), a(i, 1).as<std::string>());
+  }
+}
+
+} // anonymous namespace
+
+TEST(NDJSON, Parse) {
+  ndt::type tp("{id: int32, name: string}");
+  std::string json = make_ndjson(100);
+
+  nd::array a = nd::json::parse_ndjson(tp, json);
+  EXPECT_EQ(ndt::type("var * {id: int32, name: string}"), a.get_type());
+  expect_ndjson_records(a, 0, 100);
+
+  // The last line does not need a newline, and blank lines are skipped
+  a = nd::json::parse_ndjson(ndt::type("int32"), "\n1\n  \n2\n3");
+  ASSERT_EQ(3, a.get_dim_size());
+  EXPECT_EQ(3, a(2).as<int>());
+
+  EXPECT_EQ(0, nd::json::parse_ndjson(ndt::type("int32"), "").get_dim_size());
+}
+
+TEST(NDJSON, ReaderBatches) {
+  ndt::type tp("{id: int32, name: string}");
+  std::string json = make_ndjson(500);
+
+  // Lines are cut across reads and across chunks, and a chunk smaller than a
+  // line grows to fit it
+  for (size_t chunk_size : {8, 100, 4096}) {
+    nd::json::ndjson_reader reader(tp, string_source(json, 13), chunk_size);
+    nd::array batch;
+    int count = 0;
+    while (reader.next(batch)) {
+      EXPECT_EQ(ndt::make_fixed_dim(batch.get_dim_size(), tp), batch.get_type());
+      expect_ndjson_records(batch, count, static_cast<int>(batch.get_dim_size()));
+      count += static_cast<int>(batch.get_dim_size());
+    }
+    EXPECT_EQ(500, count);
+    EXPECT_FALSE(reader.next(batch));
+  }
+
+  nd::json::ndjson_reader reader(tp, string_source(json, 1000), 256);
+  expect_ndjson_records(reader.read_all(), 0, 500);
+}
+
+TEST(NDJSON, ReaderVarDim) {
+  std::string json;
+  for (int i = 0; i < 300; ++i) {
+    json += "[" + std::string(i % 5 ? "1" : "") + std::string(i % 5 > 1 ? ", 2" : "") + "]\n";
+  }
+
+  nd::json::ndjson_reader reader(ndt::type("var * int64"), string_source(json, 64), 128);
+  nd::array a = reader.read_all();
+  ASSERT_EQ(300, a.get_dim_size());
+  for (int i = 0; i < 300; ++i) {
+    EXPECT_EQ(std::min(i % 5, 2), a(i).get_dim_size());
+  }
+}
+
+TEST(NDJSON, Parallel) {
+  ndt::type tp("{id: int32, name: string}");
+  std::string json = make_ndjson(2000);
+
+  eval::eval_context ectx;
+  ectx.nthreads = 4;
+  ectx.parallel_chunk_size = 16;
+  expect_ndjson_records(nd::json::parse_ndjson(tp, json, &ectx), 0, 2000);
+
+  nd::json::ndjson_reader reader(tp, string_source(json, 4096), 8192, &ectx);
+  nd::array batch;
+  int count = 0;
+  while (reader.next(batch)) {
+    expect_ndjson_records(batch, count, static_cast<int>(batch.get_dim_size()));
+    count += static_cast<int>(batch.get_dim_size());
+  }
+  EXPECT_EQ(2000, count);
+
+  // Errors still give the line in the whole input
+  json.insert(json.find("{\"id\": 1500"), "{\"id\": x}\n");
+  try {
+    nd::json::parse_ndjson(tp, json, &ectx);
+    FAIL() << "expected an error";
+  } catch (const invalid_argument &e) {
+    EXPECT_NE(std::string::npos, std::string(e.what()).find("line 1716, column 8")) << e.what();
+  }
+}
+
+#ifndef _WIN32
+TEST(NDJSON, ReaderFileDescriptor) {
+  std::string json = make_ndjson(1000);
+  FILE *f = tmpfile();
+  ASSERT_NE(nullptr, f);
+  fwrite(json.data(), 1, json.size(), f);
+  fflush(f);
+  rewind(f);
+
+  nd::json::ndjson_reader reader(ndt::type("{id: int32, name: string}"), fileno(f), 1024);
+  expect_ndjson_records(reader.read_all(), 0, 1000);
+  fclose(f);
+}
+#endif
+
 TEST(JSON, DiscoverBool)
 {
   EXPECT_EQ(ndt::make_type<bool1>(), ndt::json::discover("true"));
@@ -247,7 +507,7 @@ TEST(JSON, DiscoverFloat64)
   EXPECT_EQ(ndt::make_type<float64>(), ndt::json::discover("3.14"));
 }
 
-TEST(JSON, DiscoverString) { EXPECT_EQ(ndt::type(string_id), ndt::json::discover("\"Hello, world!\"")); }
+TEST(JSON, DiscoverString) { EXPECT_EQ(ndt::make_type<dynd::string>(), ndt::json::discover("\"Hello, world!\"")); }
 
 TEST(JSON, DiscoverOption) { EXPECT_EQ(ndt::type("?Any"), ndt::json::discover("null")); }
 
@@ -298,5 +558,133 @@ TEST(JSON, DiscoverObject)
   EXPECT_EQ(ndt::type("{a: float64}"), ndt::json::discover("{\"a\": 3.14}"));
 
   EXPECT_EQ(ndt::type("{x: float64, y: 3 * int64}"), ndt::json::discover("{\"x\": 3.14, \"y\": [1, 2, 3]}"));
+
+  // Fields missing from some of the objects are optional
+  EXPECT_EQ(ndt::type("3 * {a: ?float64, b: ?string}"),
+            ndt::json::discover("[{\"a\": 1}, {\"a\": 2.5, \"b\": \"x\"}, {\"a\": null}]"));
+  EXPECT_EQ(ndt::type("2 * {a: var * int64}"), ndt::json::discover("[{\"a\": [1, 2]}, {\"a\": []}]"));
+}
+
+namespace {
+
+std::string make_json_records(int count) {
+  std::string res = "[";
+  for (int i = 0; i < count; ++i) {
+    res += std::string((i == 0) ? "" : ",\n") + "{\"id\": " + std::to_string(i) + ", \"name\": \"r" +
+           std::to_string(i) + "\"}";
+  }
+
+  return res + "]";
+}
+
+} // anonymous namespace
+
+TEST(JSON, DiscoverSampled) {
+  std::string json = make_json_records(100);
+  json.replace(json.find("\"id\": 49"), 8, "\"id\": 49.5");
+
+  ndt::json::discover_options opts;
+  ndt::type tp;
+  ndt::json::discover(tp, json);
+  EXPECT_EQ(ndt::type("100 * {id: float64, name: string}"), tp);
+
+  // The first ten records all have integer ids
+  opts.max_values = 10;
+  ndt::json::discover(tp, json.data(), json.data() + json.size(), opts);
+  EXPECT_EQ(ndt::type("100 * {id: int64, name: string}"), tp);
+
+  // Every seventh record includes the 49th
+  opts.max_values = 0;
+  opts.stride = 7;
+  ndt::json::discover(tp, json.data(), json.data() + json.size(), opts);
+  EXPECT_EQ(ndt::type("100 * {id: float64, name: string}"), tp);
+  opts.max_values = 7;
+  ndt::json::discover(tp, json.data(), json.data() + json.size(), opts);
+  EXPECT_EQ(ndt::type("100 * {id: int64, name: string}"), tp);
+
+  // Sampled elements without a common type fall back to a tuple of all of them
+  opts.stride = 1;
+  opts.max_values = 2;
+  ndt::json::discover(tp, "[1, \"x\", 3]", opts);
+  EXPECT_EQ(ndt::type("(int64, string, int64)"), tp);
+  ndt::json::discover(tp, "[]", opts);
+  EXPECT_EQ(ndt::type("()"), tp);
+
+  opts.stride = 0;
+  EXPECT_THROW(ndt::json::discover(tp, "[1]", opts), invalid_argument);
+}
+
+TEST(JSON, DiscoverParallel) {
+  eval::eval_context ectx;
+  ectx.nthreads = 4;
+  ectx.parallel_chunk_size = 16;
+
+  std::string json = make_json_records(2000);
+  json.replace(json.find("{\"id\": 1500"), 11, "{\"id\": null");
+  json.insert(json.find("{\"id\": 1700"), "{\"extra\": true},\n");
+
+  ndt::type tp;
+  ndt::json::discover(tp, json.data(), json.data() + json.size(), ndt::json::discover_options(), &ectx);
+  EXPECT_EQ(ndt::type("2001 * {id: ?int64, name: ?string, extra: ?bool}"), tp);
+  EXPECT_EQ(tp, ndt::json::discover(json));
+
+  // Errors still give the line in the whole input
+  json.insert(json.find("{\"id\": 1800"), "{\"id\": x},\n");
+  try {
+    ndt::json::discover(tp, json.data(), json.data() + json.size(), ndt::json::discover_options(), &ectx);
+    FAIL() << "expected an error";
+  } catch (const invalid_argument &e) {
+    EXPECT_NE(std::string::npos, std::string(e.what()).find("line 1802, column 8")) << e.what();
+  }
+}
+
+TEST(NDJSON, Discover) {
+  std::string json = make_ndjson(2000);
+  ndt::type tp = ndt::json::discover_ndjson(json);
+  EXPECT_EQ(ndt::type("{id: int64, name: string}"), tp);
+  expect_ndjson_records(nd::json::parse_ndjson(tp, json), 0, 2000);
+
+  ndt::json::discover_options opts;
+  opts.max_values = 100;
+  opts.stride = 3;
+  json += "{\"id\": 2000.5, \"name\": null}\n";
+  EXPECT_EQ(tp, ndt::json::discover_ndjson(json, opts));
+  EXPECT_EQ(ndt::type("{id: float64, name: ?string}"), ndt::json::discover_ndjson(json));
+
+  eval::eval_context ectx;
+  ectx.nthreads = 4;
+  ectx.parallel_chunk_size = 16;
+  EXPECT_EQ(ndt::type("{id: float64, name: ?string}"),
+            ndt::json::discover_ndjson(json, ndt::json::discover_options(), &ectx));
+
+  EXPECT_THROW(ndt::json::discover_ndjson("\n  \n"), invalid_argument);
+  EXPECT_THROW(ndt::json::discover_ndjson("1\n\"x\"\n"), invalid_argument);
+  try {
+    ndt::json::discover_ndjson("1\n\n2\n[3,\n");
+    FAIL() << "expected an error";
+  } catch (const invalid_argument &e) {
+    EXPECT_NE(std::string::npos, std::string(e.what()).find("line 4, column 4")) << e.what();
+  }
+}
+
+TEST(NDJSON, DiscoverCache) {
+  ndt::json::clear_discover_cache();
+  ndt::json::discover_options opts;
+  opts.cache_key = "feed";
+
+  EXPECT_EQ(ndt::type("{id: int64, name: string}"), ndt::json::discover_ndjson(make_ndjson(10), opts));
+  // The cached type is returned without looking at the input
+  EXPECT_EQ(ndt::type("{id: int64, name: string}"), ndt::json::discover_ndjson("{\"x\": 1}", opts));
+  EXPECT_EQ(ndt::type("{x: int64}"), ndt::json::discover_ndjson("{\"x\": 1}"));
+
+  // Documents are cached apart from newline-delimited JSON
+  ndt::type tp;
+  ndt::json::discover(tp, "[1, 2]", opts);
+  EXPECT_EQ(ndt::type("2 * int64"), tp);
+  ndt::json::discover(tp, "[1.5]", opts);
+  EXPECT_EQ(ndt::type("2 * int64"), tp);
+
+  ndt::json::clear_discover_cache();
+  EXPECT_EQ(ndt::type("{x: int64}"), ndt::json::discover_ndjson("{\"x\": 1}", opts));
+  ndt::json::clear_discover_cache();
 }
-*/
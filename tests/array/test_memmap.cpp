@@ -8,6 +8,12 @@
 #include <stdexcept>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <vector>
+
+#ifndef WIN32
+#include <unistd.h>
+#endif
 
 #include "inc_gtest.hpp"
 
@@ -19,46 +25,139 @@
 using namespace std;
 using namespace dynd;
 
-/*
+namespace {
 
-static void write_string_file(const char *fn,
-    const char *data, intptr_t size)
-{
-    ofstream fout(fn, ios::binary);
-    fout.write(data, size);
+void write_string_file(const char *fn, const char *data, intptr_t size) {
+  ofstream fout(fn, ios::binary);
+  fout.write(data, size);
 }
 
-//  This test fails since the string refactor. We need to redo nd::memmap.
-TEST(ArrayMemMap, SimpleString) {
-    // Create a file with a simple string
-    const char *str = "This is a test of a string.";
-    write_string_file("test.txt", str, strlen(str));
-    // Open the whole file as a memory map
-    nd::array a = nd::memmap("test.txt");
-    // Should have type 'bytes'
-    EXPECT_EQ(ndt::bytes_type::make(1), a.get_type());
-    // If we view it as a string, should still point to the same data
-    nd::array b = a.view_scalars(ndt::string_type::make());
-    EXPECT_EQ(ndt::string_type::make(), b.get_type());
-    EXPECT_EQ(std::string(str), b.as<std::string>());
-
-    // Remap a subset of the file
-    a = nd::array();
-    b = nd::array();
-    a = nd::memmap("test.txt", 5, 7);
-    EXPECT_EQ(ndt::bytes_type::make(1), a.get_type());
-    EXPECT_EQ("is", a.view_scalars(ndt::string_type::make()).as<std::string>());
-
-    // Remap the file using a negative index
-    a = nd::array();
-    a = nd::memmap("test.txt", -7);
-    EXPECT_EQ(ndt::bytes_type::make(1), a.get_type());
-    EXPECT_EQ("string.", a.view_scalars(ndt::string_type::make()).as<std::string>());
-
+void remove_file(const char *fn) {
 #ifdef WIN32
-    _unlink("test.txt");
+  _unlink(fn);
 #else
-    unlink("test.txt");
+  unlink(fn);
 #endif
 }
-*/
+
+struct point {
+  double x;
+  int32_t y;
+};
+
+void write_points_file(const char *fn, int count) {
+  vector<point> points(count);
+  for (int i = 0; i < count; ++i) {
+    points[i].x = i * 0.5;
+    points[i].y = -i;
+  }
+  write_string_file(fn, reinterpret_cast<const char *>(points.data()), count * sizeof(point));
+}
+
+} // anonymous namespace
+
+TEST(ArrayMemMap, SimpleString) {
+  // Create a file with a simple string
+  const char *str = "This is a test of a string.";
+  write_string_file("test.txt", str, strlen(str));
+  // Open the whole file as a memory map of its bytes
+  nd::array a = nd::memmap("test.txt");
+  EXPECT_EQ(ndt::make_fixed_dim(strlen(str), ndt::make_type<uint8_t>()), a.get_type());
+  EXPECT_EQ(0u, a.get_flags() & nd::write_access_flag);
+  EXPECT_EQ(0, memcmp(str, a.cdata(), strlen(str)));
+
+  // Remap a subset of the file
+  a = nd::memmap("test.txt", 5, 7);
+  EXPECT_EQ(ndt::type("2 * uint8"), a.get_type());
+  EXPECT_EQ("is", std::string(a.cdata(), 2));
+
+  // Remap the file using a negative index
+  a = nd::memmap("test.txt", -7);
+  EXPECT_EQ(ndt::type("7 * uint8"), a.get_type());
+  EXPECT_EQ("string.", std::string(a.cdata(), 7));
+
+  a = nd::array();
+  remove_file("test.txt");
+}
+
+TEST(ArrayMemMap, Typed) {
+  write_points_file("test_points.bin", 1000);
+
+  nd::array a = nd::memmap("test_points.bin", ndt::type("1000 * {x: float64, y: int32}"));
+  EXPECT_EQ(ndt::type("1000 * {x: float64, y: int32}"), a.get_type());
+  EXPECT_EQ(0u, a.get_flags() & nd::write_access_flag);
+  EXPECT_EQ(5.0, a(10, 0).as<double>());
+  EXPECT_EQ(-999, a(999, 1).as<int>());
+  EXPECT_EQ(ndt::type("1000 * float64"), a(irange(), 0).get_type());
+  EXPECT_EQ(499.5, a(irange(), 0)(999).as<double>());
+  EXPECT_THROW(a.data(), runtime_error);
+
+  // A leading Fixed dimension takes its size from the file
+  a = nd::memmap("test_points.bin", ndt::type("Fixed * {x: float64, y: int32}"), 16 * 100);
+  EXPECT_EQ(ndt::type("900 * {x: float64, y: int32}"), a.get_type());
+  EXPECT_EQ(50.0, a(0, 0).as<double>());
+  EXPECT_EQ(-100, a(0, 1).as<int>());
+
+  // Hints can be given for the mapping and any view of it
+  a = nd::memmap("test_points.bin", ndt::type("1000 * {x: float64, y: int32}"), 0, nd::read_access_flag,
+                 nd::memmap_populate | nd::memmap_huge_pages);
+  nd::memmap_advise(a, nd::memmap_advice_sequential);
+  nd::memmap_advise(a(irange(), 1), nd::memmap_advice_random);
+  nd::memmap_advise(a, nd::memmap_advice_willneed);
+  EXPECT_EQ(-7, a(7, 1).as<int>());
+  EXPECT_THROW(nd::memmap_advise(nd::array{1, 2}, nd::memmap_advice_normal), invalid_argument);
+
+  a = nd::array();
+  remove_file("test_points.bin");
+}
+
+TEST(ArrayMemMap, ReadWrite) {
+  remove_file("test_rw.bin");
+  EXPECT_THROW(nd::memmap("test_rw.bin", ndt::type("100 * int32"), 0, nd::readwrite_access_flags), runtime_error);
+
+  // The file is created to fit the array, and writes go through to it
+  nd::array a =
+      nd::memmap("test_rw.bin", ndt::type("100 * int32"), 0, nd::readwrite_access_flags, nd::memmap_create);
+  int32_t *data = reinterpret_cast<int32_t *>(a.data());
+  for (int32_t i = 0; i < 100; ++i) {
+    data[i] = i * i;
+  }
+  a(5).assign(-1);
+  nd::memmap_flush(a);
+
+  nd::array b = nd::memmap("test_rw.bin", ndt::type("Fixed * int32"));
+  EXPECT_EQ(ndt::type("100 * int32"), b.get_type());
+  EXPECT_EQ(-1, b(5).as<int>());
+  EXPECT_EQ(99 * 99, b(99).as<int>());
+
+  // Writes through one mapping are seen by another mapping of the file
+  data[99] = 7;
+  nd::memmap_flush(a, false);
+  EXPECT_EQ(7, b(99).as<int>());
+
+  a = nd::array();
+  b = nd::array();
+  ifstream fin("test_rw.bin", ios::binary);
+  int32_t values[100];
+  fin.read(reinterpret_cast<char *>(values), sizeof(values));
+  EXPECT_EQ(400, fin.gcount());
+  EXPECT_EQ(-1, values[5]);
+  EXPECT_EQ(7, values[99]);
+  fin.close();
+
+  remove_file("test_rw.bin");
+}
+
+TEST(ArrayMemMap, Errors) {
+  write_points_file("test_errors.bin", 10);
+
+  EXPECT_THROW(nd::memmap("test_errors.bin", ndt::type("10 * string")), type_error);
+  EXPECT_THROW(nd::memmap("test_errors.bin", ndt::type("var * int32")), type_error);
+  EXPECT_THROW(nd::memmap("test_errors.bin", ndt::type("Fixed * Any")), type_error);
+  EXPECT_THROW(nd::memmap("test_errors.bin", ndt::type("11 * {x: float64, y: int32}")), invalid_argument);
+  EXPECT_THROW(nd::memmap("test_errors.bin", ndt::type("Fixed * {x: float64, y: int32}"), 8), invalid_argument);
+  EXPECT_THROW(nd::memmap("test_errors.bin", ndt::type("int32"), 2), invalid_argument);
+  EXPECT_THROW(nd::memmap("test_missing.bin", ndt::type("int32")), runtime_error);
+
+  remove_file("test_errors.bin");
+}
@@ -259,6 +259,27 @@ TEST(Arithmetic, Minus) {
   EXPECT_ARRAY_EQ(nd::array({-0.0, -1.0, -2.0, -3.0, -4.0}), -a);
 }
 
+TEST(Arithmetic, Contiguous) {
+  // Long enough to go through both the vectorized body and the remainder
+  nd::array a = nd::empty(37, ndt::make_type<float>());
+  nd::array b = nd::empty(37, ndt::make_type<float>());
+  for (int i = 0; i < 37; ++i) {
+    a(i).assign(0.5f * i);
+    b(i).assign(3.0f - i);
+  }
+
+  nd::array c = a + b;
+  nd::array d = a * b;
+  nd::array e = a(irange().by(2)) - b(irange().by(2));
+  for (int i = 0; i < 37; ++i) {
+    EXPECT_EQ(0.5f * i + (3.0f - i), c(i).as<float>());
+    EXPECT_EQ(0.5f * i * (3.0f - i), d(i).as<float>());
+  }
+  for (int i = 0; i < 19; ++i) {
+    EXPECT_EQ(0.5f * (2 * i) - (3.0f - 2 * i), e(i).as<float>());
+  }
+}
+
 /*
 TEST(Arithmetic, CompoundDiv)
 {
@@ -58,6 +58,55 @@ TEST(Callable, FromKernel) {
   EXPECT_ARRAY_EQ(9, f(2));
 }
 
+TEST(Callable, ResolveCache) {
+  struct kernel : nd::base_strided_kernel<kernel, 1> {
+    void single(char *res, char *const *args) { *reinterpret_cast<int *>(res) = *reinterpret_cast<int *>(args[0]) + 7; }
+  };
+
+  struct counting_callable : nd::default_instantiable_callable<kernel> {
+    int &count;
+
+    counting_callable(int &count)
+        : nd::default_instantiable_callable<kernel>(ndt::make_type<int(int)>()), count(count) {}
+
+    ndt::type resolve(nd::base_callable *caller, char *data, nd::call_graph &cg, const ndt::type &dst_tp, size_t nsrc,
+                      const ndt::type *src_tp, size_t nkwd, const nd::array *kwds,
+                      const std::map<std::string, ndt::type> &tp_vars) {
+      ++count;
+      return nd::default_instantiable_callable<kernel>::resolve(caller, data, cg, dst_tp, nsrc, src_tp, nkwd, kwds,
+                                                                tp_vars);
+    }
+  };
+
+  int count = 0;
+  nd::callable f = nd::make_callable<counting_callable>(count);
+  EXPECT_ARRAY_EQ(9, f(2));
+  EXPECT_ARRAY_EQ(10, f(3));
+  EXPECT_ARRAY_EQ(11, f(4));
+  EXPECT_EQ(1, count);
+
+  nd::detail::resolve_cache::invalidate_all();
+  EXPECT_ARRAY_EQ(12, f(5));
+  EXPECT_EQ(2, count);
+}
+
+TEST(Callable, Prepare) {
+  nd::array a = {1, 2, 3};
+  nd::array b = {4, 5, 6};
+
+  nd::prepared_callable f = nd::add.prepare(a, b);
+  EXPECT_ARRAY_EQ((nd::array{5, 7, 9}), f());
+
+  a(1).assign(10);
+  b(2).assign(-6);
+  EXPECT_ARRAY_EQ((nd::array{5, 15, -3}), f());
+
+  nd::array dst = nd::empty(f.get_dst().get_type());
+  nd::array args[2] = {nd::array{1, 1, 1}, nd::array{2, 2, 2}};
+  f(dst, args);
+  EXPECT_ARRAY_EQ((nd::array{3, 3, 3}), dst);
+}
+
 TEST(Callable, CallOperator) {
   nd::callable f([](int x, double y) { return 2.0 * x + y; });
   // Calling with positional arguments
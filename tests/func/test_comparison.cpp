@@ -77,6 +77,22 @@ TEST(Equals, Tuple) {
 }
 */
 
+TEST(Comparison, Contiguous) {
+  nd::array a = nd::empty(37, ndt::make_type<float>());
+  nd::array b = nd::empty(37, ndt::make_type<float>());
+  for (int i = 0; i < 37; ++i) {
+    a(i).assign(static_cast<float>(i));
+    b(i).assign(static_cast<float>(36 - i));
+  }
+
+  nd::array lt = a < b;
+  nd::array eq = a == b;
+  for (int i = 0; i < 37; ++i) {
+    EXPECT_EQ(i < 36 - i, lt(i).as<bool>());
+    EXPECT_EQ(i == 36 - i, eq(i).as<bool>());
+  }
+}
+
 TEST(AllEqual, Int) {
   EXPECT_ARRAY_EQ(true, nd::all_equal(4, 4));
   EXPECT_ARRAY_EQ(true, nd::all_equal(1, 1));
@@ -43,3 +43,78 @@ TEST(Convert, Unary)
   nd::callable g = nd::functional::convert(ndt::type("(float32) -> float64"), f);
 }
 */
+
+TEST(Compose, Chunked) {
+  // Enough elements to stream several chunks through the intermediate buffer
+  nd::callable composed = nd::functional::elwise(
+      nd::functional::compose(nd::functional::apply([](int x) { return x + 0.5; }),
+                              nd::functional::apply([](double x) { return static_cast<float>(2 * x); }),
+                              ndt::make_type<double>()));
+
+  std::vector<int> values(300);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<int>(i);
+  }
+
+  nd::array res = composed(nd::array(values.data(), values.size()));
+  ASSERT_EQ(ndt::type("300 * float32"), res.get_type());
+  for (size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(2 * i + 1.0f, res(i).as<float>());
+  }
+}
+
+TEST(Compose, LargeBuffer) {
+  // The intermediate elements do not fit on the stack, so the buffer
+  // allocated with the kernel is reused instead
+  ndt::type str_tp = ndt::make_type<ndt::fixed_string_type>(8, string_encoding_utf_8);
+  ndt::type buf_tp = ndt::make_type<ndt::fixed_string_type>(4096, string_encoding_utf_8);
+  nd::callable composed = nd::functional::compose(make_callable_from_assignment(buf_tp, str_tp, assign_error_default),
+                                                  make_callable_from_assignment(str_tp, buf_tp, assign_error_default),
+                                                  buf_tp);
+  EXPECT_FALSE(composed->is_thread_safe());
+
+  nd::array b = nd::empty(300, str_tp);
+  for (int i = 0; i < 300; ++i) {
+    b(i).assign(std::to_string(i));
+  }
+
+  nd::array a = nd::empty(str_tp);
+  composed({b(123)}, {{"dst", a}});
+  EXPECT_EQ("123", a.as<std::string>());
+
+  // Enough elements to stream several chunks through it
+  nd::array res = nd::empty(300, str_tp);
+  nd::functional::elwise(composed)({b}, {{"dst", res}});
+  for (int i = 0; i < 300; ++i) {
+    EXPECT_EQ(std::to_string(i), res(i).as<std::string>());
+  }
+}
+
+TEST(Compose, Parallel) {
+  eval::eval_context saved = eval::default_eval_context;
+  eval::default_eval_context.nthreads = 4;
+
+  nd::callable first = nd::functional::apply([](int x) { return x + 0.5; });
+  first->set_thread_safe(true);
+  nd::callable second = nd::functional::apply([](double x) { return static_cast<float>(2 * x); });
+  second->set_thread_safe(true);
+
+  // Every worker streams its chunks through the intermediate buffer at once
+  nd::callable composed = nd::functional::compose(first, second, ndt::make_type<double>());
+  ASSERT_TRUE(composed->is_thread_safe());
+  composed = nd::functional::elwise(composed);
+
+  std::vector<int> values(1000000);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<int>(i % 1000);
+  }
+
+  nd::array res = composed(nd::array(values.data(), values.size()));
+  ASSERT_EQ(ndt::type("1000000 * float32"), res.get_type());
+  const float *res_data = reinterpret_cast<const float *>(res.cdata());
+  for (size_t i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(2 * values[i] + 1.0f, res_data[i]) << "at index " << i;
+  }
+
+  eval::default_eval_context = saved;
+}
@@ -6,7 +6,9 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <set>
 #include <stdexcept>
+#include <thread>
 
 #include "inc_gtest.hpp"
 
@@ -220,6 +222,63 @@ TEST(Elwise, Binary_FixedDim) {
   EXPECT_ARRAY_EQ((nd::array{3, 5, 7}), f({{0, 1, 2}, {3, 4, 5}}, {}));
 }
 
+TEST(Elwise, Parallel) {
+  eval::eval_context saved = eval::default_eval_context;
+  eval::default_eval_context.nthreads = 4;
+  eval::default_eval_context.parallel_chunk_size = 16;
+
+  nd::callable child = nd::functional::apply([](int x, int y) { return x * y + 1; });
+  child->set_thread_safe(true);
+  nd::callable f = nd::functional::elwise(child);
+
+  nd::array a = nd::empty(1000, ndt::make_type<int>());
+  nd::array b = nd::empty(1000, ndt::make_type<int>());
+  for (int i = 0; i < 1000; ++i) {
+    a(i).assign(i);
+    b(i).assign(3 - i);
+  }
+
+  nd::array res = f(a, b);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(i * (3 - i) + 1, res(i).as<int>());
+  }
+
+  // Strided, and broadcast against a scalar
+  res = f(a(irange().by(3)), 2);
+  for (int i = 0; i < 334; ++i) {
+    EXPECT_EQ(6 * i + 1, res(i).as<int>());
+  }
+
+  eval::default_eval_context = saved;
+}
+
+TEST(Elwise, ParallelNotThreadSafe) {
+  eval::eval_context saved = eval::default_eval_context;
+  eval::default_eval_context.nthreads = 4;
+  eval::default_eval_context.parallel_chunk_size = 16;
+
+  // A child that has not declared itself thread-safe only runs on the calling thread
+  std::set<std::thread::id> ids;
+  nd::callable f = nd::functional::elwise(nd::functional::apply([&ids](int x) {
+    ids.insert(std::this_thread::get_id());
+    return x + 1;
+  }));
+
+  nd::array a = nd::empty(1000, ndt::make_type<int>());
+  for (int i = 0; i < 1000; ++i) {
+    a(i).assign(i);
+  }
+
+  nd::array res = f(a);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(i + 1, res(i).as<int>());
+  }
+  EXPECT_EQ(1u, ids.size());
+  EXPECT_EQ(1u, ids.count(std::this_thread::get_id()));
+
+  eval::default_eval_context = saved;
+}
+
 /*
 // TODO Reenable once there's a convenient way to make the binary callable
 TEST(LiftCallable, Expr_MultiDimVarToVarDim) {
@@ -36,6 +36,14 @@ TEST(Min, FixedDimVarDim) {
   EXPECT_ARRAY_EQ(-4.0, nd::min(parse_json(ndt::type("3 * var * float64"), "[[23.5], [10, 2, 15], [-4]]")));
 }
 
+TEST(Min, Contiguous) {
+  nd::array a = nd::empty(37, ndt::make_type<float>());
+  for (int i = 0; i < 37; ++i) {
+    a(i).assign(100.0f - i);
+  }
+  EXPECT_ARRAY_EQ(64.0f, nd::min(a));
+}
+
 TEST(Max, FixedDim) {
   EXPECT_ARRAY_EQ(9, nd::max(nd::array{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
   EXPECT_ARRAY_EQ(0, nd::max(nd::array{0, -1, -2, -3, -4, -5, -6, -7, -8, -9}));
@@ -54,3 +62,11 @@ TEST(Max, FixedDimVarDim) {
   EXPECT_ARRAY_EQ(10, nd::max(parse_json(ndt::type("2 * var * int32"), "[[0], [10, 2]]")));
   EXPECT_ARRAY_EQ(23.5, nd::max(parse_json(ndt::type("3 * var * float64"), "[[23.5], [10, 2, 15], [-4]]")));
 }
+
+TEST(Max, Contiguous) {
+  nd::array a = nd::empty(37, ndt::make_type<float>());
+  for (int i = 0; i < 37; ++i) {
+    a(i).assign(i - 100.0f);
+  }
+  EXPECT_ARRAY_EQ(-64.0f, nd::max(a));
+}
@@ -6,11 +6,14 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <set>
 #include <stdexcept>
+#include <thread>
 
 #include "inc_gtest.hpp"
 
 #include <dynd/functional.hpp>
+#include <dynd/statistics.hpp>
 
 #include "dynd_assertions.hpp"
 
@@ -185,6 +188,88 @@ TEST(Reduction, BuiltinSum_Lift3D_StridedStridedStrided_ReduceBroadcastReduce) {
                                              {{"axes", {0, 2}}}));
 }
 
+TEST(Reduction, Parallel) {
+  eval::eval_context saved = eval::default_eval_context;
+  eval::default_eval_context.nthreads = 4;
+  eval::default_eval_context.parallel_chunk_size = 16;
+
+  nd::callable child = nd::functional::apply([](const return_wrapper<int> &res, int x) { res += x; });
+  child->set_thread_safe(true);
+  nd::callable f = nd::functional::reduction([] { return 0; }, child, true);
+
+  nd::array a = nd::empty(40, 50, ndt::make_type<int>());
+  for (int i = 0; i < 40; ++i) {
+    for (int j = 0; j < 50; ++j) {
+      a(i, j).assign(50 * i + j - 700);
+    }
+  }
+
+  EXPECT_ARRAY_EQ(1999 * 1000 - 2000 * 700, f(a));
+  EXPECT_ARRAY_EQ(nd::array({{1999 * 1000 - 2000 * 700}}), f({a}, {{"keepdims", true}}));
+  EXPECT_ARRAY_EQ(1299, nd::max(a));
+  EXPECT_ARRAY_EQ(-700, nd::min(a));
+
+  nd::array b = nd::empty(2000, ndt::make_type<int>());
+  for (int i = 0; i < 2000; ++i) {
+    b(i).assign(i - 700);
+  }
+  EXPECT_ARRAY_EQ(1999 * 1000 - 2000 * 700, f(b));
+  EXPECT_ARRAY_EQ(1299, nd::max(b));
+
+  nd::array res = f({a}, {{"axes", {1}}});
+  for (int i = 0; i < 40; ++i) {
+    EXPECT_EQ(2500 * i + 1225 - 50 * 700, res(i).as<int>());
+  }
+
+  res = f({a}, {{"axes", {0}}});
+  for (int j = 0; j < 50; ++j) {
+    EXPECT_EQ(39000 + 40 * j - 40 * 700, res(j).as<int>());
+  }
+
+  eval::default_eval_context = saved;
+}
+
+TEST(Reduction, ParallelNotAssociative) {
+  eval::eval_context saved = eval::default_eval_context;
+  eval::default_eval_context.nthreads = 4;
+  eval::default_eval_context.parallel_chunk_size = 16;
+
+  nd::array a = nd::empty(2000, ndt::make_type<int>());
+
+  // The identity is not neutral, so it must only be applied once
+  a.assign(1);
+  nd::callable f = nd::functional::reduction([] { return 100; }, [](const return_wrapper<int> &res, int x) { res += x; });
+  EXPECT_ARRAY_EQ(2100, f(a));
+
+  // Accumulating x * x cannot be used to combine partial results
+  a.assign(2);
+  f = nd::functional::reduction([] { return 0; }, [](const return_wrapper<int> &res, int x) { res += x * x; });
+  EXPECT_ARRAY_EQ(8000, f(a));
+
+  eval::default_eval_context = saved;
+}
+
+TEST(Reduction, ParallelNotThreadSafe) {
+  eval::eval_context saved = eval::default_eval_context;
+  eval::default_eval_context.nthreads = 4;
+  eval::default_eval_context.parallel_chunk_size = 16;
+
+  // An associative child that has not declared itself thread-safe only runs on the calling thread
+  std::set<std::thread::id> ids;
+  nd::callable f = nd::functional::reduction([] { return 0; }, [&ids](const return_wrapper<int> &res, int x) {
+    ids.insert(std::this_thread::get_id());
+    res += x;
+  }, true);
+
+  nd::array a = nd::empty(2000, ndt::make_type<int>());
+  a.assign(1);
+  EXPECT_ARRAY_EQ(2000, f(a));
+  EXPECT_EQ(1u, ids.size());
+  EXPECT_EQ(1u, ids.count(std::this_thread::get_id()));
+
+  eval::default_eval_context = saved;
+}
+
 TEST(Reduction, Except) {
   // Cannot have a null child
   EXPECT_THROW(nd::functional::reduction([] { return 0; }, nd::callable()), invalid_argument);
@@ -11,6 +11,7 @@
 #include "inc_gtest.hpp"
 #include "../dynd_assertions.hpp"
 
+#include <dynd/json_parser.hpp>
 #include <dynd/search.hpp>
 
 #include "dynd_assertions.hpp"
@@ -21,6 +22,96 @@ using namespace dynd;
 TEST(Search, BinarySearch)
 {
   EXPECT_ARRAY_VALS_EQ(1, nd::binary_search(nd::array{0, 1, 2}, 1));
-  EXPECT_ARRAY_VALS_EQ(1, nd::binary_search(nd::array{5, 3, 1}, 3));
-  EXPECT_ARRAY_VALS_EQ(-1, nd::binary_search(nd::array{5, 3, 1}, 10));
+  EXPECT_ARRAY_VALS_EQ(1, nd::binary_search(nd::array{1, 3, 5}, 3));
+  EXPECT_ARRAY_VALS_EQ(-1, nd::binary_search(nd::array{1, 3, 5}, 10));
+  EXPECT_ARRAY_VALS_EQ(-1, nd::binary_search(nd::array{1, 3, 5}, 2));
+  EXPECT_ARRAY_VALS_EQ(1, nd::binary_search(nd::array{1, 3, 3, 3, 5}, 3));
+  EXPECT_ARRAY_VALS_EQ(-1, nd::binary_search(nd::empty(0, ndt::make_type<int>()), 3));
+  EXPECT_ARRAY_VALS_EQ(2, nd::binary_search(nd::array{0.5, 1.5, 2.5}, 2.5));
+  EXPECT_ARRAY_VALS_EQ(1, nd::binary_search(nd::array{"apple", "banana", "pear"}, "banana"));
+
+  // Values of another type are assigned to the element type
+  EXPECT_ARRAY_VALS_EQ(1, nd::binary_search(nd::array{1, 3, 5}, 3.0));
+  EXPECT_ARRAY_VALS_EQ(2, nd::binary_search(nd::array{1, 3, 5}, static_cast<int64_t>(5)));
+  EXPECT_ARRAY_VALS_EQ(0, nd::binary_search(nd::array{0.5, 1.5, 2.5}, 0.5f));
+}
+
+static nd::array positions(std::initializer_list<intptr_t> values) { return nd::array(values); }
+
+TEST(Search, SearchSorted) {
+  nd::array a{1, 3, 3, 3, 5, 7};
+  nd::array needles{0, 1, 2, 3, 4, 5, 6, 7, 8, 3, 3};
+  EXPECT_ARRAY_EQ(positions({0, 0, 1, 1, 4, 4, 5, 5, 6, 1, 1}), nd::searchsorted(a, needles));
+  EXPECT_ARRAY_EQ(positions({0, 1, 1, 4, 4, 5, 5, 6, 6, 4, 4}),
+                  nd::searchsorted({a, needles}, {{"side", "right"}}));
+  EXPECT_ARRAY_EQ(positions({-1, 0, -1, 1, -1, 4, -1, 5, -1, 1, 1}),
+                  nd::searchsorted({a, needles}, {{"side", "exact"}}));
+  EXPECT_THROW(nd::searchsorted({a, needles}, {{"side", "middle"}}), invalid_argument);
+
+  nd::array strs{"apple", "banana", "pear"};
+  EXPECT_ARRAY_EQ(positions({0, 2, 3}), nd::searchsorted(strs, nd::array{"a", "cherry", "plum"}));
+
+  EXPECT_ARRAY_EQ(positions({1, 4, 6}), nd::searchsorted(a, nd::array{2.0, 4.0, 8.0}));
+}
+
+TEST(Search, SearchSortedNaN) {
+  // NaN and NA come after every value, and are equal to each other
+  double nan = numeric_limits<double>::quiet_NaN();
+  nd::array a{1.0, 2.0, nan, nan};
+  nd::array needles{nan, 2.0, 5.0};
+  EXPECT_ARRAY_EQ(positions({2, 1, 2}), nd::searchsorted(a, needles));
+  EXPECT_ARRAY_EQ(positions({4, 2, 2}), nd::searchsorted({a, needles}, {{"side", "right"}}));
+  EXPECT_ARRAY_EQ(positions({2, 1, -1}), nd::searchsorted({a, needles}, {{"side", "exact"}}));
+  EXPECT_ARRAY_VALS_EQ(2, nd::binary_search(a, nan));
+
+  nd::array b = parse_json("5 * ?int32", "[1, 3, 5, null, null]");
+  nd::array na_needles = parse_json("3 * ?int32", "[null, 3, 6]");
+  EXPECT_ARRAY_EQ(positions({3, 1, 3}), nd::searchsorted(b, na_needles));
+  EXPECT_ARRAY_EQ(positions({5, 2, 3}), nd::searchsorted({b, na_needles}, {{"side", "right"}}));
+  EXPECT_ARRAY_EQ(positions({3, 1, -1}), nd::searchsorted({b, na_needles}, {{"side", "exact"}}));
+  EXPECT_ARRAY_EQ(positions({0, 2}), nd::searchsorted(b, nd::array{0, 5}));
+  EXPECT_ARRAY_VALS_EQ(3, nd::binary_search(b, parse_json("?int32", "null")));
+
+  for (const char *tp : {"uint8", "uint16", "uint32", "uint64"}) {
+    b = parse_json(ndt::type(std::string("5 * ?") + tp), "[1, 3, 5, null, null]");
+    na_needles = parse_json(ndt::type(std::string("3 * ?") + tp), "[null, 3, 6]");
+    EXPECT_ARRAY_EQ(positions({3, 1, 3}), nd::searchsorted(b, na_needles)) << tp;
+    EXPECT_ARRAY_EQ(positions({3, 1, -1}), nd::searchsorted({b, na_needles}, {{"side", "exact"}})) << tp;
+    EXPECT_ARRAY_VALS_EQ(3, nd::binary_search(b, parse_json(ndt::type(std::string("?") + tp), "null"))) << tp;
+  }
+}
+
+TEST(Search, Eytzinger) {
+  nd::array a = nd::empty(1000, ndt::make_type<int64_t>());
+  nd::array needles = nd::empty(2003, ndt::make_type<int64_t>());
+  for (int i = 0; i < 1000; ++i) {
+    a(i).assign(2 * (i / 2));
+  }
+  for (int i = 0; i < 2003; ++i) {
+    needles(i).assign(i - 2);
+  }
+
+  nd::array e = nd::eytzinger(a);
+  EXPECT_EQ(a.get_type(), e.get_type());
+  EXPECT_EQ(a(511).as<int64_t>(), e(0).as<int64_t>());
+
+  for (const char *side : {"left", "right", "exact"}) {
+    nd::array expected = nd::searchsorted({a, needles}, {{"side", side}});
+    nd::array res = nd::searchsorted({e, needles(irange().by(1))}, {{"side", side}, {"layout", "eytzinger"}});
+    EXPECT_ARRAY_EQ(expected, res);
+  }
+
+  // Every size of a small tree, where the last level is partly filled
+  for (int n = 0; n < 40; ++n) {
+    nd::array b = nd::empty(n, ndt::make_type<int32_t>());
+    for (int i = 0; i < n; ++i) {
+      b(i).assign(2 * i);
+    }
+    nd::array vals = nd::empty(2 * n + 2, ndt::make_type<int32_t>());
+    for (int i = 0; i < 2 * n + 2; ++i) {
+      vals(i).assign(i - 1);
+    }
+    EXPECT_ARRAY_EQ(nd::searchsorted(b, vals),
+                    nd::searchsorted({nd::eytzinger(b), vals}, {{"layout", "eytzinger"}}));
+  }
 }
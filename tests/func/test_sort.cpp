@@ -7,10 +7,15 @@
 #include <stdexcept>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <string>
+#include <limits>
+#include <vector>
 
 #include "inc_gtest.hpp"
 
 #include <dynd/sort.hpp>
+#include <dynd/types/fixed_bytes_type.hpp>
 
 #include "dynd_assertions.hpp"
 
@@ -27,11 +32,233 @@ TEST(Sort, 1D) {
   EXPECT_ARRAY_EQ((nd::array{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19}), a);
 }
 
-/*
-TEST(Unique, 1D)
-{
-  nd::array a{0, 0, 1, 2, 2, 3};
-  nd::unique(a);
-  EXPECT_ARRAY_EQ((nd::array{0, 1, 2, 3}), a);
+TEST(Sort, Radix) {
+  vector<int64_t> vals(5000);
+  for (size_t i = 0; i < vals.size(); ++i) {
+    vals[i] = static_cast<int64_t>((i * 2654435761u) % 10007) - 5000;
+  }
+  vals[17] = numeric_limits<int64_t>::min();
+  vals[1234] = numeric_limits<int64_t>::max();
+
+  nd::array a = nd::empty(ndt::make_type<ndt::fixed_dim_type>(vals.size(), ndt::make_type<int64_t>()));
+  memcpy(a.data(), vals.data(), vals.size() * sizeof(int64_t));
+  nd::sort(a);
+
+  std::sort(vals.begin(), vals.end());
+  EXPECT_EQ(0, memcmp(vals.data(), a.cdata(), vals.size() * sizeof(int64_t)));
+}
+
+TEST(Sort, NaN) {
+  double nan = numeric_limits<double>::quiet_NaN();
+  double inf = numeric_limits<double>::infinity();
+
+  nd::array a{nan, 2.5, -inf, 0.0, nan, -1.0, inf};
+  nd::sort(a);
+  const double *data = reinterpret_cast<const double *>(a.cdata());
+  EXPECT_EQ(-inf, data[0]);
+  EXPECT_EQ(-1.0, data[1]);
+  EXPECT_EQ(0.0, data[2]);
+  EXPECT_EQ(2.5, data[3]);
+  EXPECT_EQ(inf, data[4]);
+  EXPECT_TRUE(std::isnan(data[5]));
+  EXPECT_TRUE(std::isnan(data[6]));
+
+  vector<float> vals(2000);
+  for (size_t i = 0; i < vals.size(); ++i) {
+    vals[i] = (i % 7 == 0) ? numeric_limits<float>::quiet_NaN() : static_cast<float>((i * 37) % 101) - 50.5f;
+  }
+  a = nd::empty(ndt::make_type<ndt::fixed_dim_type>(vals.size(), ndt::make_type<float>()));
+  memcpy(a.data(), vals.data(), vals.size() * sizeof(float));
+  nd::sort(a);
+
+  const float *fdata = reinterpret_cast<const float *>(a.cdata());
+  size_t nnan = (vals.size() + 6) / 7;
+  EXPECT_TRUE(std::is_sorted(fdata, fdata + vals.size() - nnan));
+  for (size_t i = vals.size() - nnan; i < vals.size(); ++i) {
+    EXPECT_TRUE(std::isnan(fdata[i]));
+  }
+}
+
+TEST(Sort, SignedZero) {
+  // -0.0 goes before 0.0 both below and above the radix sort threshold
+  for (size_t size : {size_t(10), size_t(2000)}) {
+    vector<double> vals(size);
+    for (size_t i = 0; i < size; ++i) {
+      vals[i] = (i % 2 == 0) ? 0.0 : -0.0;
+    }
+    nd::array a = nd::empty(ndt::make_type<ndt::fixed_dim_type>(size, ndt::make_type<double>()));
+    memcpy(a.data(), vals.data(), size * sizeof(double));
+    nd::sort(a);
+
+    const double *data = reinterpret_cast<const double *>(a.cdata());
+    for (size_t i = 0; i < size; ++i) {
+      EXPECT_EQ(i < size / 2, std::signbit(data[i])) << "at index " << i << " of " << size;
+    }
+  }
+}
+
+TEST(Sort, Strided) {
+  nd::array a{{5, 0}, {3, 1}, {4, 2}, {1, 3}};
+  nd::array b = a(irange(), 0);
+  nd::sort(b);
+  EXPECT_ARRAY_EQ((nd::array{{1, 0}, {3, 1}, {4, 2}, {5, 3}}), a);
+}
+
+TEST(Sort, String) {
+  nd::array a{"pear", "apple", "", "apple pie, with a crust", "apple pie, with a cherry", "banana", "apple"};
+  nd::sort(a);
+  EXPECT_ARRAY_EQ(
+      (nd::array{"", "apple", "apple", "apple pie, with a cherry", "apple pie, with a crust", "banana", "pear"}), a);
+}
+
+TEST(Sort, Parallel) {
+  eval::eval_context saved = eval::default_eval_context;
+  eval::default_eval_context.nthreads = 4;
+  eval::default_eval_context.parallel_chunk_size = 16;
+
+  vector<int32_t> vals(3001);
+  for (size_t i = 0; i < vals.size(); ++i) {
+    vals[i] = static_cast<int32_t>((i * 7919) % 1013) - 500;
+  }
+  nd::array a = nd::empty(ndt::make_type<ndt::fixed_dim_type>(vals.size(), ndt::make_type<int32_t>()));
+  memcpy(a.data(), vals.data(), vals.size() * sizeof(int32_t));
+  nd::sort(a);
+  std::sort(vals.begin(), vals.end());
+  EXPECT_EQ(0, memcmp(vals.data(), a.cdata(), vals.size() * sizeof(int32_t)));
+
+  // Strings, which are sorted by their prefixes with a comparison sort
+  a = nd::empty(ndt::make_type<ndt::fixed_dim_type>(500, ndt::make_type<dynd::string>()));
+  vector<std::string> strs(500);
+  for (int i = 0; i < 500; ++i) {
+    strs[i] = "a longer common prefix " + to_string((i * 31) % 500);
+    a(i).assign(strs[i]);
+  }
+  nd::sort(a);
+  std::sort(strs.begin(), strs.end());
+  for (int i = 0; i < 500; ++i) {
+    EXPECT_EQ(strs[i], a(i).as<std::string>());
+  }
+
+  eval::default_eval_context = saved;
+}
+
+TEST(Argsort, 1D) {
+  nd::array a{2.5, 1.25, 0.0, 1.25};
+  EXPECT_ARRAY_EQ((nd::array{intptr_t(2), intptr_t(1), intptr_t(3), intptr_t(0)}), nd::argsort(a));
+  EXPECT_ARRAY_EQ((nd::array{2.5, 1.25, 0.0, 1.25}), a);
+
+  a = {"pear", "apple", "banana"};
+  EXPECT_ARRAY_EQ((nd::array{intptr_t(1), intptr_t(2), intptr_t(0)}), nd::argsort(a));
+}
+
+TEST(Argsort, NaN) {
+  double nan = numeric_limits<double>::quiet_NaN();
+
+  // The same order as nd::sort, with every NaN last and ties kept in place
+  nd::array a{3.0, nan, 1.0, nan, 2.0, 0.5};
+  EXPECT_ARRAY_EQ((nd::array{intptr_t(5), intptr_t(2), intptr_t(4), intptr_t(0), intptr_t(1), intptr_t(3)}),
+                  nd::argsort(a));
+
+  nd::array b = nd::empty(2000, ndt::make_type<float>());
+  for (int i = 0; i < 2000; ++i) {
+    b(i).assign((i % 7 == 0) ? numeric_limits<float>::quiet_NaN() : static_cast<float>((i * 37) % 101) - 50.5f);
+  }
+  nd::array res = nd::argsort(b);
+  for (intptr_t i = 1; i < 2000; ++i) {
+    float prev = b(res(i - 1).as<intptr_t>()).as<float>(), cur = b(res(i).as<intptr_t>()).as<float>();
+    EXPECT_TRUE(std::isnan(cur) || prev <= cur);
+  }
+  EXPECT_TRUE(std::isnan(b(res(1999).as<intptr_t>()).as<float>()));
+}
+
+TEST(Argsort, Parallel) {
+  eval::eval_context saved = eval::default_eval_context;
+  eval::default_eval_context.nthreads = 4;
+  eval::default_eval_context.parallel_chunk_size = 16;
+
+  // Few distinct values, so the order of ties checks that the sort is stable
+  nd::array a = nd::empty(1000, ndt::make_type<int32_t>());
+  for (int i = 0; i < 1000; ++i) {
+    a(i).assign((i * 37) % 10);
+  }
+  nd::array b = a(irange().by(2));
+
+  nd::array res = nd::argsort(b);
+  EXPECT_EQ(ndt::type("500 * intptr"), res.get_type());
+  for (intptr_t i = 1; i < 500; ++i) {
+    intptr_t prev = res(i - 1).as<intptr_t>(), cur = res(i).as<intptr_t>();
+    int prev_val = b(prev).as<int>(), cur_val = b(cur).as<int>();
+    EXPECT_TRUE(prev_val < cur_val || (prev_val == cur_val && prev < cur));
+  }
+
+  eval::default_eval_context = saved;
+}
+
+TEST(Unique, 1D) {
+  nd::array a{3, 1, 3, 2, 1, 3};
+  EXPECT_ARRAY_EQ((nd::array{3, 1, 2}), nd::unique(a));
+  EXPECT_ARRAY_EQ((nd::array{3, 1, 3, 2, 1, 3}), a);
+
+  a = {0.5, -0.0, nan(""), 0.0, 0.5, nan("")};
+  nd::array res = nd::unique(a);
+  EXPECT_EQ(3, res.get_dim_size());
+  EXPECT_EQ(0.5, res(0).as<double>());
+  EXPECT_EQ(0.0, res(1).as<double>());
+  EXPECT_TRUE(std::isnan(res(2).as<double>()));
+
+  a = nd::empty(0, ndt::make_type<int64_t>());
+  EXPECT_EQ(0, nd::unique(a).get_dim_size());
+}
+
+TEST(Unique, Options) {
+  nd::array a = nd::empty(1000, ndt::make_type<int32_t>());
+  for (int i = 0; i < 1000; ++i) {
+    a(i).assign((i * 7) % 100);
+  }
+
+  nd::array res =
+      nd::unique({a(irange().by(2))}, {{"return_index", true}, {"return_inverse", true}, {"return_counts", true}});
+  nd::array values = res.p("values"), index = res.p("index"), inverse = res.p("inverse"), counts = res.p("counts");
+  ASSERT_EQ(50, values.get_dim_size());
+  for (int j = 0; j < 50; ++j) {
+    EXPECT_EQ(values(j).as<int>(), a(2 * index(j).as<intptr_t>()).as<int>());
+    EXPECT_EQ(10, counts(j).as<intptr_t>());
+  }
+  for (int i = 0; i < 500; ++i) {
+    EXPECT_EQ(a(2 * i).as<int>(), values(inverse(i).as<intptr_t>()).as<int>());
+  }
+
+  res = nd::unique({a}, {{"return_counts", true}});
+  EXPECT_EQ(ndt::type("{values: 100 * int32, counts: 100 * intptr}"), res.get_type());
+}
+
+TEST(Unique, String) {
+  nd::array a = nd::empty(6, ndt::make_type<dynd::string>());
+  const char *vals[6] = {"short", "a string that does not fit in place", "short", "",
+                         "a string that does not fit in place", "shorter"};
+  for (int i = 0; i < 6; ++i) {
+    a(i).assign(vals[i]);
+  }
+
+  // A short string which is on the heap, after being assigned over a long one
+  nd::array b = nd::empty(ndt::make_type<dynd::string>());
+  b.assign("a string that does not fit in place");
+  b.assign("short");
+  a(3).assign(b);
+
+  nd::array res = nd::unique({a}, {{"return_counts", true}});
+  EXPECT_ARRAY_EQ((nd::array{"short", "a string that does not fit in place", "shorter"}), res.p("values"));
+  EXPECT_ARRAY_EQ((nd::array{intptr_t(3), intptr_t(2), intptr_t(1)}), res.p("counts"));
+}
+
+TEST(Unique, FixedBytes) {
+  nd::array a = nd::empty(4, ndt::make_type<ndt::fixed_bytes_type>(3, 1));
+  const char *vals[4] = {"abc", "xyz", "abc", "abd"};
+  for (int i = 0; i < 4; ++i) {
+    memcpy(a(i).data(), vals[i], 3);
+  }
+
+  nd::array res = nd::unique(a);
+  ASSERT_EQ(3, res.get_dim_size());
+  EXPECT_EQ(0, memcmp(res(2).cdata(), "abd", 3));
 }
-*/
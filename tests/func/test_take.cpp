@@ -7,9 +7,13 @@
 #include <stdexcept>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <vector>
 
 #include "inc_gtest.hpp"
+#include "dynd_assertions.hpp"
 
+#include <dynd/cpu_features.hpp>
 #include <dynd/index.hpp>
 
 using namespace std;
@@ -35,14 +39,12 @@ TEST(Callable, Take) {
   intptr_t bvals2[4] = {3, 0, -1, 4};
   b = bvals2;
   c = nd::take(a, b);
-/*
   EXPECT_EQ(ndt::type("4 * int"), c.get_type());
   ASSERT_EQ(4, c.get_dim_size());
   EXPECT_EQ(4, c(0).as<int>());
   EXPECT_EQ(1, c(1).as<int>());
   EXPECT_EQ(5, c(2).as<int>());
   EXPECT_EQ(5, c(3).as<int>());
-*/
 }
 
 TEST(Callable, TakeOfArray) {
@@ -63,7 +65,6 @@ TEST(Callable, TakeOfArray) {
   EXPECT_EQ(4, c(1, 0).as<int>());
   EXPECT_EQ(5, c(1, 1).as<int>());
 
-/*
   // Indexed take
   intptr_t bvals2[4] = {1, 0, -1, -2};
   b = bvals2;
@@ -79,5 +80,106 @@ TEST(Callable, TakeOfArray) {
   EXPECT_EQ(5, c(2, 1).as<int>());
   EXPECT_EQ(2, c(3, 0).as<int>());
   EXPECT_EQ(3, c(3, 1).as<int>());
-*/
+}
+
+TEST(Callable, TakeIndexed) {
+  eval::eval_context saved = eval::default_eval_context;
+  eval::default_eval_context.nthreads = 4;
+  eval::default_eval_context.parallel_chunk_size = 16;
+
+  intptr_t n = 1000;
+  nd::array a = nd::empty(n, ndt::make_type<int64_t>());
+  nd::array b = nd::empty(3 * n, ndt::make_type<intptr_t>());
+  for (intptr_t i = 0; i < n; ++i) {
+    a(i).assign(10 * i);
+  }
+  for (intptr_t i = 0; i < 3 * n; ++i) {
+    b(i).assign((i * 7919) % (2 * n) - n);
+  }
+
+  // With any vector gathers, and without
+  for (uint32_t features : {~0u, 0u}) {
+    restrict_cpu_features(features);
+    nd::array c = nd::take(a, b);
+    EXPECT_EQ(ndt::make_fixed_dim(3 * n, ndt::make_type<int64_t>()), c.get_type());
+    for (intptr_t i = 0; i < 3 * n; ++i) {
+      intptr_t ix = (i * 7919) % (2 * n) - n;
+      ASSERT_EQ(10 * (ix < 0 ? ix + n : ix), c(i).as<int64_t>());
+    }
+  }
+  restrict_cpu_features(~0u);
+
+  // A strided source and sixteen byte elements
+  nd::array d = nd::empty(2 * n, ndt::make_type<dynd::complex<double>>());
+  for (intptr_t i = 0; i < 2 * n; ++i) {
+    d(i).assign(dynd::complex<double>(static_cast<double>(i), -static_cast<double>(i)));
+  }
+  nd::array c = nd::take(d(irange().by(2)), b);
+  for (intptr_t i = 0; i < 3 * n; ++i) {
+    intptr_t ix = (i * 7919) % (2 * n) - n;
+    ix = 2 * (ix < 0 ? ix + n : ix);
+    ASSERT_EQ(dynd::complex<double>(static_cast<double>(ix), -static_cast<double>(ix)),
+              c(i).as<dynd::complex<double>>());
+  }
+
+  // Strings go through their assignment kernel
+  nd::array s{"a", "bb", "ccc"};
+  intptr_t svals[4] = {2, 0, -1, 1};
+  EXPECT_ARRAY_EQ((nd::array{"ccc", "a", "ccc", "bb"}), nd::take(s, nd::array(svals)));
+
+  intptr_t bad[3] = {0, 1000, 1};
+  EXPECT_THROW(nd::take(a, nd::array(bad)), index_out_of_bounds);
+  bad[1] = -1001;
+  EXPECT_THROW(nd::take(a, nd::array(bad)), index_out_of_bounds);
+
+  eval::default_eval_context = saved;
+}
+
+TEST(Callable, TakeMasked) {
+  intptr_t n = 1000;
+  nd::array a = nd::empty(n, ndt::make_type<int32_t>());
+  nd::array mask = nd::empty(n, ndt::make_type<bool1>());
+  nd::array packed = nd::empty((n + 7) / 8, ndt::make_type<uint8_t>());
+  uint8_t *packed_data = reinterpret_cast<uint8_t *>(packed.data());
+  memset(packed_data, 0, (n + 7) / 8);
+  vector<int32_t> expected;
+  for (intptr_t i = 0; i < n; ++i) {
+    bool selected = (i * 7919) % 5 < 2 || (i > 300 && i < 500);
+    a(i).assign(static_cast<int32_t>(3 * i));
+    mask(i).assign(selected);
+    if (selected) {
+      packed_data[i / 8] |= static_cast<uint8_t>(1 << (i % 8));
+      expected.push_back(static_cast<int32_t>(3 * i));
+    }
+  }
+
+  // With any compressing stores, and without
+  for (uint32_t features : {~0u, 0u}) {
+    restrict_cpu_features(features);
+    for (const nd::array &m : {mask, packed}) {
+      nd::array c = m.get_dtype().get_id() == uint8_id ? nd::take_packed(a, m) : nd::take(a, m);
+      EXPECT_EQ(ndt::type("var * int32"), c.get_type());
+      ASSERT_EQ(static_cast<intptr_t>(expected.size()), c.get_dim_size());
+      for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(expected[i], c(i).as<int32_t>());
+      }
+    }
+  }
+  restrict_cpu_features(~0u);
+
+  // Strings go through their assignment kernel, a run at a time
+  nd::array s{"a", "bb", "ccc", "dddd", "eeeee"};
+  uint8_t svals[1] = {0x1b};
+  nd::array c = nd::take_packed(s, nd::array(svals));
+  ASSERT_EQ(4, c.get_dim_size());
+  EXPECT_EQ("a", c(0).as<std::string>());
+  EXPECT_EQ("bb", c(1).as<std::string>());
+  EXPECT_EQ("dddd", c(2).as<std::string>());
+  EXPECT_EQ("eeeee", c(3).as<std::string>());
+
+  uint8_t bad[2] = {1, 1};
+  EXPECT_THROW(nd::take_packed(s, nd::array(bad)), invalid_argument);
+
+  // A uint8 array is only read as bits when asked for
+  EXPECT_THROW(nd::take(a, packed), invalid_argument);
 }
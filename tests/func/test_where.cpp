@@ -23,3 +23,33 @@ TEST(Where, Untitled) {
   EXPECT_ARRAY_EQ(nd::array({static_cast<intptr_t>(2)}), res(1));
   EXPECT_ARRAY_EQ(nd::array({static_cast<intptr_t>(3)}), res(2));
 }
+
+TEST(Where, Long) {
+  // Enough elements for several chunks of the predicate mask, with the
+  // matches split unevenly between them
+  std::vector<int> values(10000);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<int>((i * 7919) % 100);
+  }
+
+  nd::callable f = nd::functional::where([](int x) { return x < 3; });
+  nd::array res = f(nd::array(values.data(), values.size()));
+
+  std::vector<intptr_t> expected;
+  for (size_t i = 0; i < values.size(); ++i) {
+    if (values[i] < 3) {
+      expected.push_back(i);
+    }
+  }
+
+  ASSERT_EQ(static_cast<intptr_t>(expected.size()), res.get_dim_size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(expected[i], res(i, 0).as<intptr_t>());
+  }
+}
+
+TEST(Where, None) {
+  nd::callable f = nd::functional::where([](int x) { return x < 0; });
+  nd::array res = f(nd::array{9, 34, 1, 7, 23});
+  EXPECT_EQ(0, res.get_dim_size());
+}
@@ -0,0 +1,75 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+
+#include "dynd_assertions.hpp"
+#include "inc_gtest.hpp"
+
+#include <dynd/arithmetic.hpp>
+#include <dynd/array.hpp>
+#include <dynd/cpu_features.hpp>
+#include <dynd/functional.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(CPUFeatures, Consistent) {
+  uint32_t features = detected_cpu_features();
+#if defined(DYND_ISA_DISPATCH) && defined(__x86_64__)
+  EXPECT_TRUE((features & cpu_feature_sse2) != 0);
+#endif
+  if (features & cpu_feature_avx2) {
+    EXPECT_TRUE((features & cpu_feature_avx) != 0);
+  }
+  if (features & cpu_feature_avx512bw) {
+    EXPECT_TRUE((features & cpu_feature_avx512f) != 0);
+  }
+
+  EXPECT_EQ(features, cpu_features());
+  EXPECT_TRUE(cpu_supports(cpu_feature_none));
+}
+
+TEST(CPUFeatures, Restrict) {
+  restrict_cpu_features(cpu_feature_none);
+  EXPECT_EQ(cpu_feature_none, cpu_features());
+  EXPECT_TRUE(cpu_supports(cpu_feature_none));
+
+  restrict_cpu_features(~0u);
+  EXPECT_EQ(detected_cpu_features(), cpu_features());
+}
+
+TEST(CPUFeatures, ISADispatch) {
+  nd::callable f = nd::functional::isa_dispatch(
+      {{cpu_feature_none, nd::functional::apply([](int x) { return x; })},
+       {cpu_feature_sse2, nd::functional::apply([](int x) { return x + 1; })},
+       {cpu_feature_sse2 | cpu_feature_avx2, nd::functional::apply([](int x) { return x + 2; })}});
+
+  int expected = cpu_supports(cpu_feature_sse2 | cpu_feature_avx2) ? 12 : (cpu_supports(cpu_feature_sse2) ? 11 : 10);
+  EXPECT_ARRAY_EQ(expected, f(10));
+
+  restrict_cpu_features(cpu_feature_none);
+  EXPECT_ARRAY_EQ(10, f(10));
+
+  restrict_cpu_features(~0u);
+  EXPECT_ARRAY_EQ(expected, f(10));
+}
+
+TEST(CPUFeatures, Baseline) {
+  nd::array a = nd::empty(37, ndt::make_type<float>());
+  nd::array b = nd::empty(37, ndt::make_type<float>());
+  for (int i = 0; i < 37; ++i) {
+    a(i).assign(0.25f * i);
+    b(i).assign(7.0f - i);
+  }
+
+  nd::array c = a * b;
+  restrict_cpu_features(cpu_feature_none);
+  nd::array d = a * b;
+  restrict_cpu_features(~0u);
+
+  EXPECT_ARRAY_EQ(c, d);
+}
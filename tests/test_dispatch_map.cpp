@@ -12,6 +12,7 @@
 #include "inc_gtest.hpp"
 
 #include <dynd/dispatcher.hpp>
+#include <dynd/functional.hpp>
 #include <dynd/type_registry.hpp>
 #include <dynd/types/bool_kind_type.hpp>
 
@@ -131,3 +132,51 @@ TEST(Dispatcher, Ternary) {
   EXPECT_EQ(0, dispatcher(option_id, int64_id));
 }
 */
+
+namespace {
+
+std::vector<ndt::type> dispatch_arg0(const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc),
+                                     const ndt::type *src_tp) {
+  return {src_tp[0]};
+}
+
+} // unnamed namespace
+
+TEST(Dispatcher, Memoized) {
+  nd::callable int32_child = nd::functional::apply([](int32_t x) { return x; });
+  nd::callable float64_child = nd::functional::apply([](double x) { return x; });
+  nd::callable scalar_child = nd::get_elwise(ndt::type("(Scalar) -> Any"));
+  nd::callable dim_child = nd::get_elwise(ndt::type("(Dim) -> Any"));
+
+  dispatcher<1, nd::callable> dispatcher(dispatch_arg0, {int32_child, float64_child, dim_child});
+
+  ndt::type dst_tp("Any");
+  ndt::type src_tp[4] = {ndt::make_type<int32_t>(), ndt::make_type<float>(), ndt::type("3 * int32"),
+                         ndt::type("2 * 5 * float64")};
+
+  // Twice each, so the second lookup is answered by the cache
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(int32_child.get(), dispatcher(dst_tp, 1, &src_tp[0]).get());
+    EXPECT_THROW(dispatcher(dst_tp, 1, &src_tp[1]), out_of_range);
+    EXPECT_EQ(dim_child.get(), dispatcher(dst_tp, 1, &src_tp[2]).get());
+    EXPECT_EQ(dim_child.get(), dispatcher(dst_tp, 1, &src_tp[3]).get());
+  }
+
+  dispatcher.insert(scalar_child);
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(int32_child.get(), dispatcher(dst_tp, 1, &src_tp[0]).get());
+    EXPECT_EQ(scalar_child.get(), dispatcher(dst_tp, 1, &src_tp[1]).get());
+    EXPECT_EQ(dim_child.get(), dispatcher(dst_tp, 1, &src_tp[2]).get());
+  }
+
+  nd::callable float32_child = nd::functional::apply([](float x) { return x; });
+  dispatcher.insert(float32_child);
+  EXPECT_EQ(float32_child.get(), dispatcher(dst_tp, 1, &src_tp[1]).get());
+
+  // More distinct types than fit in the cache
+  for (int i = 1; i < 2000; ++i) {
+    ndt::type tp = ndt::make_type<ndt::fixed_dim_type>(i, ndt::make_type<int32_t>());
+    EXPECT_EQ(dim_child.get(), dispatcher(dst_tp, 1, &tp).get());
+  }
+  EXPECT_EQ(int32_child.get(), dispatcher(dst_tp, 1, &src_tp[0]).get());
+}
@@ -5,6 +5,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <stdexcept>
 
@@ -12,10 +14,35 @@
 #include "inc_gtest.hpp"
 
 #include <dynd/io.hpp>
+#include <dynd/json_formatter.hpp>
+#include <dynd/json_parser.hpp>
+#include <dynd/memblock/memmap_memory_block.hpp>
+#include <dynd/types/var_dim_type.hpp>
 
 using namespace std;
 using namespace dynd;
 
+namespace {
+
+/**
+ * Saves ``a`` and loads it back, checking that the result has the same type
+ * and values.
+ */
+nd::array save_and_load(const nd::array &a) {
+  nd::save("test_io.dynd", a);
+  nd::array res = nd::load("test_io.dynd");
+  EXPECT_EQ(a.get_type(), res.get_type());
+  EXPECT_EQ(format_json(a).as<std::string>(), format_json(res).as<std::string>());
+  EXPECT_EQ(0u, res.get_flags() & nd::write_access_flag);
+  return res;
+}
+
+bool is_mapped(const nd::array &a) {
+  return dynamic_cast<nd::memmap_memory_block *>(a.get_data_memblock().get()) != NULL;
+}
+
+} // anonymous namespace
+
 TEST(Serialize, FixedDim) {
   EXPECT_ARRAY_EQ(bytes("\x00\x00\x00\x00\x01\x00\x00\x00\x02\x00\x00\x00\x03\x00\x00\x00\x04\x00\x00\x00"),
                   nd::serialize(nd::array{0, 1, 2, 3, 4}));
@@ -25,3 +52,81 @@ TEST(Serialize, FixedDimFixedDim) {
   EXPECT_ARRAY_EQ(bytes("\x00\x00\x00\x00\x01\x00\x00\x00\x02\x00\x00\x00\x03\x00\x00\x00"),
                   nd::serialize(nd::array{{0, 1}, {2, 3}}));
 }
+
+TEST(BinaryArrayFile, POD) {
+  nd::array a = save_and_load(nd::array{{0.5, 1.5, 2.5}, {3.5, 4.5, 5.5}});
+  EXPECT_TRUE(is_mapped(a));
+  EXPECT_EQ(4.5, a(1, 1).as<double>());
+
+  // A strided view is saved in the default layout
+  nd::array b = nd::array{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  a = save_and_load(b(irange().by(3)));
+  EXPECT_TRUE(is_mapped(a));
+  EXPECT_EQ(ndt::type("4 * int32"), a.get_type());
+
+  a = save_and_load(nd::array(7));
+  EXPECT_EQ(7, a.as<int>());
+
+  a = save_and_load(parse_json("3 * {x: int8, y: float64}", "[{\"x\": 1, \"y\": 2.5}, {\"x\": 3, \"y\": 4.5}, {\"x\": 5, \"y\": 6.5}]"));
+  EXPECT_TRUE(is_mapped(a));
+
+  a = nd::array();
+  remove("test_io.dynd");
+}
+
+TEST(BinaryArrayFile, Strings) {
+  nd::array a = save_and_load(parse_json("3 * {name: string, id: int32}",
+                                         "[{\"name\": \"a\", \"id\": 1}, "
+                                         "{\"name\": \"a longer string than fits in place\", \"id\": 2}, "
+                                         "{\"name\": \"\", \"id\": 3}]"));
+  EXPECT_EQ("a longer string than fits in place", a(1, 0).as<std::string>());
+  EXPECT_FALSE(is_mapped(a));
+
+  nd::array b = nd::empty(2, ndt::make_type<bytes>());
+  reinterpret_cast<bytes *>(b.data())[0].assign("\x00\x01\x02", 3);
+  reinterpret_cast<bytes *>(b.data())[1].assign("abcdefghijklmnopqrstuvwxyz", 26);
+  nd::save("test_io.dynd", b);
+  a = nd::load("test_io.dynd");
+  EXPECT_EQ(b.get_type(), a.get_type());
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_TRUE(reinterpret_cast<const bytes *>(b.cdata())[i] == reinterpret_cast<const bytes *>(a.cdata())[i]);
+  }
+
+  a = nd::array();
+  remove("test_io.dynd");
+}
+
+TEST(BinaryArrayFile, Var) {
+  // Var dimensions of values in place point into the file
+  nd::array a = save_and_load(parse_json("3 * var * float64", "[[1, 2, 3], [], [4.5]]"));
+  EXPECT_EQ(4.5, a(2, 0).as<double>());
+  const ndt::var_dim_type::metadata_type *md = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(
+      a.get()->metadata() + sizeof(fixed_dim_type_arrmeta));
+  EXPECT_TRUE(dynamic_cast<nd::memmap_memory_block *>(md->blockref.get()) != NULL);
+
+  save_and_load(parse_json("var * string", "[\"abc\", \"a longer string than fits in place\", \"\"]"));
+  save_and_load(parse_json("2 * var * var * int16", "[[[1, 2], [], [3]], [[4, 5, 6]]]"));
+  save_and_load(parse_json("var * {x: int32, y: var * int64}", "[{\"x\": 1, \"y\": [2, 3]}, {\"x\": 4, \"y\": []}]"));
+  save_and_load(parse_json("var * int32", "[]"));
+
+  remove("test_io.dynd");
+}
+
+TEST(BinaryArrayFile, Errors) {
+  EXPECT_THROW(nd::load("test_io_missing.dynd"), runtime_error);
+
+  ofstream("test_io.dynd", ios::binary) << "This is not a binary array file, but it is long enough to be one.";
+  EXPECT_THROW(nd::load("test_io.dynd"), invalid_argument);
+
+  // A truncated file is caught before its data is read
+  nd::save("test_io.dynd", parse_json("var * float64", "[1, 2, 3, 4, 5, 6, 7, 8]"));
+  ifstream fin("test_io.dynd", ios::binary);
+  std::string contents((istreambuf_iterator<char>(fin)), istreambuf_iterator<char>());
+  fin.close();
+  ofstream("test_io.dynd", ios::binary).write(contents.data(), contents.size() - 8);
+  EXPECT_THROW(nd::load("test_io.dynd"), invalid_argument);
+
+  EXPECT_THROW(nd::save("test_io.dynd", nd::array(ndt::type("int32"))), type_error);
+
+  remove("test_io.dynd");
+}
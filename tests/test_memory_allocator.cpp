@@ -0,0 +1,79 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+
+#include "inc_gtest.hpp"
+#include "dynd_assertions.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/json_parser.hpp>
+#include <dynd/memblock/memory_allocator.hpp>
+#include <dynd/memblock/pod_memory_block.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(MemoryAllocator, PoolRoundsUp) {
+  nd::base_memory_allocator &allocator = nd::pool_memory_allocator();
+
+  intptr_t size = 1000;
+  char *ptr = allocator.allocate(size);
+  EXPECT_EQ(1024, size);
+  allocator.deallocate(ptr, size);
+
+  size = 3000;
+  ptr = allocator.allocate(size);
+  EXPECT_EQ(4096, size);
+  allocator.deallocate(ptr, size);
+
+  // Past the largest pooled size, chunks are exactly as large as requested
+  size = 3 << 20;
+  ptr = allocator.allocate(size);
+  EXPECT_EQ(3 << 20, size);
+  allocator.deallocate(ptr, size);
+}
+
+TEST(MemoryAllocator, PoolReuses) {
+  nd::base_memory_allocator &allocator = nd::pool_memory_allocator();
+
+  intptr_t size = 2048;
+  char *ptr = allocator.allocate(size);
+  allocator.deallocate(ptr, size);
+
+  // The chunk just given back is the next one handed out
+  intptr_t other_size = 1500;
+  EXPECT_EQ(ptr, allocator.allocate(other_size));
+  EXPECT_EQ(size, other_size);
+  allocator.deallocate(ptr, other_size);
+}
+
+TEST(MemoryAllocator, PODMemoryBlock) {
+  nd::memory_block malloc_block =
+      nd::make_memory_block<nd::pod_memory_block>(ndt::make_type<int>(), 2048, nd::malloc_memory_allocator());
+  nd::memory_block pool_block = nd::make_memory_block<nd::pod_memory_block>(ndt::make_type<int>());
+
+  // Enough to need several chunks from each allocator
+  for (const nd::memory_block &block : {malloc_block, pool_block}) {
+    for (int i = 0; i < 10; ++i) {
+      int *data = reinterpret_cast<int *>(block->alloc(1000));
+      for (int j = 0; j < 1000; ++j) {
+        data[j] = i * j;
+      }
+    }
+    block->reset();
+  }
+}
+
+TEST(MemoryAllocator, VarDim) {
+  // Ragged arrays get their data from the default allocator
+  for (int i = 0; i < 100; ++i) {
+    nd::array a = parse_json("3 * var * int32", "[[1, 2, 3], [4], [5, 6]]");
+    EXPECT_EQ(3, a(0).get_dim_size());
+    EXPECT_EQ(4, a(1, 0).as<int>());
+    EXPECT_EQ(6, a(2, 1).as<int>());
+  }
+}
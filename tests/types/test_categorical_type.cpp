@@ -7,14 +7,14 @@
 #include <sstream>
 #include <stdexcept>
 #include "inc_gtest.hpp"
+#include "dynd_assertions.hpp"
 
 #include <dynd/array.hpp>
 #include <dynd/types/categorical_type.hpp>
 #include <dynd/types/fixed_string_type.hpp>
 #include <dynd/types/string_type.hpp>
-#include <dynd/types/convert_type.hpp>
-#include <dynd/array_range.hpp>
-#include <dynd/func/comparison.hpp>
+#include <dynd/assignment.hpp>
+#include <dynd/range.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -26,51 +26,51 @@ TEST(CategoricalType, Create)
   a.vals() = a_vals;
 
   ndt::type d;
-  d = ndt::categorical_type::make(a);
+  d = ndt::make_type<ndt::categorical_type>(a);
   EXPECT_EQ(categorical_id, d.get_id());
   EXPECT_EQ(scalar_kind_id, d.get_base_id());
   EXPECT_EQ(1u, d.get_data_alignment());
   EXPECT_EQ(1u, d.get_data_size());
   EXPECT_FALSE(d.is_expression());
-  EXPECT_EQ(ndt::make_type<uint8_t>(), d.p("storage_type").as<ndt::type>());
-  EXPECT_EQ(a.get_dtype(), d.p("category_type").as<ndt::type>());
+  EXPECT_EQ(ndt::make_type<uint8_t>(), d.p<ndt::type>("storage_type"));
+  EXPECT_EQ(a.get_dtype(), d.p<ndt::type>("category_type"));
 
   // With <= 256 categories, storage is a uint8
   a = nd::range(256);
-  d = ndt::categorical_type::make(a);
+  d = ndt::make_type<ndt::categorical_type>(a);
   EXPECT_EQ(1u, d.get_data_alignment());
   EXPECT_EQ(1u, d.get_data_size());
-  EXPECT_EQ(ndt::make_type<uint8_t>(), d.p("storage_type").as<ndt::type>());
-  EXPECT_EQ(ndt::make_type<int32_t>(), d.p("category_type").as<ndt::type>());
+  EXPECT_EQ(ndt::make_type<uint8_t>(), d.p<ndt::type>("storage_type"));
+  EXPECT_EQ(ndt::make_type<int32_t>(), d.p<ndt::type>("category_type"));
 
   // With <= 65536 categories, storage is a uint16
   a = nd::range(257);
-  d = ndt::categorical_type::make(a);
+  d = ndt::make_type<ndt::categorical_type>(a);
   EXPECT_EQ(2u, d.get_data_alignment());
   EXPECT_EQ(2u, d.get_data_size());
   a = nd::range(65536);
-  d = ndt::categorical_type::make(a);
+  d = ndt::make_type<ndt::categorical_type>(a);
   EXPECT_EQ(2u, d.get_data_alignment());
   EXPECT_EQ(2u, d.get_data_size());
-  EXPECT_EQ(ndt::make_type<uint16_t>(), d.p("storage_type").as<ndt::type>());
-  EXPECT_EQ(ndt::make_type<int32_t>(), d.p("category_type").as<ndt::type>());
+  EXPECT_EQ(ndt::make_type<uint16_t>(), d.p<ndt::type>("storage_type"));
+  EXPECT_EQ(ndt::make_type<int32_t>(), d.p<ndt::type>("category_type"));
 
   // Otherwise, storage is a uint32
   a = nd::range(65537);
-  d = ndt::categorical_type::make(a);
+  d = ndt::make_type<ndt::categorical_type>(a);
   EXPECT_EQ(4u, d.get_data_alignment());
   EXPECT_EQ(4u, d.get_data_size());
-  EXPECT_EQ(ndt::make_type<uint32_t>(), d.p("storage_type").as<ndt::type>());
-  EXPECT_EQ(ndt::make_type<int32_t>(), d.p("category_type").as<ndt::type>());
+  EXPECT_EQ(ndt::make_type<uint32_t>(), d.p<ndt::type>("storage_type"));
+  EXPECT_EQ(ndt::make_type<int32_t>(), d.p<ndt::type>("category_type"));
 }
 
 TEST(CategoricalType, Convert)
 {
   const char *a_vals[] = {"foo", "bar", "baz"};
-  nd::array a = nd::empty(3, ndt::fixed_string_type::make(3, string_encoding_ascii));
+  nd::array a = nd::empty(3, ndt::make_type<ndt::fixed_string_type>(3, string_encoding_ascii));
   a.vals() = a_vals;
 
-  ndt::type cd = ndt::categorical_type::make(a);
+  ndt::type cd = ndt::make_type<ndt::categorical_type>(a);
   ndt::type sd = ndt::make_type<ndt::string_type>();
 
   // String conversions report false, so that assignments encodings
@@ -79,9 +79,11 @@ TEST(CategoricalType, Convert)
   EXPECT_FALSE(is_lossless_assignment(cd, sd));
 
   // This operation was crashing, hence the test
-  ndt::type cvt = ndt::convert_type::make(sd, cd);
-  EXPECT_EQ(cd, cvt.operand_type());
-  EXPECT_EQ(sd, cvt.value_type());
+  nd::array cvt = nd::empty(3, cd);
+  cvt.assign(a);
+  nd::array s = nd::empty(3, sd);
+  s.assign(cvt);
+  EXPECT_ARRAY_EQ(nd::array({"foo", "bar", "baz"}), s);
 }
 
 TEST(CategoricalType, Compare)
@@ -94,9 +96,9 @@ TEST(CategoricalType, Compare)
   nd::array b = nd::empty(2, ndt::make_type<ndt::string_type>());
   b.vals() = b_vals;
 
-  ndt::type da = ndt::categorical_type::make(a);
-  ndt::type da2 = ndt::categorical_type::make(a);
-  ndt::type db = ndt::categorical_type::make(b);
+  ndt::type da = ndt::make_type<ndt::categorical_type>(a);
+  ndt::type da2 = ndt::make_type<ndt::categorical_type>(a);
+  ndt::type db = ndt::make_type<ndt::categorical_type>(b);
 
   EXPECT_EQ(da, da);
   EXPECT_EQ(da, da2);
@@ -107,22 +109,22 @@ TEST(CategoricalType, Compare)
   i(1).vals() = 10;
   i(2).vals() = 100;
 
-  ndt::type di = ndt::categorical_type::make(i);
+  ndt::type di = ndt::make_type<ndt::categorical_type>(i);
   EXPECT_FALSE(da == di);
 }
 
 TEST(CategoricalType, Unique)
 {
   const char *a_vals[] = {"foo", "bar", "foo"};
-  nd::array a = nd::empty(3, ndt::fixed_string_type::make(3, string_encoding_ascii));
+  nd::array a = nd::empty(3, ndt::make_type<ndt::fixed_string_type>(3, string_encoding_ascii));
   a.vals() = a_vals;
 
-  EXPECT_THROW(ndt::categorical_type::make(a), std::runtime_error);
+  EXPECT_THROW(ndt::make_type<ndt::categorical_type>(a), std::runtime_error);
 
   int i_vals[] = {0, 10, 10};
   nd::array i = i_vals;
 
-  EXPECT_THROW(ndt::categorical_type::make(i), std::runtime_error);
+  EXPECT_THROW(ndt::make_type<ndt::categorical_type>(i), std::runtime_error);
 }
 
 TEST(CategoricalType, FactorFixedString)
@@ -136,7 +138,7 @@ TEST(CategoricalType, FactorFixedString)
   a.vals() = a_vals;
 
   ndt::type da = ndt::factor_categorical(a);
-  EXPECT_EQ(ndt::categorical_type::make(string_cats), da);
+  EXPECT_EQ(ndt::make_type<ndt::categorical_type>(string_cats), da);
 }
 
 TEST(CategoricalType, FactorString)
@@ -146,7 +148,7 @@ TEST(CategoricalType, FactorString)
   nd::array cats = cats_vals, a = a_vals;
 
   ndt::type da = ndt::factor_categorical(a);
-  EXPECT_EQ(ndt::categorical_type::make(cats), da);
+  EXPECT_EQ(ndt::make_type<ndt::categorical_type>(cats), da);
 }
 
 TEST(CategoricalType, FactorStringLonger)
@@ -164,7 +166,7 @@ TEST(CategoricalType, FactorStringLonger)
                           "a",
                           "abcdefghijklmnopqrstuvwxyz"};
   ndt::type da = ndt::factor_categorical(a_vals);
-  EXPECT_EQ(ndt::categorical_type::make(cats_vals), da);
+  EXPECT_EQ(ndt::make_type<ndt::categorical_type>(cats_vals), da);
 }
 
 TEST(CategoricalType, FactorInt)
@@ -178,16 +180,16 @@ TEST(CategoricalType, FactorInt)
   i.vals() = i_vals;
 
   ndt::type di = ndt::factor_categorical(i);
-  EXPECT_EQ(ndt::categorical_type::make(int_cats), di);
+  EXPECT_EQ(ndt::make_type<ndt::categorical_type>(int_cats), di);
 }
 
 TEST(CategoricalType, Values)
 {
   const char *a_vals[] = {"foo", "bar", "baz"};
-  nd::array a = nd::empty(3, ndt::fixed_string_type::make(3, string_encoding_ascii));
+  nd::array a = nd::empty(3, ndt::make_type<ndt::fixed_string_type>(3, string_encoding_ascii));
   a.vals() = a_vals;
 
-  ndt::type dt = ndt::categorical_type::make(a);
+  ndt::type dt = ndt::make_type<ndt::categorical_type>(a);
 
   EXPECT_EQ(0u, static_cast<const ndt::categorical_type *>(dt.extended())->get_value_from_category(a(0)));
   EXPECT_EQ(1u, static_cast<const ndt::categorical_type *>(dt.extended())->get_value_from_category(a(1)));
@@ -203,7 +205,6 @@ TEST(CategoricalType, Values)
                std::runtime_error);
 }
 
-/*
 TEST(CategoricalType, ValuesLonger)
 {
   const char *cats_vals[] = {"foo", "abcdefghijklmnopqrstuvwxyz", "z", "bar", "a", "foot"};
@@ -214,9 +215,10 @@ TEST(CategoricalType, ValuesLonger)
   int cats_count = sizeof(cats_vals) / sizeof(cats_vals[0]);
   int a_count = sizeof(a_uints) / sizeof(a_uints[0]);
 
-  ndt::type dt = ndt::categorical_type::make(cats_vals);
-  nd::array a = nd::array(a_vals).ucast(dt).eval();
-  nd::array a_view = a.p("ints");
+  ndt::type dt = ndt::make_type<ndt::categorical_type>(cats_vals);
+  nd::array a = nd::empty(a_count, dt);
+  a.assign(a_vals);
+  const uint8_t *a_view = reinterpret_cast<const uint8_t *>(a.cdata());
 
   // Check that the categories got the right values
   for (int i = 0; i < cats_count; ++i) {
@@ -226,20 +228,20 @@ TEST(CategoricalType, ValuesLonger)
   // Check that everything in 'a' is right
   for (int i = 0; i < a_count; ++i) {
     EXPECT_EQ(a_vals[i], a(i).as<std::string>());
-    EXPECT_EQ(a_uints[i], a_view(i).as<uint32_t>());
+    EXPECT_EQ(a_uints[i], a_view[i]);
   }
 }
 
 TEST(CategoricalType, AssignFixedString)
 {
   const char *cat_vals[] = {"foo", "bar", "baz"};
-  nd::array cat = nd::empty(3, ndt::fixed_string_type::make(3, string_encoding_ascii));
+  nd::array cat = nd::empty(3, ndt::make_type<ndt::fixed_string_type>(3, string_encoding_ascii));
   cat.vals() = cat_vals;
 
-  ndt::type dt = ndt::categorical_type::make(cat);
+  ndt::type dt = ndt::make_type<ndt::categorical_type>(cat);
 
   nd::array a = nd::empty(3, dt);
-  a.val_assign(cat);
+  a.assign(cat);
   EXPECT_EQ("foo", a(0).as<std::string>());
   EXPECT_EQ("bar", a(1).as<std::string>());
   EXPECT_EQ("baz", a(2).as<std::string>());
@@ -250,7 +252,7 @@ TEST(CategoricalType, AssignFixedString)
   EXPECT_THROW(a(0).vals() = cat(0), std::runtime_error);
 
   nd::array tmp = nd::empty(3, cat.get_type().at(0));
-  tmp.val_assign(a);
+  tmp.assign(a);
   EXPECT_EQ("baz", tmp(0).as<std::string>());
   EXPECT_EQ("bar", tmp(1).as<std::string>());
   EXPECT_EQ("baz", tmp(2).as<std::string>());
@@ -265,10 +267,10 @@ TEST(CategoricalType, AssignInt)
   int32_t cat_vals[] = {10, 100, 1000};
   nd::array cat = cat_vals;
 
-  ndt::type dt = ndt::categorical_type::make(cat);
+  ndt::type dt = ndt::make_type<ndt::categorical_type>(cat);
 
   nd::array a = nd::empty(3, dt);
-  a.val_assign(cat);
+  a.assign(cat);
   EXPECT_EQ(10, a(0).as<int32_t>());
   EXPECT_EQ(100, a(1).as<int32_t>());
   EXPECT_EQ(1000, a(2).as<int32_t>());
@@ -280,7 +282,7 @@ TEST(CategoricalType, AssignInt)
   // cout << a << endl;
 
   nd::array tmp = nd::empty(3, cat.get_type().at(0));
-  tmp.val_assign(a);
+  tmp.assign(a);
   EXPECT_EQ(1000, tmp(0).as<int32_t>());
   EXPECT_EQ(100, tmp(1).as<int32_t>());
   EXPECT_EQ(1000, tmp(2).as<int32_t>());
@@ -291,18 +293,18 @@ TEST(CategoricalType, AssignInt)
 TEST(CategoricalType, AssignRange)
 {
   const char *cat_vals[] = {"foo", "bar", "baz"};
-  nd::array cat = nd::empty(3, ndt::fixed_string_type::make(3, string_encoding_ascii));
+  nd::array cat = nd::empty(3, ndt::make_type<ndt::fixed_string_type>(3, string_encoding_ascii));
   cat.vals() = cat_vals;
 
-  ndt::type dt = ndt::categorical_type::make(cat);
+  ndt::type dt = ndt::make_type<ndt::categorical_type>(cat);
 
   nd::array a = nd::empty(9, dt);
   nd::array b = a(0 <= irange() < 3);
-  b.val_assign(cat);
+  b.assign(cat);
   nd::array c = a(3 <= irange() < 6);
-  c.val_assign(cat(0));
+  c.assign(cat(0));
   nd::array d = a(6 <= irange().by(2) < 9);
-  d.val_assign(cat(1));
+  d.assign(cat(1));
   a(7).vals() = cat(2);
 
   EXPECT_EQ("foo", a(0).as<std::string>());
@@ -320,20 +322,19 @@ TEST(CategoricalType, CategoriesProperty)
 {
   const char *cats_vals[] = {"this", "is", "a", "test"};
   nd::array cats = cats_vals;
-  ndt::type cd = ndt::categorical_type::make(cats_vals);
+  ndt::type cd = ndt::make_type<ndt::categorical_type>(cats_vals);
   std::cout << cats << std::endl;
-  std::cout << cd.p("categories") << std::endl;
-  EXPECT_TRUE(cats.equals_exact(cd.p("categories")));
+  std::cout << cd.extended<ndt::categorical_type>()->get_categories() << std::endl;
+  EXPECT_TRUE(cats.equals_exact(cd.extended<ndt::categorical_type>()->get_categories()));
 }
 
 TEST(CategoricalType, AssignFromOther)
 {
   int cats_values[] = {3, 6, 100, 1000};
-  ndt::type cd = ndt::categorical_type::make(cats_values);
+  ndt::type cd = ndt::make_type<ndt::categorical_type>(cats_values);
   int16_t a_values[] = {6, 3, 100, 3, 1000, 100, 6, 1000};
-  nd::array a = nd::array(a_values).ucast(cd);
-  EXPECT_EQ(ndt::make_fixed_dim(8, ndt::convert_type::make(cd, ndt::make_type<int16_t>())), a.get_type());
-  a = a.eval();
+  nd::array a = nd::empty(8, cd);
+  a.assign(a_values);
   EXPECT_EQ(ndt::make_fixed_dim(8, cd), a.get_type());
   EXPECT_EQ(6, a(0).as<int>());
   EXPECT_EQ(3, a(1).as<int>());
@@ -352,4 +353,66 @@ TEST(CategoricalType, AssignFromOther)
   a(5).vals() = (uint16_t)3;
   EXPECT_EQ(3, a(5).as<int>());
 }
-*/
+
+TEST(CategoricalType, UniqueHashed)
+{
+  EXPECT_THROW(ndt::make_type<ndt::categorical_type>(nd::array{0.0, -0.0}), std::runtime_error);
+
+  // Long strings are hashed from the heap rather than inline
+  EXPECT_THROW(ndt::make_type<ndt::categorical_type>(
+                   nd::array{"abcdefghijklmnopqrstuvwxyz", "z", "abcdefghijklmnopqrstuvwxyz"}),
+               std::runtime_error);
+}
+
+TEST(CategoricalType, ValuesHashedFloat)
+{
+  ndt::type dt = ndt::make_type<ndt::categorical_type>(nd::array{2.5, -1.0, 0.0});
+  const ndt::categorical_type *cd = dt.extended<ndt::categorical_type>();
+  EXPECT_EQ(1u, cd->get_value_from_category(-1.0));
+  EXPECT_EQ(2u, cd->get_value_from_category(-0.0));
+  EXPECT_THROW(cd->get_value_from_category(1.0), std::runtime_error);
+}
+
+TEST(CategoricalType, AssignHashed)
+{
+  ndt::type dt = ndt::make_type<ndt::categorical_type>(nd::array{"foo", "abcdefghijklmnopqrstuvwxyz", "z", "bar"});
+
+  nd::array a = nd::empty(6, dt);
+  a.assign(nd::array{"z", "foo", "abcdefghijklmnopqrstuvwxyz", "bar", "z", "foo"});
+  const uint8_t expected[] = {2, 0, 1, 3, 2, 0};
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_EQ(expected[i], reinterpret_cast<const uint8_t *>(a.cdata())[i]);
+  }
+
+  nd::array b = nd::empty(dt);
+  b.assign("bar");
+  EXPECT_EQ(3u, *reinterpret_cast<const uint8_t *>(b.cdata()));
+  EXPECT_THROW(b.assign("baz"), std::runtime_error);
+
+  // Values of another string type are converted to the category type first
+  nd::array c = nd::empty(ndt::make_type<ndt::fixed_string_type>(3, string_encoding_utf_8));
+  c.assign("foo");
+  b.assign(c);
+  EXPECT_EQ(0u, *reinterpret_cast<const uint8_t *>(b.cdata()));
+}
+
+TEST(CategoricalType, AssignHashedBulk)
+{
+  ndt::type dt = ndt::make_type<ndt::categorical_type>(nd::range(1000));
+  EXPECT_EQ(ndt::make_type<uint16_t>(), dt.p<ndt::type>("storage_type"));
+
+  nd::array values = nd::empty(2000, ndt::make_type<int32_t>());
+  for (int32_t i = 0; i < 2000; ++i) {
+    reinterpret_cast<int32_t *>(values.data())[i] = (i * 7) % 1000;
+  }
+
+  // A strided run is encoded in a single call
+  nd::array a = nd::empty(2000, dt);
+  a.assign(values);
+  for (int32_t i = 0; i < 2000; ++i) {
+    EXPECT_EQ((i * 7) % 1000, reinterpret_cast<const uint16_t *>(a.cdata())[i]);
+  }
+
+  reinterpret_cast<int32_t *>(values.data())[1234] = 1000;
+  EXPECT_THROW(a.assign(values), std::runtime_error);
+}
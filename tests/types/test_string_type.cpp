@@ -429,6 +429,18 @@ TEST(StringType, RFind1) {
   EXPECT_ARRAY_EQ(c, nd::string_rfind(a, b));
 }
 
+TEST(StringType, RFind2) {
+  /* This tests the "fast path" where the needle is a single
+     character */
+  nd::array a, b;
+
+  a = {"a", "baab", "0123456789bb", "0123456789aaa", ""};
+  b = "a";
+  intptr_t c[] = {0, 2, -1, 12, -1};
+
+  EXPECT_ARRAY_EQ(c, nd::string_rfind(a, b));
+}
+
 TEST(StringType, Count1) {
   nd::array a, b;
 
@@ -461,6 +473,23 @@ TEST(StringType, Count3) {
   EXPECT_ARRAY_EQ(c, nd::string_count(a, b));
 }
 
+TEST(StringType, Count4) {
+  /* This tests haystacks long enough to be searched a block at a
+     time, with matches that overlap and cross the blocks */
+  nd::array a, b;
+
+  a = {"abbbbabaabababbabbabb", "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxbabab",
+       "babababababababababababababababababababababababababababababababababababababababababababab",
+       "bxbxxbabxxxxxxxxxxxxxxxxxxxxxxbabxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxbab"};
+  b = "bab";
+  intptr_t c[] = {4, 1, 22, 3};
+
+  EXPECT_ARRAY_EQ(c, nd::string_count(a, b));
+
+  intptr_t d[] = {4, 78, 0, 5};
+  EXPECT_ARRAY_EQ(d, nd::string_find(a, b));
+}
+
 TEST(StringType, Replace) {
   nd::array a, b, c, d;
 
@@ -546,6 +575,26 @@ TEST(StringType, Contains) {
   EXPECT_ARRAY_EQ(c, nd::string_contains(a, b));
 }
 
+TEST(StringType, ContainsAny) {
+  nd::array a, b, c;
+
+  a = {"GET /index.html 200", "POST /login 403", "", "GET /favicon.ico 404", "error: disk full", "erro"};
+  b = {"403", "404", "error", "", "timeout"};
+  c = {false, true, false, true, true, false};
+
+  EXPECT_ARRAY_EQ(c, nd::string_contains_any(a, b));
+
+  // Needles which are suffixes of each other, and no needles at all
+  a = {"abcd", "xbcd", "xxcd", "xxxd"};
+  b = {"abcd", "bcd", "cd"};
+  c = {true, true, true, false};
+  EXPECT_ARRAY_EQ(c, nd::string_contains_any(a, b));
+  EXPECT_ARRAY_EQ(c, nd::string_contains_any(nd::string_pack(a), b));
+
+  c = {false, false, false, false};
+  EXPECT_ARRAY_EQ(c, nd::string_contains_any(a, nd::empty(0, ndt::make_type<dynd::string>())));
+}
+
 template <class T>
 static bool ascii_T_compare(const char *x, const T *y, intptr_t count) {
   for (intptr_t i = 0; i < count; ++i) {
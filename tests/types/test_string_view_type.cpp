@@ -0,0 +1,187 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+
+#include "dynd_assertions.hpp"
+#include "inc_gtest.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/comparison.hpp>
+#include <dynd/json_parser.hpp>
+#include <dynd/string.hpp>
+#include <dynd/types/string_view_type.hpp>
+#include <dynd/types/var_dim_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+// Whether every byte of the view lies within the data of the array
+bool points_into(const string_view &v, const nd::array &a, intptr_t size) {
+  return v.begin() >= a.cdata() && v.end() <= a.cdata() + size;
+}
+
+} // anonymous namespace
+
+TEST(StringViewType, Create) {
+  ndt::type d = ndt::make_type<string_view>();
+  EXPECT_EQ(string_view_id, d.get_id());
+  EXPECT_EQ(string_kind_id, d.get_base_id());
+  EXPECT_EQ(sizeof(string_view), d.get_data_size());
+  EXPECT_EQ(sizeof(string_view_type_arrmeta), d.get_arrmeta_size());
+  EXPECT_TRUE(d.get_flags() & type_flag_blockref);
+  EXPECT_EQ(d, ndt::type("string_view"));
+  EXPECT_EQ("string_view", d.str());
+  EXPECT_NE(d, ndt::make_type<dynd::string>());
+}
+
+TEST(StringViewType, Assign) {
+  nd::array a = nd::empty(2, ndt::make_type<string_view>());
+  a.assign(nd::array{"hello", "a string longer than the inline buffer"});
+  EXPECT_EQ("hello", a(0).as<std::string>());
+  EXPECT_EQ("a string longer than the inline buffer", a(1).as<std::string>());
+
+  nd::array b = nd::empty(2, ndt::make_type<dynd::string>());
+  b.assign(a);
+  EXPECT_ARRAY_EQ((nd::array{"hello", "a string longer than the inline buffer"}), b);
+}
+
+TEST(StringViewType, JSON) {
+  nd::array a = parse_json("3 * string_view", "[\"x\", \"yy\", \"\"]");
+  EXPECT_EQ(ndt::type("3 * string_view"), a.get_type());
+  EXPECT_EQ("x", a(0).as<std::string>());
+  EXPECT_EQ("yy", a(1).as<std::string>());
+  EXPECT_EQ("", a(2).as<std::string>());
+}
+
+TEST(StringViewType, SplitView) {
+  nd::array a = nd::array{"a,b", "a string longer than the inline buffer,x", ""}.eval_copy(nd::read_access_flag);
+  nd::array res = nd::string_split_view(a, ",");
+  EXPECT_EQ(ndt::type("3 * var * string_view"), res.get_type());
+
+  EXPECT_EQ(2, res(0).get_dim_size());
+  EXPECT_EQ("a", res(0, 0).as<std::string>());
+  EXPECT_EQ("b", res(0, 1).as<std::string>());
+  EXPECT_EQ(2, res(1).get_dim_size());
+  EXPECT_EQ("a string longer than the inline buffer", res(1, 0).as<std::string>());
+  EXPECT_EQ("x", res(1, 1).as<std::string>());
+  EXPECT_EQ(1, res(2).get_dim_size());
+  EXPECT_EQ("", res(2, 0).as<std::string>());
+
+  // The short pieces point into the inline data of the source strings
+  EXPECT_TRUE(points_into(*reinterpret_cast<const string_view *>(res(0, 1).cdata()), a, 3 * sizeof(dynd::string)));
+
+  // The result keeps the source data alive
+  a = nd::array();
+  EXPECT_EQ("b", res(0, 1).as<std::string>());
+  EXPECT_EQ("a string longer than the inline buffer", res(1, 0).as<std::string>());
+}
+
+TEST(StringViewType, SplitViewMutable) {
+  nd::array a{"a,b", "a string longer than the inline buffer,x"};
+  nd::array res = nd::string_split_view(a, ",");
+
+  // The strings of a mutable source can be reassigned, so the pieces are copies
+  a(0).assign("short");
+  a(1).assign("another string longer than the inline buffer");
+  EXPECT_EQ("a", res(0, 0).as<std::string>());
+  EXPECT_EQ("b", res(0, 1).as<std::string>());
+  EXPECT_EQ("a string longer than the inline buffer", res(1, 0).as<std::string>());
+  EXPECT_EQ("x", res(1, 1).as<std::string>());
+}
+
+TEST(StringViewType, Slice) {
+  nd::array a = nd::array{"hello", "a string longer than the inline buffer", "", "x"}.eval_copy(nd::read_access_flag);
+  nd::array res = nd::string_slice(a, 1, -1);
+  EXPECT_EQ(ndt::type("4 * string_view"), res.get_type());
+  EXPECT_EQ("ell", res(0).as<std::string>());
+  EXPECT_EQ(" string longer than the inline buffe", res(1).as<std::string>());
+  EXPECT_EQ("", res(2).as<std::string>());
+  EXPECT_EQ("", res(3).as<std::string>());
+
+  res = nd::string_slice(a, -3, 100);
+  EXPECT_EQ("llo", res(0).as<std::string>());
+  EXPECT_EQ("fer", res(1).as<std::string>());
+  EXPECT_EQ("", res(2).as<std::string>());
+  EXPECT_EQ("x", res(3).as<std::string>());
+
+  EXPECT_TRUE(points_into(*reinterpret_cast<const string_view *>(res(0).cdata()), a, 4 * sizeof(dynd::string)));
+}
+
+TEST(StringViewType, SliceMutable) {
+  nd::array a{"hello", "a string longer than the inline buffer"};
+  nd::array res = nd::string_slice(a, 1, -1);
+
+  // The strings of a mutable source can be reassigned, so the slices are copies
+  a(0).assign("short");
+  a(1).assign("another string longer than the inline buffer");
+  EXPECT_EQ("ell", res(0).as<std::string>());
+  EXPECT_EQ(" string longer than the inline buffe", res(1).as<std::string>());
+}
+
+TEST(StringViewType, Pack) {
+  nd::array a{"abcabc", "a string longer than the inline buffer", "", "xbc"};
+  nd::array res = nd::string_pack(a);
+  EXPECT_EQ(ndt::type("4 * string_view"), res.get_type());
+
+  // The bytes of the strings are laid out one after another
+  const string_view *views = reinterpret_cast<const string_view *>(res.cdata());
+  for (int i = 1; i < 4; ++i) {
+    EXPECT_EQ(views[i - 1].end(), views[i].begin());
+  }
+
+  nd::array b = nd::empty(4, ndt::make_type<dynd::string>());
+  b.assign(res);
+  EXPECT_ARRAY_EQ(a, b);
+
+  // Views into another array are packed into a buffer of their own
+  res = nd::string_pack(nd::string_slice(a, 1, 3));
+  EXPECT_EQ("bc", res(0).as<std::string>());
+  EXPECT_EQ(" s", res(1).as<std::string>());
+  EXPECT_EQ("", res(2).as<std::string>());
+  EXPECT_EQ("bc", res(3).as<std::string>());
+}
+
+TEST(StringViewType, StringFunctions) {
+  nd::array a = nd::string_pack(nd::array{"abcabc", "a string longer than the inline buffer", "", "xbc"});
+
+  intptr_t find[] = {1, -1, -1, 1};
+  EXPECT_ARRAY_EQ(find, nd::string_find(a, "bc"));
+  intptr_t count[] = {2, 0, 0, 1};
+  EXPECT_ARRAY_EQ(count, nd::string_count(a, "bc"));
+  EXPECT_ARRAY_EQ((nd::array{true, true, false, false}), nd::string_startswith(a, "a"));
+  EXPECT_ARRAY_EQ((nd::array{true, false, false, true}), nd::string_endswith(a, "bc"));
+  EXPECT_ARRAY_EQ((nd::array{false, true, false, false}), nd::string_contains(a, "long"));
+  intptr_t mixed_find[] = {1, 9, -1, 0};
+  EXPECT_ARRAY_EQ(mixed_find, nd::string_find(nd::array{"abcabc", "a string longer than the inline buffer", "", "xbc"},
+                                              nd::string_pack(nd::array{"bc", "long", "", "x"})));
+  intptr_t rfind[] = {4, -1, -1, 1};
+  EXPECT_ARRAY_EQ(rfind, nd::string_rfind(a, "bc"));
+  EXPECT_ARRAY_EQ((nd::array{"aXYaXY", "a string longer than the inline buffer", "", "xXY"}),
+                  nd::string_replace(a, "bc", "XY"));
+  EXPECT_ARRAY_EQ((nd::array{"a-a-", "a string longer than the inline buffer", "", "x-"}),
+                  nd::string_replace(a, nd::string_pack(nd::array{"bc", "bc", "bc", "bc"}), "-"));
+
+  nd::array pieces = nd::string_split(a, "bc");
+  EXPECT_EQ(ndt::type("4 * var * string"), pieces.get_type());
+  EXPECT_EQ(3, pieces(0).get_shape()[0]);
+  EXPECT_EQ("a", pieces(0, 0).as<std::string>());
+  EXPECT_EQ("", pieces(0, 2).as<std::string>());
+  EXPECT_EQ("a string longer than the inline buffer", pieces(1, 0).as<std::string>());
+  EXPECT_EQ("x", pieces(3, 0).as<std::string>());
+
+  nd::array res = nd::string_concatenation(a, "!");
+  EXPECT_EQ(ndt::type("4 * string_view"), res.get_type());
+  EXPECT_EQ("abcabc!", res(0).as<std::string>());
+  EXPECT_EQ("a string longer than the inline buffer!", res(1).as<std::string>());
+  EXPECT_EQ("!", res(2).as<std::string>());
+  EXPECT_EQ("xbc!", res(3).as<std::string>());
+
+  EXPECT_EQ(0, nd::total_order(a(0), a(1)).as<int>());
+  EXPECT_EQ(1, nd::total_order(a(1), a(0)).as<int>());
+}